@@ -45,13 +45,21 @@
 	#include <arch/cluster/linux64-cluster/memory.h>
 	#include <arch/cluster/linux64-cluster/timer.h>
 	#include <arch/cluster/linux64-cluster/cores.h>
+	#include <arch/cluster/linux64-cluster/event.h>
+	#include <arch/cluster/linux64-cluster/ipi.h>
+	#include <arch/cluster/linux64-cluster/topology.h>
 
 #ifdef __NANVIX_HAL
 
 	/**
 	 * @brief Powers on the underlying cluster.
+	 *
+	 * @param ncores Number of cores to power on.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
 	 */
-	EXTERN int linux64_cluster_boot(void);
+	EXTERN int linux64_cluster_boot(int ncores);
 
 	/**
 	 * @brief Initializes the the underlying cluster.
@@ -77,9 +85,9 @@
 	#define CLUSTER_IS_MULTICORE  1 /**< Multicore Cluster */
 	#define CLUSTER_IS_IO         1 /**< I/O Cluster       */
 	#define CLUSTER_IS_COMPUTE    0 /**< Compute Cluster   */
-	#define CLUSTER_HAS_EVENTS    0 /**< Event Support?    */
+	#define CLUSTER_HAS_EVENTS    1 /**< Event Support?    */
 	#define CLUSTER_HAS_RTC       1 /**< RTC Support?      */
-	#define CLUSTER_HAS_IPI       0 /**< IPI Support?      */
+	#define CLUSTER_HAS_IPI       1 /**< IPI Support?      */
 	/**@}*/
 
 /**@endcond*/
@@ -37,11 +37,17 @@
 /**@{*/
 
 	#include <nanvix/const.h>
+	#include <pthread.h>
 
 	/**
-	 * @brief Number of cores in the cluster.
+	 * @brief Maximum number of cores in the cluster.
 	 */
-    #define LINUX64_CLUSTER_NUM_CORES 5
+	#define LINUX64_CLUSTER_NUM_CORES_MAX 128
+
+	/**
+	 * @brief Default number of cores in the cluster.
+	 */
+	#define LINUX64_CLUSTER_NUM_CORES 5
 
 	/**
 	 * @brief ID of the master core.
@@ -51,12 +57,12 @@
 	/**
 	 * @brief Array of the cores.
 	 */
-	EXTERN pthread_t linux64_cores_tab[LINUX64_CLUSTER_NUM_CORES];
+	EXTERN pthread_t linux64_cores_tab[LINUX64_CLUSTER_NUM_CORES_MAX];
 
 	/**
-	 * @brief Lock for the array of the cores.
+	 * @brief Number of cores powered on in the cluster.
 	 */
-	EXTERN linux64_spinlock_t linux64_cores_lock;
+	EXTERN int linux64_cluster_ncores;
 
 	/**
 	 * @brief Powers off the underlying core.
@@ -69,7 +75,10 @@
 	 * @returns The ID of the underlying core or -1 if the thread
 	 * calling thread is not attached to the underlying cluster.
 	 */
-	EXTERN int linux64_core_get_id(void);
+	static inline int linux64_core_get_id(void)
+	{
+		return (linux64_core_context.coreid);
+	}
 
 	/**
 	 * @brief Resets the underlying core.
@@ -80,13 +89,14 @@
 	 * @brief Gets the number of cores.
 	 *
 	 * The linux64_cluster_get_num_cores() gets the number of cores in the
-	 * underlying linux64 processor.
+	 * underlying linux64 processor. This number is chosen at boot time
+	 * and never exceeds @p LINUX64_CLUSTER_NUM_CORES_MAX.
 	 *
 	 * @returns The the number of cores in the underlying processor.
 	 */
 	static inline int linux64_cluster_get_num_cores(void)
 	{
-		return (LINUX64_CLUSTER_NUM_CORES);
+		return (linux64_cluster_ncores);
 	}
 
 /**@}*/
@@ -112,7 +122,12 @@
 	/**
 	 * @brief Number of cores in a cluster.
 	 */
-	#define CORES_NUM LINUX64_CLUSTER_NUM_CORES
+	#define CORES_NUM (linux64_cluster_get_num_cores())
+
+	/**
+	 * @brief Maximum number of cores in a cluster.
+	 */
+	#define CORES_NUM_MAX LINUX64_CLUSTER_NUM_CORES_MAX
 
 	/**
 	 * @brief ID of the master core.
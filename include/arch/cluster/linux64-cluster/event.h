@@ -0,0 +1,105 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ARCH_CLUSTER_LINUX64_CLUSTER_EVENT_H_
+#define ARCH_CLUSTER_LINUX64_CLUSTER_EVENT_H_
+
+	/* Cluster Interface Implementation */
+	#include <arch/cluster/linux64-cluster/_linux64-cluster.h>
+
+/**
+ * @addtogroup linux64-cluster-event Events
+ * @ingroup linux64-cluster
+ *
+ * @brief Events Interface
+ */
+/**@{*/
+
+	#include <nanvix/const.h>
+
+	/**
+	 * @brief Notifies a local core about an event.
+	 *
+	 * @param coreid ID of target core.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int linux64_cluster_event_notify(int coreid);
+
+	/**
+	 * @brief Waits for an event.
+	 *
+	 * The calling core sleeps in the host kernel until it is
+	 * notified. A notification that arrives before the wait is
+	 * not lost.
+	 */
+	EXTERN void linux64_cluster_event_wait(void);
+
+/**@}*/
+
+/*============================================================================*
+ * Exported Interface                                                         *
+ *============================================================================*/
+
+/**
+ * @cond linux64_cluster
+ */
+
+	/**
+	 * @name Exported Functions
+	 */
+	/**@{*/
+	#define __event_notify_fn /**< event_notify() */
+	#define __event_wait_fn   /**< event_wait()   */
+	#define __event_reset_fn  /**< event_reset()  */
+	/**@}*/
+
+	/**
+	 * @see linux64_cluster_event_notify()
+	 */
+	static inline int __event_notify(int coreid)
+	{
+		return (linux64_cluster_event_notify(coreid));
+	}
+
+	/**
+	 * @see linux64_cluster_event_wait().
+	 */
+	static inline void __event_wait(void)
+	{
+		linux64_cluster_event_wait();
+	}
+
+	/**
+	 * @brief Dummy function
+	 */
+	static inline void __event_reset(void)
+	{
+		/* noop. */
+	}
+
+/**@endcond*/
+
+#endif /* ARCH_CLUSTER_LINUX64_CLUSTER_EVENT_H_ */
@@ -0,0 +1,108 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ARCH_CLUSTER_LINUX64_CLUSTER_IPI_H_
+#define ARCH_CLUSTER_LINUX64_CLUSTER_IPI_H_
+
+	/* Cluster Interface Implementation */
+	#include <arch/cluster/linux64-cluster/_linux64-cluster.h>
+
+/**
+ * @addtogroup linux64-cluster-ipi IPI
+ * @ingroup linux64-cluster
+ *
+ * @brief IPI Interface
+ */
+/**@{*/
+
+	#include <nanvix/const.h>
+
+	/**
+	 * @brief Initializes IPIs in the underlying core.
+	 */
+	EXTERN void linux64_cluster_ipi_setup(void);
+
+	/**
+	 * @brief Sends an interrupt to another core.
+	 *
+	 * @param coreid ID of target core.
+	 */
+	EXTERN void linux64_cluster_ipi_send(int coreid);
+
+	/**
+	 * @brief Complete the interrupt that came from another core.
+	 */
+	EXTERN void linux64_cluster_ipi_ack(void);
+
+	/**
+	 * @brief Waits for an IPI interrupt.
+	 */
+	EXTERN void linux64_cluster_ipi_wait(void);
+
+/**@}*/
+
+/*============================================================================*
+ * Exported Interface                                                         *
+ *============================================================================*/
+
+/**
+ * @cond linux64_cluster
+ */
+
+	/**
+	 * @name Exported Functions
+	 */
+	/**@{*/
+	#define __cluster_ipi_send_fn /**< cluster_ipi_send() */
+	#define __cluster_ipi_ack_fn  /**< cluster_ipi_ack()  */
+	#define __cluster_ipi_wait_fn /**< cluster_ipi_wait() */
+	/**@}*/
+
+	/**
+	 * @see linux64_cluster_ipi_send().
+	 */
+	static inline void cluster_ipi_send(int coreid)
+	{
+		linux64_cluster_ipi_send(coreid);
+	}
+
+	/**
+	 * @see linux64_cluster_ipi_ack().
+	 */
+	static inline void cluster_ipi_ack(void)
+	{
+		linux64_cluster_ipi_ack();
+	}
+
+	/**
+	 * @see linux64_cluster_ipi_wait().
+	 */
+	static inline void cluster_ipi_wait(void)
+	{
+		linux64_cluster_ipi_wait();
+	}
+
+/**@endcond*/
+
+#endif /* ARCH_CLUSTER_LINUX64_CLUSTER_IPI_H_ */
@@ -42,19 +42,52 @@
 	#define LINUX64_MEM_SIZE (32*1024*1024)
 
 	/**
-	 * @brief Kernel memory size (in bytes).
+	 * @name Default Memory Sizes (in bytes)
 	 */
-	#define LINUX64_KMEM_SIZE (4*1024*1024)
+	/**@{*/
+	#define LINUX64_KMEM_SIZE_DEFAULT  (4*1024*1024)   /**< Kernel Memory    */
+	#define LINUX64_KPOOL_SIZE_DEFAULT (4*1024*1024)   /**< Kernel Page Pool */
+	#define LINUX64_UMEM_SIZE_DEFAULT  (128*1024*1024) /**< User Memory      */
+	/**@}*/
+
+	/**
+	 * @name Maximum Memory Sizes (in bytes)
+	 */
+	/**@{*/
+	#define LINUX64_KMEM_SIZE  LINUX64_PGTAB_SIZE     /**< Kernel Memory    */
+	#define LINUX64_KPOOL_SIZE LINUX64_PGTAB_SIZE     /**< Kernel Page Pool */
+	#define LINUX64_UMEM_SIZE  (1024*1024*1024UL)     /**< User Memory      */
+	/**@}*/
+
+	/**
+	 * @brief Maximum number of page frames.
+	 */
+	#define LINUX64_CLUSTER_FRAMES_MAX (LINUX64_UMEM_SIZE/LINUX64_PAGE_SIZE)
 
 	/**
-	 * @brief Kernel page pool size (in bytes).
+	 * @name Memory Sizes (in bytes)
+	 *
+	 * These are set at boot, see linux64_cluster_memory_configure().
 	 */
-	#define LINUX64_KPOOL_SIZE (4*1024*1024)
+	/**@{*/
+	EXTERN size_t linux64_kmem_size;  /**< Kernel Memory    */
+	EXTERN size_t linux64_kpool_size; /**< Kernel Page Pool */
+	EXTERN size_t linux64_umem_size;  /**< User Memory      */
+	/**@}*/
+
+	/**
+	 * @brief Size of host huge pages (in bytes).
+	 */
+	#define LINUX64_CLUSTER_HUGEPAGE_SIZE (2*1024*1024)
 
 	/**
-	 * @brief User memory size (in bytes).
+	 * @name Huge Page Backing
 	 */
-	#define LINUX64_UMEM_SIZE (128*1024*1024)
+	/**@{*/
+	#define LINUX64_CLUSTER_HUGEPAGES_NONE        0 /**< Small pages only.        */
+	#define LINUX64_CLUSTER_HUGEPAGES_TRANSPARENT 1 /**< Transparent huge pages. */
+	#define LINUX64_CLUSTER_HUGEPAGES_EXPLICIT    2 /**< Explicit huge pages.    */
+	/**@}*/
 
 	/**
 	 * @brief Kernel stack size (in bytes).
@@ -93,11 +126,100 @@
 	#define LINUX64_CLUSTER_MREGION_PG_ALIGN_END   LINUX64_CLUSTER_MEM_REGIONS  /**< MRegion end page aligned.         */
 	/**@}*/
 
+	/**
+	 * @name MMU Modes
+	 */
+	/**@{*/
+	#define LINUX64_CLUSTER_MMU_COSMETIC 0 /**< Page tables are not enforced. */
+	#define LINUX64_CLUSTER_MMU_EMULATED 1 /**< Page tables are enforced.     */
+	/**@}*/
+
+	/**
+	 * @name TLB Replacement Policies
+	 */
+	/**@{*/
+	#define LINUX64_CLUSTER_TLB_FIFO   0 /**< First In, First Out */
+	#define LINUX64_CLUSTER_TLB_RANDOM 1 /**< Random              */
+	/**@}*/
+
+	/**
+	 * @name TLB Length
+	 */
+	/**@{*/
+	#define LINUX64_CLUSTER_TLB_LENGTH     64   /**< Default TLB length. */
+	#define LINUX64_CLUSTER_TLB_LENGTH_MAX 1024 /**< Maximum TLB length. */
+	/**@}*/
+
+	/**
+	 * @name Memory Images
+	 */
+	/**@{*/
+	#define LINUX64_CLUSTER_IMAGE_KMEM      0   /**< Kernel Memory                 */
+	#define LINUX64_CLUSTER_IMAGE_KPOOL     1   /**< Kernel Page Pool              */
+	#define LINUX64_CLUSTER_IMAGE_UMEM      2   /**< User Memory                   */
+	#define LINUX64_CLUSTER_IMAGES_NUM      3   /**< Number of Memory Images       */
+	#define LINUX64_CLUSTER_IMAGES_PATH_MAX 256 /**< Length of Directory of Images */
+	/**@}*/
+
+	/**
+	 * @brief Number of memory regions backed by the emulated MMU.
+	 */
+	#define LINUX64_CLUSTER_MMU_REGIONS 4
+
+	/**
+	 * @brief Number of entries in the reverse map of the MMU.
+	 */
+	#define LINUX64_CLUSTER_MMU_RMAP_LENGTH 8192
+
+	/**
+	 * @brief TLB statistics of a core.
+	 */
+	struct linux64_cluster_tlb_stats
+	{
+		unsigned misses;            /**< TLB misses.                  */
+		unsigned evictions;         /**< Evicted TLB entries.         */
+		unsigned flushes;           /**< TLB flushes.                 */
+		unsigned page_faults;       /**< Accesses to unmapped pages.  */
+		unsigned protection_faults; /**< Accesses without permission. */
+	};
+
 	/**
 	 * @brief Flushes the TLB.
 	 */
 	EXTERN int linux64_cluster_tlb_flush(void);
 
+	/**
+	 * @brief Gets the TLB statistics of a core.
+	 *
+	 * @param coreid Target core.
+	 * @param stats  Location to store the statistics.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int linux64_cluster_tlb_stats_get(int coreid, struct linux64_cluster_tlb_stats *stats);
+
+	/**
+	 * @brief Gets the configuration of the MMU of the cluster.
+	 *
+	 * @param mode       Store location for the MMU mode.
+	 * @param tlb_length Store location for the number of entries in
+	 *                   the TLB.
+	 * @param tlb_policy Store location for the TLB replacement policy.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int linux64_cluster_mmu_get(int *mode, int *tlb_length, int *tlb_policy);
+
+	/**
+	 * @brief Saves the memory images of the cluster.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int linux64_cluster_memory_snapshot(void);
+
 	/**
 	 * @brief Binary Sections
 	 */
@@ -114,6 +236,62 @@
 
 #ifdef __NANVIX_HAL
 
+	/**
+	 * @brief Configures the MMU of the cluster.
+	 *
+	 * @param mode       MMU mode.
+	 * @param tlb_length Number of entries in the TLB.
+	 * @param tlb_policy TLB replacement policy.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 *
+	 * @note This function should be called before the cluster is
+	 * powered on.
+	 */
+	EXTERN int linux64_cluster_mmu_configure(int mode, int tlb_length, int tlb_policy);
+
+	/**
+	 * @brief Configures the memory of the cluster.
+	 *
+	 * @param kmem      Kernel memory size (in bytes).
+	 * @param kpool     Kernel page pool size (in bytes).
+	 * @param umem      User memory size (in bytes).
+	 * @param hugepages Huge page backing.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 *
+	 * @note This function should be called before the cluster is
+	 * powered on.
+	 */
+	EXTERN int linux64_cluster_memory_configure(
+		size_t kmem,
+		size_t kpool,
+		size_t umem,
+		int hugepages
+	);
+
+	/**
+	 * @brief Backs the memory of the cluster with files.
+	 *
+	 * @param dir Directory of memory images.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 *
+	 * @note This function should be called before the cluster is
+	 * powered on.
+	 */
+	EXTERN int linux64_cluster_memory_persist(const char *dir);
+
+	/**
+	 * @brief Selects the memory images of the cluster.
+	 *
+	 * @param clusternum Logical number of the underlying cluster.
+	 */
+	EXTERN void linux64_cluster_memory_image_select(int clusternum);
+
 	/**
 	 * @brief Powers of the virtual memory.
 	 */
@@ -149,6 +327,15 @@
 	#define KPOOL_VIRT     LINUX64_KPOOL_BASE_VIRT  /**< @see LINUX64_KPOOL_BASE_VIRT  */
 	/**@}*/
 
+	/**
+	 * @name Exported Memory Sizes
+	 */
+	/**@{*/
+	#define kmem_size  linux64_kmem_size  /**< @see linux64_kmem_size  */
+	#define kpool_size linux64_kpool_size /**< @see linux64_kpool_size */
+	#define umem_size  linux64_umem_size  /**< @see linux64_umem_size  */
+	/**@}*/
+
 	/**
 	 * @name Exported Memory Region Constants
 	 */
@@ -159,14 +346,17 @@
 	#define MREGION_PT_ALIGN_END   LINUX64_CLUSTER_MREGION_PT_ALIGN_END   /**< @see LINUX64_CLUSTER_MREGION_PT_ALIGN_END   */
 	#define MREGION_PG_ALIGN_START LINUX64_CLUSTER_MREGION_PG_ALIGN_START /**< @see LINUX64_CLUSTER_MREGION_PG_ALIGN_START */
 	#define MREGION_PG_ALIGN_END   LINUX64_CLUSTER_MREGION_PG_ALIGN_END   /**< @see LINUX64_CLUSTER_MREGION_PG_ALIGN_END   */
+	#define MEM_FRAMES_MAX         LINUX64_CLUSTER_FRAMES_MAX             /**< @see LINUX64_CLUSTER_FRAMES_MAX             */
+	#define MMU_RMAP_LENGTH        LINUX64_CLUSTER_MMU_RMAP_LENGTH        /**< @see LINUX64_CLUSTER_MMU_RMAP_LENGTH        */
 	/**@}*/
 
 	/**
 	 * @brief Provided Interface
 	 */
 	/**@{*/
-	#define __tlb_flush_fn /**< tlb_flush() */
-	#define __tlbe_dump_fn /**< tlb_dump()  */
+	#define __tlb_flush_fn    /**< tlb_flush()    */
+	#define __tlbe_dump_fn    /**< tlb_dump()     */
+	#define __mem_snapshot_fn /**< mem_snapshot() */
 	/**@}*/
 
 	/**
@@ -188,6 +378,14 @@
 		return (0);
 	}
 
+	/**
+	 * @see linux64_cluster_memory_snapshot().
+	 */
+	static inline int mem_snapshot(void)
+	{
+		return (linux64_cluster_memory_snapshot());
+	}
+
 /**@endcond*/
 
 #endif /* ARCH_CLUSTER_LINUX64_CLUSTER_MEMORY_H_ */
@@ -38,34 +38,56 @@
 
 	#include <posix/stdint.h>
 
-	#define INTERRUPT_TIMER 0
+	/**
+	 * @brief Timer interrupt.
+	 */
+	#define INTERRUPT_TIMER LINUX64_INT_TIMER
 
 	/**
 	 * @brief Cluster frequency.
 	 *
-	 * @note This is CLOCKS_PER_SEC but hard coded.
-	 * @todo TODO: remove hard coded value.
+	 * The cluster clock counts nanoseconds.
 	 */
-	#define LINUX64_CLUSTER_CLUSTER_FREQ 1000000
+	#define LINUX64_CLUSTER_CLUSTER_FREQ 1000000000
 
 #ifndef _ASM_FILE_
 
 	/**
-	 * @brief Reads the timestamp counter from the linux system.
+	 * @brief Reads the cluster clock.
 	 *
-	 * @returns The timestamp counter from the linux system.
+	 * @returns The number of nanoseconds elapsed since the cluster
+	 * was powered on.
 	 *
 	 * @author Daniel Coscia
 	 */
 	EXTERN uint64_t linux64_cluster_clock_read(void);
 
-
 	/**
-	 * @brief Initialize the timer at the current clock()
+	 * @brief Initializes the timer of the underlying core.
+	 *
+	 * @param freq Frequency of timer interrupts (in Hz). Zero stops
+	 * the timer.
+	 *
+	 * @note @p freq must not exceed LINUX64_CLUSTER_CLUSTER_FREQ.
 	 *
 	 * @author Daniel Coscia
 	 */
-	EXTERN void linux64_timer_init(void);
+	EXTERN void linux64_timer_init(unsigned freq);
+
+	/**
+	 * @brief Stops the timer of the underlying core.
+	 */
+	EXTERN void linux64_timer_stop(void);
+
+	/**
+	 * @brief Restarts the timer of the underlying core.
+	 */
+	EXTERN void linux64_timer_restart(void);
+
+	/**
+	 * @brief Powers on the cluster clock.
+	 */
+	EXTERN void linux64_cluster_timer_boot(void);
 
 #endif /* !_ASM_FILE_ */
 
@@ -90,6 +112,7 @@
 	/**@{*/
 	#define __timer_init_fn  /**< timer_init()  */
 	#define __timer_reset_fn /**< timer_reset() */
+	#define __timer_stop_fn  /**< timer_stop()  */
 	#define __clock_read_fn  /**< clock_read()  */
 	/**@}*/
 
@@ -100,18 +123,35 @@
 	 */
 	static inline void __timer_init(unsigned freq)
 	{
-		UNUSED(freq);
-		linux64_timer_init();
+		linux64_timer_init(freq);
 	}
 
 	/**
 	 * @brief Dummy function.
+	 *
+	 * @note Host timers are periodic, and thus need not be rearmed.
 	 */
 	static inline void timer_reset(void)
 	{
 		/* noop */
 	}
 
+	/**
+	 * @see linux64_timer_stop().
+	 */
+	static inline void __timer_stop(void)
+	{
+		linux64_timer_stop();
+	}
+
+	/**
+	 * @see linux64_timer_restart().
+	 */
+	static inline void __timer_restart(void)
+	{
+		linux64_timer_restart();
+	}
+
 	/**
 	 * @see linux64_cluster_clock_read().
 	 */
@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef ARCH_CLUSTER_LINUX64_CLUSTER_TOPOLOGY_H_
+#define ARCH_CLUSTER_LINUX64_CLUSTER_TOPOLOGY_H_
+
+	/* Cluster Interface Implementation */
+	#include <arch/cluster/linux64-cluster/_linux64-cluster.h>
+
+/**
+ * @addtogroup linux64-cluster-topology Topology
+ * @ingroup linux64-cluster
+ *
+ * @brief Placement of Cores on Host CPUs
+ */
+/**@{*/
+
+	#include <nanvix/const.h>
+	#include <posix/stddef.h>
+
+	/**
+	 * @name Placement Policies
+	 */
+	/**@{*/
+	#define LINUX64_CLUSTER_AFFINITY_NONE    0 /**< Left to the host scheduler. */
+	#define LINUX64_CLUSTER_AFFINITY_COMPACT 1 /**< One domain per cluster.     */
+	/**@}*/
+
+	/**
+	 * @brief Maximum number of host CPUs.
+	 */
+	#define LINUX64_CLUSTER_HOST_CPUS_MAX 1024
+
+	/**
+	 * @brief Maximum number of host NUMA nodes.
+	 */
+	#define LINUX64_CLUSTER_HOST_NODES_MAX 64
+
+	/**
+	 * @brief Places the cores of the underlying cluster.
+	 *
+	 * @param clusternum Logical number of the underlying cluster.
+	 * @param ncores     Number of cores in the cluster.
+	 * @param policy     Placement policy.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int linux64_cluster_topology_boot(int clusternum, int ncores, int policy);
+
+	/**
+	 * @brief Pins the underlying core to its host CPU.
+	 */
+	EXTERN void linux64_cluster_topology_bind_core(void);
+
+	/**
+	 * @brief Binds a memory region to the host node of the cluster.
+	 *
+	 * @param base Base address of the region.
+	 * @param size Size of the region (in bytes).
+	 */
+	EXTERN void linux64_cluster_topology_bind_memory(void *base, size_t size);
+
+	/**
+	 * @brief Prints the placement of the underlying cluster.
+	 */
+	EXTERN void linux64_cluster_topology_dump(void);
+
+/**@}*/
+
+#endif /* ARCH_CLUSTER_LINUX64_CLUSTER_TOPOLOGY_H_ */
@@ -801,7 +801,7 @@
 	/**
 	 * @see i486_page_map().
 	 */
-	static inline int mmu_page_map(struct pte *pgtab, paddr_t paddr, vaddr_t vaddr, int w, int x)
+	static inline int __mmu_page_map(struct pte *pgtab, paddr_t paddr, vaddr_t vaddr, int w, int x)
 	{
 		return (i486_page_map(pgtab, paddr, vaddr, w, x));
 	}
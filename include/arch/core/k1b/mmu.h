@@ -830,7 +830,7 @@
 	/**
 	 * @see k1b_page_map().
 	 */
-	static inline int mmu_page_map(struct pte *pgtab, paddr_t paddr, vaddr_t vaddr, int w, int x)
+	static inline int __mmu_page_map(struct pte *pgtab, paddr_t paddr, vaddr_t vaddr, int w, int x)
 	{
 		UNUSED(x);
 		return (k1b_page_map(pgtab, paddr, vaddr, w));
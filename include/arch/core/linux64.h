@@ -76,7 +76,7 @@
 	#define CORE_HAS_PMIO                0 /**< Has Programmed I/O?                */
 	#define CORE_HAS_TLB_HW              1 /**< Has Hardware-Managed TLB?          */
 	#define CORE_HAS_CACHE_HW            1 /**< Has Hardware-Managed Cache?        */
-	#define CORE_HAS_HUGE_PAGES          0 /**< Are Huge Pages Supported?          */
+	#define CORE_HAS_HUGE_PAGES          1 /**< Are Huge Pages Supported?          */
 	#define CORE_IS_LITTLE_ENDIAN        0 /**< Is Little Endian?                  */
 	#define CORE_SUPPORTS_MULTITHREADING 0 /**< Has support for context switching? */
 	/**@}*/
@@ -33,7 +33,9 @@
  */
 /**@{*/
 
+	#include <nanvix/const.h>
 	#include <nanvix/hlib.h>
+	#include <posix/stdint.h>
 	#include <stdlib.h>
 
 	/**
@@ -121,6 +123,93 @@
 	 */
 	EXTERN void linux64_core_icache_setup(void);
 
+	/**
+	 * @name Data Cache Model Operations
+	 */
+	/**@{*/
+	#define LINUX64_DCACHE_OP_INVALIDATE      0 /**< Invalidate           */
+	#define LINUX64_DCACHE_OP_FLUSH           1 /**< Flush                */
+	#define LINUX64_DCACHE_OP_FENCE           2 /**< Fence                */
+	#define LINUX64_DCACHE_OP_LINE_INVALIDATE 3 /**< Line Invalidate      */
+	#define LINUX64_DCACHE_OP_LINE_PREFETCH   4 /**< Line Prefetch        */
+	#define LINUX64_DCACHE_OPS_NUM            5 /**< Number of Operations */
+	/**@}*/
+
+	/**
+	 * @name Data Cache Model Limits
+	 */
+	/**@{*/
+	#define LINUX64_DCACHE_MODEL_LINES_MAX 4096 /**< Maximum Number of Lines */
+	#define LINUX64_DCACHE_MODEL_WAYS_MAX  16   /**< Maximum Associativity   */
+	#define LINUX64_DCACHE_MODEL_SITES     64   /**< Tracked Call Sites      */
+	#define LINUX64_DCACHE_MODEL_WAYS      4    /**< Default Associativity   */
+	/**@}*/
+
+	/**
+	 * @name Data Cache Model Costs (in cycles)
+	 *
+	 * Rough figures for a non-coherent in-order core.
+	 */
+	/**@{*/
+	#define LINUX64_DCACHE_COST_OP        10 /**< Issue an Operation       */
+	#define LINUX64_DCACHE_COST_WALK      1  /**< Visit a Line             */
+	#define LINUX64_DCACHE_COST_HIT       1  /**< Hit a Line               */
+	#define LINUX64_DCACHE_COST_MISS      30 /**< Fetch a Line             */
+	#define LINUX64_DCACHE_COST_WRITEBACK 30 /**< Write a Dirty Line Back  */
+	/**@}*/
+
+	/**
+	 * @brief Data cache model statistics.
+	 */
+	struct linux64_dcache_model_stats
+	{
+		uint64_t hits;                           /**< Line Hits                */
+		uint64_t misses;                         /**< Line Misses              */
+		uint64_t writebacks;                     /**< Dirty Lines Written Back */
+		uint64_t access_cycles;                  /**< Cycles Spent on Accesses */
+		uint64_t ops[LINUX64_DCACHE_OPS_NUM];    /**< Operations Issued        */
+		uint64_t cycles[LINUX64_DCACHE_OPS_NUM]; /**< Cycles Spent on Each Op  */
+	};
+
+	/**
+	 * @brief Configures the data cache model.
+	 *
+	 * @param size Cache size (in bytes), or zero to turn the model off.
+	 * @param ways Associativity.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 *
+	 * @note This should be called before cores are set up.
+	 */
+	EXTERN int linux64_core_dcache_model_configure(size_t size, unsigned ways);
+
+	/**
+	 * @brief Feeds memory accesses to the data cache model.
+	 *
+	 * @param addr  Target address.
+	 * @param size  Number of bytes accessed.
+	 * @param write Write access?
+	 */
+	EXTERN void linux64_core_dcache_model_access(const void *addr, size_t size, bool write);
+
+	/**
+	 * @brief Gets statistics of the data cache model.
+	 *
+	 * @param coreid ID of the target core.
+	 * @param stats  Store location for statistics.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int linux64_core_dcache_model_stats_get(int coreid, struct linux64_dcache_model_stats *stats);
+
+	/**
+	 * @brief Dumps the call sites with the most expensive cache
+	 * maintenance in the underlying core.
+	 */
+	EXTERN void linux64_core_dcache_model_dump(void);
+
 /**@}*/
 
 /*============================================================================*
@@ -35,9 +35,46 @@
 /**@{*/
 
 	#include <arch/core/linux64/types.h>
+	#include <arch/core/linux64/perf.h>
 	#include <nanvix/const.h>
 	#include <nanvix/hlib.h>
 
+#ifndef _ASM_FILE_
+
+	/**
+	 * @brief Per-core context.
+	 *
+	 * Each core of a linux64 cluster is backed by a thread, and
+	 * this block lives in its thread-local storage. It is filled
+	 * once, when the underlying thread starts, so that per-core
+	 * state is reached with a single load instead of a lookup.
+	 */
+	struct linux64_core_context
+	{
+		int coreid;                                   /**< Core ID.              */
+		int level;                                    /**< Interrupt level.      */
+		uint64_t masked;                              /**< Masked interrupts.    */
+		uint64_t pending;                             /**< Deferred interrupts.  */
+		int perf_monitors[LINUX64_PERF_MONITORS_NUM]; /**< Performance monitors. */
+	};
+
+	/**
+	 * @brief Context of the underlying core.
+	 */
+	EXTERN __thread struct linux64_core_context linux64_core_context;
+
+	/**
+	 * @brief Initializes the context of the underlying core.
+	 *
+	 * @param coreid ID of the underlying core.
+	 *
+	 * @note This should be called once by the thread that backs the
+	 * target core, before anything else queries its ID.
+	 */
+	EXTERN void linux64_core_context_setup(int coreid);
+
+#endif /* _ASM_FILE_ */
+
 /**@}*/
 
 /*============================================================================*
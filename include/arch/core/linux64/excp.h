@@ -43,7 +43,7 @@
 	/**
 	 * @brief Exception information size (in bytes).
 	 */
-	#define LINUX64_EXCP_SIZE 8
+	#define LINUX64_EXCP_SIZE 16
 
 	/**
 	* @brief Max number of exceptions in the linux64 core.
@@ -66,6 +66,7 @@
 		{
 			unsigned num;               /**< Exception number. */
 			linux64_byte_t RESERVED[4]; /**< Required padding. */
+			vaddr_t addr;               /**< Faulting address. */
 		} PACK;
 
 	/**@endcond*/
@@ -89,6 +90,19 @@
 		return (excp->num);
 	}
 
+	/**
+	 * @brief Gets the faulting address of an exception.
+	 *
+	 * @param excp Target exception information structure.
+	 *
+	 * @returns The faulting address stored in the exception
+	 * information structure pointed to by @p excp.
+	 */
+	static inline vaddr_t linux64_excp_get_addr(const struct exception *excp)
+	{
+		return (excp->addr);
+	}
+
 	/**
 	 * @brief Dumps information about an exception.
 	 *
@@ -159,17 +173,11 @@
 	}
 
 	/**
-	 * @brief Dummy operation.
-	 *
-	 * @param excp Unused parameter.
-	 *
-	 * @returns Always zero.
+	 * @see linux64_excp_get_addr().
 	 */
 	static inline vaddr_t exception_get_addr(const struct exception *excp)
 	{
-		UNUSED(excp);
-
-		return (0);
+		return (linux64_excp_get_addr(excp));
 	}
 
 	/**
@@ -39,9 +39,30 @@
 	/**
 	 * @brief Number of interrupts.
 	 */
-	#define LINUX64_INT_NUM                2
-	#define LINUX64_INT_MAX_NUM (SIGALRM + 1)
-	#define LINUX64_INT_IPI              265 /* Dummy IPI */
+	#define LINUX64_INT_NUM                        4
+	#define LINUX64_INT_MAX_NUM (LINUX64_INT_TIMER + 1)
+
+	/**
+	 * @brief Inter-processor interrupt.
+	 *
+	 * IPIs are carried by a real-time signal sent to the thread of
+	 * the target core. glibc keeps the first real-time signals for
+	 * itself, so this one is well above SIGRTMIN.
+	 */
+	#define LINUX64_INT_IPI 40
+
+	/**
+	 * @brief Timer interrupt.
+	 *
+	 * Each core has its own host timer, which sends this real-time
+	 * signal to the thread of the core.
+	 */
+	#define LINUX64_INT_TIMER 41
+
+	/**
+	 * @brief Initializes interrupts in the underlying core.
+	 */
+	EXTERN void linux64_interrupts_setup(void);
 
 	/**
 	 * @brief Enable all the interrupts.
@@ -91,7 +112,7 @@
 	/**
  	* @brief Give the next interrupt called while blocked.
  	*
- 	* @return The number of the next interrupt OR a negative value if there is none.
+ 	* @return The number of the next interrupt OR zero if there is none.
  	*/
 	EXTERN int linux64_interrupt_next(void);
 
@@ -47,21 +47,22 @@
 	 * @name Page Shifts and Masks
 	 */
 	/**@{*/
-	#define LINUX64_PAGE_SHIFT  16                          /**< Page Shift        */
-	#define LINUX64_PGTAB_SHIFT 24                          /**< Page Table Shift  */
-	#define LINUX64_PAGE_MASK   (~(LINUX64_PAGE_SIZE - 1))  /**< Page Mask         */
-	#define LINUX64_PGTAB_MASK  (~(LINUX64_PGTAB_SIZE - 1)) /**< Page Table Mask   */
+	#define LINUX64_PAGE_SHIFT      16                          /**< Page Shift        */
+	#define LINUX64_PGTAB_SHIFT     24                          /**< Page Table Shift  */
+	#define LINUX64_HUGE_PAGE_SHIFT LINUX64_PGTAB_SHIFT         /**< Huge Page Shift   */
+	#define LINUX64_PAGE_MASK       (~(LINUX64_PAGE_SIZE - 1))  /**< Page Mask         */
+	#define LINUX64_PGTAB_MASK      (~(LINUX64_PGTAB_SIZE - 1)) /**< Page Table Mask   */
 	/**@}*/
 
 	/**
 	 * @name Size of Pages and Page Tables
 	 */
 	/**@{*/
-	#define LINUX64_HUGE_PAGE_SIZE (0x1UL << LINUX64_PAGE_SHIFT)  /**< Huge Page Size                       */
-	#define LINUX64_PAGE_SIZE      (0x1UL << LINUX64_PAGE_SHIFT)  /**< Page Size                            */
-	#define LINUX64_PGTAB_SIZE     (0x1UL << LINUX64_PGTAB_SHIFT) /**< Page Table Size                      */
-	#define LINUX64_PTE_SIZE        6                             /**< Page Table Entry Size (in bytes)     */
-	#define LINUX64_PDE_SIZE        6                             /**< Page Directory Entry Size (in bytes) */
+	#define LINUX64_HUGE_PAGE_SIZE (0x1UL << LINUX64_HUGE_PAGE_SHIFT) /**< Huge Page Size                       */
+	#define LINUX64_PAGE_SIZE      (0x1UL << LINUX64_PAGE_SHIFT)      /**< Page Size                            */
+	#define LINUX64_PGTAB_SIZE     (0x1UL << LINUX64_PGTAB_SHIFT)     /**< Page Table Size                      */
+	#define LINUX64_PTE_SIZE        6                                 /**< Page Table Entry Size (in bytes)     */
+	#define LINUX64_PDE_SIZE        6                                 /**< Page Directory Entry Size (in bytes) */
 	/**@}*/
 
 	/**
@@ -120,7 +121,8 @@
 		unsigned writable :  1; /**< Writable page?     */
 		unsigned user     :  1; /**< User page?         */
 		unsigned accessed :  1; /**< Accessed?          */
-		unsigned          : 12; /**< Unused.            */
+		unsigned huge     :  1; /**< Huge page?         */
+		unsigned          : 11; /**< Unused.            */
 		unsigned frame    : 32; /**< Frame number.      */
 	} PACK;
 
@@ -150,6 +152,19 @@
 	 */
 	EXTERN int linux64_page_map(struct pte *pgtab, paddr_t paddr, vaddr_t vaddr, int w);
 
+	/**
+	 * @brief Maps a huge page.
+	 *
+	 * @param pgdir Target page directory.
+	 * @param paddr Physical address of the target huge page frame.
+	 * @param vaddr Virtual address of the target huge page.
+	 * @param w     Writable huge page?
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int linux64_huge_page_map(struct pte *pgdir, paddr_t paddr, vaddr_t vaddr, int w);
+
 	/**
 	 * @brief Maps a page table.
 	 *
@@ -162,6 +177,26 @@
 	 */
 	EXTERN int linux64_pgtab_map(struct pde *pgdir, paddr_t paddr, vaddr_t vaddr);
 
+	/**
+	 * @brief Handles a memory fault in the emulated MMU.
+	 *
+	 * @param vaddr Faulting address.
+	 *
+	 * @returns If the faulting access may be retried, zero is
+	 * returned. If @p vaddr is not mapped, -EFAULT is returned. If it
+	 * is mapped without enough permissions, -EACCES is returned. If
+	 * @p vaddr does not lie in emulated memory, -ENOENT is returned.
+	 *
+	 * @note This function is provided by the cluster, which owns the
+	 * TLB.
+	 *
+	 * @note On a page or protection fault, the faulting access is
+	 * retried once the exception handler returns. A handler that
+	 * returns without fixing the mapping makes the access fault
+	 * again, forever.
+	 */
+	EXTERN int linux64_core_mmu_fault(vaddr_t vaddr);
+
 /**@}*/
 
 /*============================================================================*
@@ -176,7 +211,7 @@
 	 * @name Exported Constants
 	 */
 	/**@{*/
-	#define KPAGE_SIZE   LINUX64_HUGE_PAGE_SIZE /**< @ref LINUX64_HUGE_PAGE_SIZE */
+	#define KPAGE_SIZE   LINUX64_PAGE_SIZE      /**< @ref LINUX64_PAGE_SIZE      */
 	#define PAGE_SIZE    LINUX64_PAGE_SIZE      /**< @ref LINUX64_PAGE_SIZE      */
 	#define PGTAB_SIZE   LINUX64_PGTAB_SIZE     /**< @ref LINUX64_PGTAB_SIZE     */
 	#define PGTAB_LENGTH LINUX64_PGTAB_LENGTH   /**< @ref LINUX64_PGTAB_LENGTH   */
@@ -215,37 +250,39 @@
 	 * @brief Exported Functions
 	 */
 	/**@{*/
-	#define __pde_clear_fn       /**< pde_clear()       */
-	#define __pde_frame_get_fn   /**< pde_frame_get()   */
-	#define __pde_frame_set_fn   /**< pde_frame_set()   */
-	#define __pde_get_fn         /**< pde_get()         */
-	#define __pde_is_present_fn  /**< pde_is_present()  */
-	#define __pde_is_user_fn     /**< pde_is_user()     */
-	#define __pde_is_read_fn     /**< pde_is_read()     */
-	#define __pde_is_write_fn    /**< pde_is_write()    */
-	#define __pde_is_exec_fn     /**< pde_is_exec()     */
-	#define __pde_present_set_fn /**< pde_present_set() */
-	#define __pde_user_set_fn    /**< pde_user_set()    */
-	#define __pde_read_set_fn    /**< pde_read_set()    */
-	#define __pde_write_set_fn   /**< pde_write_set()   */
-	#define __pde_exec_set_fn    /**< pde_exec_set()    */
-	#define __pte_clear_fn       /**< pte_clear()       */
-	#define __pte_frame_get_fn   /**< pte_frame_get()   */
-	#define __pte_frame_set_fn   /**< pte_frame_set()   */
-	#define __pte_get_fn         /**< pte_get()         */
-	#define __pte_is_present_fn  /**< pte_is_present()  */
-	#define __pte_is_user_fn     /**< pte_is_user()     */
-	#define __pte_is_read_fn     /**< pte_is_read()     */
-	#define __pte_is_write_fn    /**< pte_is_write()    */
-	#define __pte_is_exec_fn     /**< pte_is_exec()     */
-	#define __pte_present_set_fn /**< pte_present_set() */
-	#define __pte_user_set_fn    /**< pte_user_set()    */
-	#define __pte_read_set_fn    /**< pte_read_set()    */
-	#define __pte_write_set_fn   /**< pte_write_set()   */
-	#define __pte_exec_set_fn    /**< pte_exec_set()    */
-	#define __mmu_page_map_fn    /**< mmu_page_map()    */
-	#define __mmu_pgtab_map_fn   /**< mmu_pgtab_map()   */
-	#define __mmu_is_enabled_fn  /**< mmu_is_enabled()  */
+	#define __pde_clear_fn         /**< pde_clear()         */
+	#define __pde_frame_get_fn     /**< pde_frame_get()     */
+	#define __pde_frame_set_fn     /**< pde_frame_set()     */
+	#define __pde_get_fn           /**< pde_get()           */
+	#define __pde_is_present_fn    /**< pde_is_present()    */
+	#define __pde_is_user_fn       /**< pde_is_user()       */
+	#define __pde_is_read_fn       /**< pde_is_read()       */
+	#define __pde_is_write_fn      /**< pde_is_write()      */
+	#define __pde_is_exec_fn       /**< pde_is_exec()       */
+	#define __pde_is_huge_fn       /**< pde_is_huge()       */
+	#define __pde_present_set_fn   /**< pde_present_set()   */
+	#define __pde_user_set_fn      /**< pde_user_set()      */
+	#define __pde_read_set_fn      /**< pde_read_set()      */
+	#define __pde_write_set_fn     /**< pde_write_set()     */
+	#define __pde_exec_set_fn      /**< pde_exec_set()      */
+	#define __pte_clear_fn         /**< pte_clear()         */
+	#define __pte_frame_get_fn     /**< pte_frame_get()     */
+	#define __pte_frame_set_fn     /**< pte_frame_set()     */
+	#define __pte_get_fn           /**< pte_get()           */
+	#define __pte_is_present_fn    /**< pte_is_present()    */
+	#define __pte_is_user_fn       /**< pte_is_user()       */
+	#define __pte_is_read_fn       /**< pte_is_read()       */
+	#define __pte_is_write_fn      /**< pte_is_write()      */
+	#define __pte_is_exec_fn       /**< pte_is_exec()       */
+	#define __pte_present_set_fn   /**< pte_present_set()   */
+	#define __pte_user_set_fn      /**< pte_user_set()      */
+	#define __pte_read_set_fn      /**< pte_read_set()      */
+	#define __pte_write_set_fn     /**< pte_write_set()     */
+	#define __pte_exec_set_fn      /**< pte_exec_set()      */
+	#define __mmu_page_map_fn      /**< mmu_page_map()      */
+	#define __mmu_huge_page_map_fn /**< mmu_huge_page_map() */
+	#define __mmu_pgtab_map_fn     /**< mmu_pgtab_map()     */
+	#define __mmu_is_enabled_fn    /**< mmu_is_enabled()    */
 	/**@}*/
 
 	/**
@@ -453,6 +490,24 @@
 		return (1);
 	}
 
+	/**
+	 * @brief Asserts if a page directory entry maps a huge page.
+	 *
+	 * @param pde Target page directory entry.
+	 *
+	 * @returns If the target page directory entry maps a huge page,
+	 * non zero is returned. Otherwise, or if @p pde is invalid, zero
+	 * is returned instead.
+	 */
+	static inline int pde_is_huge(struct pde *pde)
+	{
+		/* Invalid PDE. */
+		if (pde == NULL)
+			return (0);
+
+		return (pde->present && pde->huge);
+	}
+
 	/**
 	 * @brief Sets/clears the user bit of a page table.
 	 *
@@ -809,12 +864,21 @@
 	/**
 	 * @see linux64_page_map().
 	 */
-	static inline int mmu_page_map(struct pte *pgtab, paddr_t paddr, vaddr_t vaddr, int w, int x)
+	static inline int __mmu_page_map(struct pte *pgtab, paddr_t paddr, vaddr_t vaddr, int w, int x)
 	{
 		UNUSED(x);
 		return (linux64_page_map(pgtab, paddr, vaddr, w));
 	}
 
+	/**
+	 * @see linux64_huge_page_map().
+	 */
+	static inline int __mmu_huge_page_map(struct pte *pgdir, paddr_t paddr, vaddr_t vaddr, int w, int x)
+	{
+		UNUSED(x);
+		return (linux64_huge_page_map(pgdir, paddr, vaddr, w));
+	}
+
 	/**
 	 * @see linux64_pgtab_map().
 	 */
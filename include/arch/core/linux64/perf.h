@@ -89,11 +89,6 @@
 	#define LINUX64_PERF_ARG3 -1 /**< Default arg3 */
 	#define LINUX64_PERF_ARG4  0 /**< Default arg4 */
 
-	/**
-	 * @Brief Array of File Descriptor containing the values of the counters
-	 */
-	EXTERN int linux64_perf_monitors[LINUX64_PERF_MONITORS_NUM];
-
 	/**
 	 * @Brief Check if the perf and event values are valide
 	 */
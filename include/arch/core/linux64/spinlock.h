@@ -33,21 +33,102 @@
  */
 /**@{*/
 
-	#include <pthread.h>
+	#include <arch/core/linux64/cache.h>
+	#include <nanvix/const.h>
+	#include <posix/stdint.h>
+	#include <sched.h>
 
 	/**
-	 * @name Spinlock State
+	 * @name Spinlock Implementations
+	 *
+	 * The implementation is selected at build time by defining
+	 * __LINUX64_SPINLOCK to one of these values.
+	 */
+	/**@{*/
+	#define LINUX64_SPINLOCK_TTAS   0 /**< Test-and-test-and-set with backoff. */
+	#define LINUX64_SPINLOCK_TICKET 1 /**< Ticket lock.                        */
+	#define LINUX64_SPINLOCK_MCS    2 /**< MCS queue lock.                     */
+	/**@}*/
+
+	/**
+	 * @brief Default spinlock implementation.
+	 */
+	#ifndef __LINUX64_SPINLOCK
+	#define __LINUX64_SPINLOCK LINUX64_SPINLOCK_TTAS
+	#endif
+
+	#if (__LINUX64_SPINLOCK != LINUX64_SPINLOCK_TTAS)   && \
+	    (__LINUX64_SPINLOCK != LINUX64_SPINLOCK_TICKET) && \
+	    (__LINUX64_SPINLOCK != LINUX64_SPINLOCK_MCS)
+	#error "unknown spinlock implementation"
+	#endif
+
+	/**
+	 * @name Backoff Bounds (in relax iterations)
+	 */
+	/**@{*/
+	#define LINUX64_SPINLOCK_BACKOFF_MIN    4 /**< Initial backoff. */
+	#define LINUX64_SPINLOCK_BACKOFF_MAX 1024 /**< Maximum backoff. */
+	/**@}*/
+
+	/**
+	 * @brief Relax iterations before a waiter yields its host CPU.
+	 */
+	#define LINUX64_SPINLOCK_YIELD_THRESHOLD 256
+
+	/**
+	 * @brief Relaxes the underlying core while spinning.
+	 */
+	static inline void linux64_spinlock_relax(void)
+	{
+	#if defined(__x86_64__) || defined(__i386__)
+		__asm__ __volatile__("pause" ::: "memory");
+	#elif defined(__aarch64__)
+		__asm__ __volatile__("yield" ::: "memory");
+	#else
+		__asm__ __volatile__("" ::: "memory");
+	#endif
+	}
+
+	/**
+	 * @brief Spins for a while.
 	 *
-	 * @bug: We should wrap these.
+	 * @param nspins Number of relax iterations.
+	 * @param spent  Relax iterations spent so far by the caller.
+	 *
+	 * Cores are host threads that may outnumber host CPUs, so a
+	 * waiter that spun for too long yields to let the holder run.
+	 */
+	static inline void linux64_spinlock_spin(unsigned nspins, unsigned *spent)
+	{
+		for (unsigned i = 0; i < nspins; i++)
+			linux64_spinlock_relax();
+
+		if ((*spent += nspins) >= LINUX64_SPINLOCK_YIELD_THRESHOLD)
+		{
+			*spent = 0;
+			sched_yield();
+		}
+	}
+
+/*----------------------------------------------------------------------------*
+ * Test-and-Test-and-Set                                                      *
+ *----------------------------------------------------------------------------*/
+
+#if (__LINUX64_SPINLOCK == LINUX64_SPINLOCK_TTAS)
+
+	/**
+	 * @name Spinlock State
 	 */
 	/**@{*/
-	#define LINUX64_SPINLOCK_UNLOCKED PTHREAD_MUTEX_INITIALIZER /**< Unlocked */
+	#define LINUX64_SPINLOCK_UNLOCKED 0x0 /**< Unlocked */
+	#define LINUX64_SPINLOCK_LOCKED   0x1 /**< Locked   */
 	/**@}*/
 
 	/**
 	 * @brief Spinlock.
 	 */
-	typedef pthread_mutex_t linux64_spinlock_t;
+	typedef uint32_t linux64_spinlock_t;
 
 	/**
 	 * @brief Initializes a spinlock.
@@ -56,17 +137,95 @@
 	 */
 	static inline void linux64_spinlock_init(linux64_spinlock_t *lock)
 	{
-		pthread_mutex_init(lock, NULL);
+		__atomic_store_n(lock, LINUX64_SPINLOCK_UNLOCKED, __ATOMIC_RELEASE);
+	}
+
+	/**
+	 * @brief Attempts to lock a spinlock.
+	 *
+	 * @param lock Target spinlock.
+	 *
+	 * @returns Upon successful completion, the spinlock pointed to by
+	 * @p lock is locked and non-zero is returned. Upon failure, zero
+	 * is returned instead, and the lock is not acquired by the
+	 * caller.
+	 */
+	static inline int linux64_spinlock_trylock(linux64_spinlock_t *lock)
+	{
+		/* Read first, so that a held lock is not written. */
+		if (__atomic_load_n(lock, __ATOMIC_RELAXED) != LINUX64_SPINLOCK_UNLOCKED)
+			return (0);
+
+		return (
+			__atomic_exchange_n(lock, LINUX64_SPINLOCK_LOCKED, __ATOMIC_ACQUIRE)
+				== LINUX64_SPINLOCK_UNLOCKED
+		);
 	}
 
 	/**
 	 * @brief Locks a spinlock.
 	 *
 	 * @param lock Target spinlock.
+	 *
+	 * Waiters spin on a local read and back off exponentially after
+	 * each failed attempt, to keep the cache line of the lock from
+	 * bouncing between cores.
 	 */
 	static inline void linux64_spinlock_lock(linux64_spinlock_t *lock)
 	{
-		pthread_mutex_lock(lock);
+		unsigned spent = 0;
+		unsigned backoff = LINUX64_SPINLOCK_BACKOFF_MIN;
+
+		while (!linux64_spinlock_trylock(lock))
+		{
+			linux64_spinlock_spin(backoff, &spent);
+
+			if (backoff < LINUX64_SPINLOCK_BACKOFF_MAX)
+				backoff <<= 1;
+		}
+	}
+
+	/**
+	 * @brief Unlocks a spinlock.
+	 *
+	 * @param lock Target spinlock.
+	 */
+	static inline void linux64_spinlock_unlock(linux64_spinlock_t *lock)
+	{
+		__atomic_store_n(lock, LINUX64_SPINLOCK_UNLOCKED, __ATOMIC_RELEASE);
+	}
+
+/*----------------------------------------------------------------------------*
+ * Ticket                                                                     *
+ *----------------------------------------------------------------------------*/
+
+#elif (__LINUX64_SPINLOCK == LINUX64_SPINLOCK_TICKET)
+
+	/**
+	 * @name Spinlock State
+	 */
+	/**@{*/
+	#define LINUX64_SPINLOCK_UNLOCKED { 0, 0 } /**< Unlocked */
+	/**@}*/
+
+	/**
+	 * @brief Spinlock.
+	 */
+	typedef struct
+	{
+		uint32_t next;  /**< Next ticket to hand out. */
+		uint32_t owner; /**< Ticket being served.     */
+	} linux64_spinlock_t;
+
+	/**
+	 * @brief Initializes a spinlock.
+	 *
+	 * @param lock Target spinlock.
+	 */
+	static inline void linux64_spinlock_init(linux64_spinlock_t *lock)
+	{
+		__atomic_store_n(&lock->next, 0, __ATOMIC_RELAXED);
+		__atomic_store_n(&lock->owner, 0, __ATOMIC_RELEASE);
 	}
 
 	/**
@@ -81,7 +240,50 @@
 	 */
 	static inline int linux64_spinlock_trylock(linux64_spinlock_t *lock)
 	{
-		return (!pthread_mutex_trylock(lock));
+		uint32_t owner;
+		uint32_t expected;
+
+		/* Only take a ticket if it would be served right away. */
+		owner = __atomic_load_n(&lock->owner, __ATOMIC_ACQUIRE);
+		expected = owner;
+
+		return (
+			__atomic_compare_exchange_n(
+				&lock->next,
+				&expected,
+				owner + 1,
+				0,
+				__ATOMIC_ACQUIRE,
+				__ATOMIC_RELAXED
+			)
+		);
+	}
+
+	/**
+	 * @brief Locks a spinlock.
+	 *
+	 * @param lock Target spinlock.
+	 *
+	 * Cores are served in arrival order. Only the next waiter in
+	 * line spins, the others yield their host CPU on every poll, so
+	 * that a preempted holder or successor gets to run sooner when
+	 * cores outnumber host CPUs.
+	 */
+	static inline void linux64_spinlock_lock(linux64_spinlock_t *lock)
+	{
+		uint32_t ticket;
+		uint32_t owner;
+		unsigned spent = 0;
+
+		ticket = __atomic_fetch_add(&lock->next, 1, __ATOMIC_RELAXED);
+
+		while ((owner = __atomic_load_n(&lock->owner, __ATOMIC_ACQUIRE)) != ticket)
+		{
+			if ((ticket - owner) > 1)
+				sched_yield();
+			else
+				linux64_spinlock_spin(LINUX64_SPINLOCK_BACKOFF_MIN, &spent);
+		}
 	}
 
 	/**
@@ -91,9 +293,89 @@
 	 */
 	static inline void linux64_spinlock_unlock(linux64_spinlock_t *lock)
 	{
-		pthread_mutex_unlock(lock);
+		uint32_t owner;
+
+		owner = __atomic_load_n(&lock->owner, __ATOMIC_RELAXED);
+		__atomic_store_n(&lock->owner, owner + 1, __ATOMIC_RELEASE);
 	}
 
+/*----------------------------------------------------------------------------*
+ * MCS                                                                        *
+ *----------------------------------------------------------------------------*/
+
+#elif (__LINUX64_SPINLOCK == LINUX64_SPINLOCK_MCS)
+
+	/**
+	 * @name Spinlock State
+	 */
+	/**@{*/
+	#define LINUX64_SPINLOCK_UNLOCKED { NULL, NULL } /**< Unlocked */
+	/**@}*/
+
+	/**
+	 * @brief Queue node of an MCS lock.
+	 */
+	struct linux64_spinlock_node
+	{
+		struct linux64_spinlock_node *next; /**< Next waiter.              */
+		uint32_t locked;                    /**< Still waiting?            */
+		uint32_t used;                      /**< Node in use by this core? */
+	} ALIGN(CACHE_LINE_SIZE);
+
+	/**
+	 * @brief Spinlock.
+	 */
+	typedef struct
+	{
+		struct linux64_spinlock_node *tail;   /**< Last waiter.       */
+		struct linux64_spinlock_node *holder; /**< Node of the owner. */
+	} linux64_spinlock_t;
+
+	/**
+	 * @brief Initializes a spinlock.
+	 *
+	 * @param lock Target spinlock.
+	 */
+	static inline void linux64_spinlock_init(linux64_spinlock_t *lock)
+	{
+		lock->holder = NULL;
+		__atomic_store_n(&lock->tail, NULL, __ATOMIC_RELEASE);
+	}
+
+	/**
+	 * @brief Locks a spinlock.
+	 *
+	 * @param lock Target spinlock.
+	 *
+	 * Each waiter spins on its own queue node, so a release touches
+	 * only the cache line of the next core in line.
+	 */
+	EXTERN void linux64_spinlock_lock(linux64_spinlock_t *lock);
+
+	/**
+	 * @brief Attempts to lock a spinlock.
+	 *
+	 * @param lock Target spinlock.
+	 *
+	 * @returns Upon successful completion, the spinlock pointed to by
+	 * @p lock is locked and non-zero is returned. Upon failure, zero
+	 * is returned instead, and the lock is not acquired by the
+	 * caller.
+	 */
+	EXTERN int linux64_spinlock_trylock(linux64_spinlock_t *lock);
+
+	/**
+	 * @brief Unlocks a spinlock.
+	 *
+	 * @param lock Target spinlock.
+	 *
+	 * @note The lock may be released by a core other than the one
+	 * that acquired it.
+	 */
+	EXTERN void linux64_spinlock_unlock(linux64_spinlock_t *lock);
+
+#endif
+
 /**@}*/
 
 /*============================================================================*
@@ -277,6 +277,7 @@
 	#define __pde_is_read_fn       /**< pde_is_read()       */
 	#define __pde_is_write_fn      /**< pde_is_write()      */
 	#define __pde_is_exec_fn       /**< pde_is_exec()       */
+	#define __pde_is_huge_fn       /**< pde_is_huge()       */
 	#define __pde_present_set_fn   /**< pde_present_set()   */
 	#define __pde_user_set_fn      /**< pde_user_set()      */
 	#define __pde_read_set_fn      /**< pde_read_set()      */
@@ -490,6 +491,24 @@
 		return (pde->ppi & (OR1K_PT_PPI_SPV_EX >> OR1K_PT_PPI_OFFSET));
 	}
 
+	/**
+	 * @brief Asserts if a page directory entry maps a huge page.
+	 *
+	 * @param pde Target page directory entry.
+	 *
+	 * @returns If the target page directory entry maps a huge page,
+	 * non zero is returned. Otherwise, or if @p pde is invalid, zero
+	 * is returned instead.
+	 */
+	static inline int pde_is_huge(struct pde *pde)
+	{
+		/* Invalid PDE. */
+		if (pde == NULL)
+			return (0);
+
+		return (pde->present && pde->last);
+	}
+
 	/**
 	 * @brief Sets/clears the user bit of a page table.
 	 *
@@ -811,7 +830,7 @@
 	/**
 	 * @see or1k_page_map().
 	 */
-	static inline int mmu_page_map(struct pte *pgtab, paddr_t paddr, vaddr_t vaddr, int w, int x)
+	static inline int __mmu_page_map(struct pte *pgtab, paddr_t paddr, vaddr_t vaddr, int w, int x)
 	{
 		return (or1k_page_map(pgtab, paddr, vaddr, w, x));
 	}
@@ -819,7 +838,7 @@
 	/**
 	 * @see or1k_huge_page_map().
 	 */
-	static inline int mmu_huge_page_map(struct pte *pgdir, paddr_t paddr, vaddr_t vaddr, int w, int x)
+	static inline int __mmu_huge_page_map(struct pte *pgdir, paddr_t paddr, vaddr_t vaddr, int w, int x)
 	{
 		return (or1k_huge_page_map(pgdir, paddr, vaddr, w, x));
 	}
@@ -266,6 +266,7 @@
 	#define __pde_is_read_fn       /**< pde_is_read()       */
 	#define __pde_is_write_fn      /**< pde_is_write()      */
 	#define __pde_is_exec_fn       /**< pde_is_exec()       */
+	#define __pde_is_huge_fn       /**< pde_is_huge()       */
 	#define __pde_present_set_fn   /**< pde_present_set()   */
 	#define __pde_user_set_fn      /**< pde_user_set()      */
 	#define __pde_read_set_fn      /**< pde_read_set()      */
@@ -521,6 +522,24 @@
 		return (pde->executable);
 	}
 
+	/**
+	 * @brief Asserts if a page directory entry maps a huge page.
+	 *
+	 * @param pde Target page directory entry.
+	 *
+	 * @returns If the target page directory entry maps a huge page,
+	 * non zero is returned. Otherwise, or if @p pde is invalid, zero
+	 * is returned instead.
+	 */
+	static inline int pde_is_huge(struct pde *pde)
+	{
+		/* Invalid PDE. */
+		if (pde == NULL)
+			return (0);
+
+		return (pde->valid && (pde->readable || pde->writable || pde->executable));
+	}
+
 	/**
 	 * @brief Sets/clears the user bit of a page.
 	 *
@@ -887,7 +906,7 @@
 	/**
 	 * @see rv32gc_page_map().
 	 */
-	static inline int mmu_page_map(struct pte *pgtab, paddr_t paddr, vaddr_t vaddr, int w, int x)
+	static inline int __mmu_page_map(struct pte *pgtab, paddr_t paddr, vaddr_t vaddr, int w, int x)
 	{
 		return (rv32gc_page_map(pgtab, paddr, vaddr, w, x));
 	}
@@ -895,7 +914,7 @@
 	/**
 	 * @see rv32gc_huge_page_map().
 	 */
-	static inline int mmu_huge_page_map(struct pte *pgdir, paddr_t paddr, vaddr_t vaddr, int w, int x)
+	static inline int __mmu_huge_page_map(struct pte *pgdir, paddr_t paddr, vaddr_t vaddr, int w, int x)
 	{
 		return (rv32gc_huge_page_map(pgdir, paddr, vaddr, w, x));
 	}
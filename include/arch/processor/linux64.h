@@ -50,11 +50,13 @@
 	 * @brief Powers on the underlying processor.
 	 *
 	 * @param nclusters Number of clusters to power on.
+	 * @param ncores    Number of cores to power on in each cluster.
+	 * @param affinity  Placement policy for cores.
 	 *
 	 * @returns Upon successful completion, zero is returned. Upon
 	 * failure, a negative error code is returned instead.
 	 */
-	EXTERN int linux64_processor_boot(int nclusters);
+	EXTERN int linux64_processor_boot(int nclusters, int ncores, int affinity);
 
 	/**
 	 * @brief Initializes the underlying processor.
@@ -71,6 +71,7 @@
 	 */
 	/**@{*/
 	#define MPPA256_SYNC_IOCTL_SET_ASYNC_BEHAVIOR 0 /**< Sets the wait/wakeup functions on a resource. */
+	#define MPPA256_SYNC_IOCTL_SET_COUNTING_MODE  1 /**< Switches counting mode (not supported).      */
 	/**@}*/
 
 #if !__NANVIX_IKC_USES_ONLY_MAILBOX
@@ -187,6 +188,7 @@
 	 */
 	/**@{*/
 	#define SYNC_IOCTL_SET_ASYNC_BEHAVIOR MPPA256_SYNC_IOCTL_SET_ASYNC_BEHAVIOR /**< @see MPPA256_SYNC_IOCTL_SET_ASYNC_BEHAVIOR */
+	#define SYNC_IOCTL_SET_COUNTING_MODE  MPPA256_SYNC_IOCTL_SET_COUNTING_MODE  /**< @see MPPA256_SYNC_IOCTL_SET_COUNTING_MODE  */
 	/**@}*/
 
 #if !__NANVIX_IKC_USES_ONLY_MAILBOX
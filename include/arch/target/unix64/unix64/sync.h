@@ -72,6 +72,7 @@
 	 */
 	/**@{*/
 	#define UNIX64_SYNC_IOCTL_SET_ASYNC_BEHAVIOR 0 /**< Sets the wait/wakeup functions on a resource. */
+	#define UNIX64_SYNC_IOCTL_SET_COUNTING_MODE  1 /**< Enables/disables counting of signals.        */
 	/**@}*/
 
 	/**
@@ -161,6 +162,28 @@
 	 */
 	EXTERN int unix64_sync_wait(int syncid);
 
+	/**
+	 * @brief Waits for several signals on a synchronization point.
+	 *
+	 * @param syncid   ID of the target synchronization point.
+	 * @param nsignals Number of signals to consume.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int unix64_sync_wait_n(int syncid, int nsignals);
+
+	/**
+	 * @brief Gets the number of pending signals on a synchronization point.
+	 *
+	 * @param syncid ID of the target synchronization point.
+	 *
+	 * @returns Upon successful completion, the number of pending
+	 * signals is returned. Upon failure, a negative error code is
+	 * returned instead.
+	 */
+	EXTERN int unix64_sync_npending(int syncid);
+
 	/**
 	 * @brief Waits on a synchronization point.
 	 *
@@ -187,14 +210,16 @@
 	 * @name Provided Functions.
 	 */
 	/**@{*/
-	#define __sync_setup_fn  /**< sync_setup()  */
-	#define __sync_create_fn /**< sync_create() */
-	#define __sync_open_fn   /**< sync_open()   */
-	#define __sync_unlink_fn /**< sync_unlink() */
-	#define __sync_close_fn  /**< sync_close()  */
-	#define __sync_wait_fn   /**< sync_wait()   */
-	#define __sync_signal_fn /**< sync_signal() */
-	#define __sync_ioctl_fn  /**< sync_ioctl()  */
+	#define __sync_setup_fn    /**< sync_setup()    */
+	#define __sync_create_fn   /**< sync_create()   */
+	#define __sync_open_fn     /**< sync_open()     */
+	#define __sync_unlink_fn   /**< sync_unlink()   */
+	#define __sync_close_fn    /**< sync_close()    */
+	#define __sync_wait_fn     /**< sync_wait()     */
+	#define __sync_wait_n_fn   /**< sync_wait_n()   */
+	#define __sync_npending_fn /**< sync_npending() */
+	#define __sync_signal_fn   /**< sync_signal()   */
+	#define __sync_ioctl_fn    /**< sync_ioctl()    */
 	/**@}*/
 
 	/**
@@ -214,6 +239,7 @@
 	 */
 	/**@{*/
 	#define SYNC_IOCTL_SET_ASYNC_BEHAVIOR UNIX64_SYNC_IOCTL_SET_ASYNC_BEHAVIOR /**< @see UNIX64_SYNC_IOCTL_SET_ASYNC_BEHAVIOR */
+	#define SYNC_IOCTL_SET_COUNTING_MODE  UNIX64_SYNC_IOCTL_SET_COUNTING_MODE  /**< @see UNIX64_SYNC_IOCTL_SET_COUNTING_MODE  */
 	/**@}*/
 
 #if !__NANVIX_IKC_USES_ONLY_MAILBOX
@@ -254,6 +280,18 @@
 	#define __sync_wait(syncid) \
 		unix64_sync_wait(syncid)
 
+	/**
+	 * @see unix64_sync_wait_n()
+	 */
+	#define __sync_wait_n(syncid, nsignals) \
+		unix64_sync_wait_n(syncid, nsignals)
+
+	/**
+	 * @see unix64_sync_npending()
+	 */
+	#define __sync_npending(syncid) \
+		unix64_sync_npending(syncid)
+
 	/**
 	 * @see unix64_sync_signal()
 	 */
@@ -86,11 +86,22 @@
 	#include <nanvix/hal/cluster/ipi.h>
 	#include <nanvix/hal/cluster/event.h>
 	#include <nanvix/hal/cluster/memory.h>
+	#include <nanvix/hal/cluster/slab.h>
 #ifndef __unix64__
 	#include <nanvix/hal/cluster/mmio.h>
 #endif
 	#include <nanvix/const.h>
 
+	/**
+	 * @brief Maximum number of cores in a cluster.
+	 *
+	 * Clusters that choose their number of cores at boot time
+	 * export a compile-time ceiling for per-core tables.
+	 */
+	#ifndef CORES_NUM_MAX
+		#define CORES_NUM_MAX CORES_NUM
+	#endif
+
 	/**
 	 * @brief Cluster Features
 	 */
@@ -127,17 +138,18 @@
 	 */
 	struct coreinfo
 	{
-		volatile bool initialized; /**< Initialized?      */
-		volatile int state;        /**< State.            */
-		volatile int wakeups;      /**< Wakeup signals.   */
-		void (*start)(void);       /**< Starting routine. */
-		spinlock_t lock;           /**< Lock.             */
+		volatile bool initialized; /**< Initialized?                  */
+		volatile int state;        /**< State.                        */
+		volatile int wakeups;      /**< Wakeup signals.               */
+		void (*start)(void);       /**< Starting routine.             */
+		spinlock_t lock;           /**< Lock.                         */
+		volatile int starter;      /**< Core waiting to start it, -1. */
 	};
 
 	/**
 	 * @brief Cores table.
 	 */
-	EXTERN struct coreinfo cores[CORES_NUM];
+	EXTERN struct coreinfo cores[CORES_NUM_MAX];
 
 #endif /* __NANVIX_HAL */
 
@@ -170,6 +170,86 @@
 	 */
 	EXTERN struct memory_region mem_layout[MEM_REGIONS];
 
+	/**
+	 * @name Memory Sizes (in bytes)
+	 *
+	 * Targets that size memory at boot override these, and then
+	 * KMEM_SIZE, KPOOL_SIZE and UMEM_SIZE are upper bounds.
+	 */
+	/**@{*/
+	#ifndef kmem_size
+	#define kmem_size KMEM_SIZE   /**< Kernel Memory    */
+	#endif
+	#ifndef kpool_size
+	#define kpool_size KPOOL_SIZE /**< Kernel Page Pool */
+	#endif
+	#ifndef umem_size
+	#define umem_size UMEM_SIZE   /**< User Memory      */
+	#endif
+	/**@}*/
+
+	/**
+	 * @brief Maximum number of page frames.
+	 */
+	#ifndef MEM_FRAMES_MAX
+	#define MEM_FRAMES_MAX (UMEM_SIZE/PAGE_SIZE)
+	#endif
+
+	/**
+	 * @brief Largest order of a page frame allocation.
+	 */
+	#define FRAME_ORDER_MAX 10
+
+	/**
+	 * @brief Number of page frames in a per-core cache.
+	 */
+	#define FRAME_CACHE_SIZE 32
+
+	/**
+	 * @brief Page frame allocator statistics.
+	 */
+	struct frame_stats
+	{
+		size_t nframes;                      /**< Page frames.                */
+		size_t nfree;                        /**< Free page frames.           */
+		size_t ncached;                      /**< Page frames in core caches. */
+		size_t nblocks[FRAME_ORDER_MAX + 1]; /**< Free blocks of each order.  */
+	};
+
+	/**
+	 * @brief Allocates contiguous page frames.
+	 *
+	 * @param order Allocation order.
+	 * @param paddr Store location for the physical address.
+	 *
+	 * @returns Upon successful completion, zero is returned and
+	 * 2^@p order contiguous page frames, aligned to their size, are
+	 * stored in the location pointed to by @p paddr. Upon failure, a
+	 * negative error code is returned instead.
+	 */
+	EXTERN int frame_alloc(int order, paddr_t *paddr);
+
+	/**
+	 * @brief Releases contiguous page frames.
+	 *
+	 * @param paddr Physical address of the first page frame.
+	 * @param order Allocation order.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int frame_free(paddr_t paddr, int order);
+
+	/**
+	 * @brief Gets statistics of the page frame allocator.
+	 *
+	 * @param stats Store location for statistics.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int frame_stats_get(struct frame_stats *stats);
+
 #ifdef __NANVIX_HAL
 
 	/**
@@ -216,6 +296,23 @@
 	}
 #endif
 
+	/**
+	 * @brief Flags the TLB index of a core as stale.
+	 *
+	 * @param coreid ID of the target core.
+	 *
+	 * Underlying TLBs that are changed other than by tlb_write() and
+	 * tlb_inval() should be flagged, so that their index is rebuilt.
+	 */
+#if (!CORE_HAS_TLB_HW)
+	EXTERN void tlb_index_invalidate(int coreid);
+#else
+	static inline void tlb_index_invalidate(int coreid)
+	{
+		UNUSED(coreid);
+	}
+#endif
+
 #endif /* __NANVIX_HAL */
 
 	/**
@@ -262,6 +359,29 @@
 	}
 #endif
 
+	/**
+	 * @brief Invalidates a range of virtual addresses in the TLB.
+	 *
+	 * @param tlb_type Target TLB (D-TLB or I-TLB).
+	 * @param vaddr    Start virtual address.
+	 * @param size     Size of the range (in bytes).
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+#if (!CORE_HAS_TLB_HW)
+	EXTERN int tlb_inval_range(int tlb_type, vaddr_t vaddr, size_t size);
+#else
+	static inline int tlb_inval_range(int tlb_type, vaddr_t vaddr, size_t size)
+	{
+		UNUSED(tlb_type);
+		UNUSED(vaddr);
+		UNUSED(size);
+
+		return (0);
+	}
+#endif
+
 	/**
 	 * @brief Initialize the architectural TLB of the underlying core.
 	 */
@@ -333,6 +453,21 @@
 	 */
 	EXTERN int tlb_shootdown(vaddr_t vaddr);
 
+	/**
+	 * @brief Saves the memory image of the underlying cluster.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+#ifdef __mem_snapshot_fn
+	EXTERN int mem_snapshot(void);
+#else
+	static inline int mem_snapshot(void)
+	{
+		return (-ENOTSUP);
+	}
+#endif
+
 	/**
 	 * @brief Does a memory warmup in the underlying cluster.
 	 */
@@ -0,0 +1,115 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NANVIX_HAL_CLUSTER_SLAB_H_
+#define NANVIX_HAL_CLUSTER_SLAB_H_
+
+	/* Cluster Interface Implementation */
+	#include <nanvix/hal/cluster/_cluster.h>
+
+/*============================================================================*
+ * Slab Allocator Interface                                                   *
+ *============================================================================*/
+
+/**
+ * @addtogroup kernel-hal-cluster-slab Slab Allocator
+ * @ingroup kernel-hal-cluster
+ *
+ * @brief Slab Allocator HAL Interface
+ */
+/**@{*/
+
+	#include <nanvix/const.h>
+
+	/**
+	 * @name Size Classes
+	 */
+	/**@{*/
+	#define SLAB_CLASSES    8                                       /**< Number of size classes. */
+	#define SLAB_OBJECT_MIN 16                                      /**< Smallest object size.   */
+	#define SLAB_OBJECT_MAX (SLAB_OBJECT_MIN << (SLAB_CLASSES - 1)) /**< Largest object size.    */
+	/**@}*/
+
+	/**
+	 * @brief Number of objects in a magazine.
+	 */
+	#define SLAB_MAGAZINE_SIZE 16
+
+	/**
+	 * @brief Statistics of a size class.
+	 */
+	struct slab_stats
+	{
+		size_t size;       /**< Object size (in bytes).    */
+		unsigned allocs;   /**< Allocations.               */
+		unsigned frees;    /**< Releases.                  */
+		unsigned misses;   /**< Trips to the shared slabs. */
+		unsigned failures; /**< Failed allocations.        */
+		unsigned slabs;    /**< Slabs held.                */
+		unsigned objects;  /**< Objects per slab.          */
+	};
+
+	/**
+	 * @brief Allocates an object.
+	 *
+	 * @param size Size of the object (in bytes).
+	 *
+	 * @returns Upon successful completion, a pointer to the allocated
+	 * object is returned. Upon failure, NULL is returned instead.
+	 */
+	EXTERN void *slab_alloc(size_t size);
+
+	/**
+	 * @brief Releases an object.
+	 *
+	 * @param obj Target object.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int slab_free(void *obj);
+
+	/**
+	 * @brief Gets the statistics of a size class.
+	 *
+	 * @param cls   Target size class.
+	 * @param stats Location to store the statistics.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int slab_stats_get(int cls, struct slab_stats *stats);
+
+#ifdef __NANVIX_HAL
+
+	/**
+	 * @brief Initializes the slab allocator.
+	 */
+	EXTERN void slab_setup(void);
+
+#endif /* __NANVIX_HAL */
+
+/**@}*/
+
+#endif /* NANVIX_HAL_CLUSTER_SLAB_H_ */
@@ -49,6 +49,11 @@
 	#ifndef __clock_read_fn
 	#error "clock_read() not defined?"
 	#endif
+	#ifdef __timer_stop_fn
+	#if !(CLUSTER_HAS_RTC)
+	#error "timer_stop() requires a real time clock"
+	#endif
+	#endif
 
 #endif
 
@@ -85,6 +90,18 @@
 	 */
 	EXTERN uint64_t clock_get_error(void);
 
+	/**
+	 * @brief Gets the number of timer ticks that a core skipped
+	 * while idle.
+	 *
+	 * @param coreid ID of the target core.
+	 * @param nticks Store location for the number of ticks.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int timer_ticks_avoided(int coreid, uint64_t *nticks);
+
 #ifdef __NANVIX_HAL
 
 	/**
@@ -92,6 +109,19 @@
 	 */
 	EXTERN void timer_reset(void);
 
+	/**
+	 * @brief Stops periodic ticks in the underlying core.
+	 *
+	 * If the timer device cannot be stopped, this function does
+	 * nothing.
+	 */
+	EXTERN void timer_tickless_enter(void);
+
+	/**
+	 * @brief Restores periodic ticks in the underlying core.
+	 */
+	EXTERN void timer_tickless_exit(void);
+
 #endif /* __NANVIX_HAL */
 
 	/**
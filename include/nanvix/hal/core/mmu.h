@@ -177,6 +177,9 @@
 	#error "mmu_page_map() not defined?"
 	#endif
 	#if (CORE_HAS_HUGE_PAGES)
+		#ifndef __pde_is_huge_fn
+		#error "pde_is_huge() not defined?"
+		#endif
 		#ifndef __mmu_huge_page_map_fn
 		#error "mmu_huge_page_map() not defined?"
 		#endif
@@ -234,7 +237,10 @@
 	/**
 	 * @brief Maps a huge page.
 	 *
-	 * @param pgtab Target page directory.
+	 * A huge page spans @ref PGTAB_SIZE bytes, and it is mapped
+	 * straight into a page directory entry.
+	 *
+	 * @param pgdir Target page directory.
 	 * @param paddr Physical address of the target huge page frame.
 	 * @param vaddr Virtual address of the target huge page.
 	 * @param w     Writable huge page?
@@ -245,6 +251,17 @@
 	 */
 	EXTERN int mmu_huge_page_map(struct pte *pgdir, paddr_t paddr, vaddr_t vaddr, int w, int x);
 
+	/**
+	 * @brief Unmaps a huge page.
+	 *
+	 * @param pgdir Target page directory.
+	 * @param vaddr Virtual address of the target huge page.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int mmu_huge_page_unmap(struct pte *pgdir, vaddr_t vaddr);
+
 	/**
 	 * @brief Maps a page table.
 	 *
@@ -257,6 +274,69 @@
 	 */
 	EXTERN int mmu_pgtab_map(struct pde *pgdir, paddr_t paddr, vaddr_t vaddr);
 
+	/**
+	 * @brief Unmaps a page.
+	 *
+	 * @param pgtab Target page table.
+	 * @param vaddr Virtual address of the target page.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int mmu_page_unmap(struct pte *pgtab, vaddr_t vaddr);
+
+	/**
+	 * @brief Maps a range of pages.
+	 *
+	 * Where the range spans a whole page table that is not in place,
+	 * and the core supports it, that part of the range is mapped with
+	 * a huge page. A huge page can only be unmapped as a whole, so
+	 * unmapping just some of its pages fails with -EFAULT.
+	 *
+	 * @param pgdir  Target page directory.
+	 * @param paddr  Physical address of the first page frame.
+	 * @param vaddr  Virtual address of the first page.
+	 * @param npages Number of pages.
+	 * @param w      Writable pages?
+	 * @param x      Executable pages?
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead, and no
+	 * page of the range is left mapped. If a page table that covers
+	 * the range is missing, -EFAULT is returned.
+	 */
+	EXTERN int mmu_map_range(struct pde *pgdir, paddr_t paddr, vaddr_t vaddr, size_t npages, int w, int x);
+
+	/**
+	 * @brief Unmaps a range of pages.
+	 *
+	 * @param pgdir  Target page directory.
+	 * @param vaddr  Virtual address of the first page.
+	 * @param npages Number of pages.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead. If the
+	 * range covers only part of a huge page, -EFAULT is returned.
+	 */
+	EXTERN int mmu_unmap_range(struct pde *pgdir, vaddr_t vaddr, size_t npages);
+
+	/**
+	 * @brief Enumerates the pages that map a page frame.
+	 *
+	 * Only mappings established with mmu_page_map(),
+	 * mmu_huge_page_map() and mmu_map_range() are known. Mappings
+	 * of all address spaces are enumerated.
+	 *
+	 * @param paddr  Physical address in the target page frame.
+	 * @param vaddrs Store location for virtual addresses.
+	 * @param n      Capacity of @p vaddrs.
+	 *
+	 * @returns Upon successful completion, the number of pages that
+	 * map the target page frame is returned. This number may exceed
+	 * @p n. Upon failure, a negative error code is returned instead.
+	 */
+	EXTERN int mmu_page_mappings(paddr_t paddr, vaddr_t *vaddrs, int n);
+
 	/**
 	 * @brief Searches for a page belonging to a 
 	 * given physical address.
@@ -61,6 +61,9 @@
 	#include <nanvix/hal/target/sync.h>
 	#include <nanvix/hal/target/mailbox.h>
 	#include <nanvix/hal/target/portal.h>
+	#include <nanvix/hal/target/barrier.h>
+	#include <nanvix/hal/target/collective.h>
+	#include <nanvix/hal/target/rpc.h>
 
 	/**
 	 * @name Functions to wait/wakeup for a comm resource.
@@ -0,0 +1,96 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NANVIX_HAL_TARGET_BARRIER_H_
+#define NANVIX_HAL_TARGET_BARRIER_H_
+
+	/* Target Interface Implementation */
+	#include <nanvix/hal/target/_target.h>
+
+/*============================================================================*
+ * Provided Interface                                                         *
+ *============================================================================*/
+
+/**
+ * @defgroup kernel-hal-target-barrier Hierarchical Barrier
+ * @ingroup kernel-hal-target
+ *
+ * @brief Hierarchical Barrier HAL Interface
+ *
+ * A hierarchical barrier synchronizes a group of cores in each one
+ * of a group of NoC nodes. Cores first combine locally, through
+ * shared memory. The last core to arrive in a cluster then
+ * synchronizes with the other clusters, using a pair of
+ * synchronization points, and releases the local cores afterwards.
+ */
+/**@{*/
+
+	#include <nanvix/const.h>
+	#include <nanvix/hlib.h>
+	#include <posix/errno.h>
+
+	/**
+	 * @brief Maximum number of hierarchical barriers.
+	 */
+	#define HAL_BARRIER_MAX 4
+
+	/**
+	 * @brief Creates a hierarchical barrier.
+	 *
+	 * @param nodes  IDs of target NoC nodes.
+	 * @param nnodes Number of target NoC nodes.
+	 * @param ncores Number of local cores that take part in the barrier.
+	 *
+	 * @returns Upon successful completion, the ID of the newly created
+	 * barrier is returned. Upon failure, a negative error code is
+	 * returned instead.
+	 *
+	 * @note The first node in @p nodes is the leader of the barrier.
+	 * @note If @p nnodes equals to one, the barrier is local.
+	 */
+	EXTERN int barrier_create(const int *nodes, int nnodes, int ncores);
+
+	/**
+	 * @brief Destroys a hierarchical barrier.
+	 *
+	 * @param barrierid ID of the target barrier.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int barrier_destroy(int barrierid);
+
+	/**
+	 * @brief Waits on a hierarchical barrier.
+	 *
+	 * @param barrierid ID of the target barrier.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int barrier_wait(int barrierid);
+
+/**@}*/
+
+#endif /* NANVIX_HAL_TARGET_BARRIER_H_ */
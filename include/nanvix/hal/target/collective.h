@@ -0,0 +1,213 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NANVIX_HAL_TARGET_COLLECTIVE_H_
+#define NANVIX_HAL_TARGET_COLLECTIVE_H_
+
+	/* Target Interface Implementation */
+	#include <nanvix/hal/target/_target.h>
+	#include <nanvix/hal/target/portal.h>
+
+/*============================================================================*
+ * Provided Interface                                                         *
+ *============================================================================*/
+
+/**
+ * @defgroup kernel-hal-target-collective Collective Communication
+ * @ingroup kernel-hal-target
+ *
+ * @brief Collective Communication HAL Interface
+ *
+ * A collective groups a set of NoC nodes, which are addressed by
+ * their rank, i.e. their position in the list of nodes given at
+ * creation. Data is moved over portals, in segments of at most
+ * @ref HAL_COLLECTIVE_SEGMENT_SIZE bytes. Broadcast and reduction
+ * operations follow a binomial tree rooted at the requested rank.
+ * The pipelined broadcast forwards segments along a ring instead,
+ * thus different ranks work on different segments at the same time.
+ *
+ * Collectives take over the input portal of the local node while at
+ * least one of them exists, thus no other user may create it in the
+ * meantime. Operations on all collectives of a node are serialized.
+ */
+/**@{*/
+
+	#include <nanvix/const.h>
+	#include <posix/stddef.h>
+
+	/**
+	 * @brief Maximum number of collectives.
+	 */
+	#define HAL_COLLECTIVE_MAX 4
+
+	/**
+	 * @brief Size of a segment (in bytes).
+	 */
+	#define HAL_COLLECTIVE_SEGMENT_SIZE HAL_PORTAL_MAX_SIZE
+
+	/**
+	 * @brief Combine function of reductions.
+	 *
+	 * @param inout  Accumulated elements, updated in place.
+	 * @param in     Elements to combine.
+	 * @param nelems Number of elements.
+	 */
+	typedef void (*collective_combine_fn)(void *inout, const void *in, size_t nelems);
+
+	/**
+	 * @brief Creates a collective.
+	 *
+	 * @param nodes  IDs of target NoC nodes.
+	 * @param nnodes Number of target NoC nodes.
+	 *
+	 * @returns Upon successful completion, the ID of the newly created
+	 * collective is returned. Upon failure, a negative error code is
+	 * returned instead.
+	 *
+	 * @note The local node must be listed in @p nodes.
+	 */
+	EXTERN int collective_create(const int *nodes, int nnodes);
+
+	/**
+	 * @brief Destroys a collective.
+	 *
+	 * @param collid ID of the target collective.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int collective_destroy(int collid);
+
+	/**
+	 * @brief Broadcasts a buffer.
+	 *
+	 * @param collid ID of the target collective.
+	 * @param root   Rank of the root.
+	 * @param buffer Buffer to send (root) or receive (others).
+	 * @param size   Size of the buffer.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int collective_broadcast(int collid, int root, void *buffer, size_t size);
+
+	/**
+	 * @brief Broadcasts a buffer, pipelining segments along a ring.
+	 *
+	 * @param collid ID of the target collective.
+	 * @param root   Rank of the root.
+	 * @param buffer Buffer to send (root) or receive (others).
+	 * @param size   Size of the buffer.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 *
+	 * @note This variant pays off for buffers that span many segments.
+	 */
+	EXTERN int collective_broadcast_pipelined(int collid, int root, void *buffer, size_t size);
+
+	/**
+	 * @brief Scatters a buffer.
+	 *
+	 * @param collid  ID of the target collective.
+	 * @param root    Rank of the root.
+	 * @param sendbuf Buffer with one block per rank (root only).
+	 * @param recvbuf Buffer where the local block should be stored.
+	 * @param size    Size of a block.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int collective_scatter(int collid, int root, const void *sendbuf, void *recvbuf, size_t size);
+
+	/**
+	 * @brief Gathers a buffer.
+	 *
+	 * @param collid  ID of the target collective.
+	 * @param root    Rank of the root.
+	 * @param sendbuf Block of the local rank.
+	 * @param recvbuf Buffer where one block per rank should be stored (root only).
+	 * @param size    Size of a block.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int collective_gather(int collid, int root, const void *sendbuf, void *recvbuf, size_t size);
+
+	/**
+	 * @brief Reduces a buffer.
+	 *
+	 * @param collid  ID of the target collective.
+	 * @param root    Rank of the root.
+	 * @param sendbuf Elements of the local rank.
+	 * @param recvbuf Buffer where the result should be stored.
+	 * @param nelems  Number of elements.
+	 * @param elsize  Size of an element.
+	 * @param combine Combine function.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 *
+	 * @note On non-root ranks, @p recvbuf is used as scratch space.
+	 * @note @p combine should be associative and commutative, since
+	 * partial results are combined in the order of ranks relative to
+	 * @p root rather than in the order of ranks.
+	 */
+	EXTERN int collective_reduce(
+		int collid,
+		int root,
+		const void *sendbuf,
+		void *recvbuf,
+		size_t nelems,
+		size_t elsize,
+		collective_combine_fn combine
+	);
+
+	/**
+	 * @brief Reduces a buffer and broadcasts the result.
+	 *
+	 * @param collid  ID of the target collective.
+	 * @param sendbuf Elements of the local rank.
+	 * @param recvbuf Buffer where the result should be stored.
+	 * @param nelems  Number of elements.
+	 * @param elsize  Size of an element.
+	 * @param combine Combine function.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 *
+	 * @note @p combine should be associative and commutative.
+	 */
+	EXTERN int collective_allreduce(
+		int collid,
+		const void *sendbuf,
+		void *recvbuf,
+		size_t nelems,
+		size_t elsize,
+		collective_combine_fn combine
+	);
+
+/**@}*/
+
+#endif /* NANVIX_HAL_TARGET_COLLECTIVE_H_ */
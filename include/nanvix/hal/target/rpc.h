@@ -0,0 +1,198 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NANVIX_HAL_TARGET_RPC_H_
+#define NANVIX_HAL_TARGET_RPC_H_
+
+	/* Target Interface Implementation */
+	#include <nanvix/hal/target/_target.h>
+	#include <nanvix/hal/target/mailbox.h>
+
+/*============================================================================*
+ * Provided Interface                                                         *
+ *============================================================================*/
+
+/**
+ * @defgroup kernel-hal-target-rpc Remote Procedure Calls
+ * @ingroup kernel-hal-target
+ *
+ * @brief Remote Procedure Call HAL Interface
+ *
+ * Requests and replies travel in mailbox messages. The reserved
+ * header of each message carries the ID of the request, which is
+ * echoed back in the reply, thus a client may have several requests
+ * outstanding and replies may arrive in any order. Requests that are
+ * received while a client waits for its replies are queued for the
+ * local server.
+ *
+ * The RPC facility takes over the input mailbox of the local node,
+ * which is unique. While it is set up, no other user may create that
+ * mailbox, and every message that arrives in it is taken as an RPC
+ * message.
+ */
+/**@{*/
+
+	#include <nanvix/const.h>
+	#include <posix/stddef.h>
+
+	/**
+	 * @brief Maximum size of arguments and return values (in bytes).
+	 */
+	#define HAL_RPC_DATA_SIZE HAL_MAILBOX_DATA_SIZE
+
+	/**
+	 * @brief Maximum number of outstanding requests issued by a node.
+	 */
+	#define HAL_RPC_OUTSTANDING_MAX 16
+
+	/**
+	 * @brief Maximum number of pending requests received by a node.
+	 */
+	#define HAL_RPC_PENDING_MAX 16
+
+	/**
+	 * @brief Received request.
+	 */
+	struct rpc_request
+	{
+		int source;  /**< NoC node of the client. */
+		int reqid;   /**< ID of the request.      */
+		int opcode;  /**< Operation code.         */
+		size_t size; /**< Size of the arguments.  */
+	};
+
+	/**
+	 * @brief Sets up the RPC facility.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 *
+	 * @note The RPC facility owns the input mailbox of the local node.
+	 */
+	EXTERN int rpc_setup(void);
+
+	/**
+	 * @brief Shuts down the RPC facility.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int rpc_shutdown(void);
+
+	/**
+	 * @brief Issues a request.
+	 *
+	 * @param remote NoC node of the server.
+	 * @param opcode Operation code.
+	 * @param args   Arguments.
+	 * @param size   Size of the arguments.
+	 *
+	 * @returns Upon successful completion, a handle to the outstanding
+	 * request is returned. Upon failure, a negative error code is
+	 * returned instead.
+	 *
+	 * @note This function does not wait for the reply.
+	 */
+	EXTERN int rpc_call(int remote, int opcode, const void *args, size_t size);
+
+	/**
+	 * @brief Checks whether a request has completed.
+	 *
+	 * @param handle Handle to the target request.
+	 *
+	 * @returns One if the reply has arrived, zero if it has not, and a
+	 * negative error code upon failure.
+	 *
+	 * @note This function is non-blocking.
+	 */
+	EXTERN int rpc_test(int handle);
+
+	/**
+	 * @brief Waits for the reply of a request and releases it.
+	 *
+	 * @param handle Handle to the target request.
+	 * @param ret    Buffer where the return value should be stored.
+	 * @param size   Size of the buffer.
+	 *
+	 * @returns Upon successful completion, the size of the return value
+	 * is returned. If the server failed the request, its error code is
+	 * returned. Upon failure, a negative error code is returned instead.
+	 */
+	EXTERN ssize_t rpc_wait(int handle, void *ret, size_t size);
+
+	/**
+	 * @brief Waits until any of a set of requests completes.
+	 *
+	 * @param handles Handles to the target requests.
+	 * @param n       Number of handles.
+	 *
+	 * @returns Upon successful completion, the handle of a completed
+	 * request is returned. Upon failure, a negative error code is
+	 * returned instead.
+	 *
+	 * @note The completed request is not released.
+	 */
+	EXTERN int rpc_wait_any(const int *handles, int n);
+
+	/**
+	 * @brief Waits until all requests in a set complete.
+	 *
+	 * @param handles Handles to the target requests.
+	 * @param n       Number of handles.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 *
+	 * @note Completed requests are not released.
+	 */
+	EXTERN int rpc_wait_all(const int *handles, int n);
+
+	/**
+	 * @brief Receives a request.
+	 *
+	 * @param req  Place where the request should be stored.
+	 * @param args Buffer where the arguments should be stored.
+	 * @param size Size of the buffer.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int rpc_serve(struct rpc_request *req, void *args, size_t size);
+
+	/**
+	 * @brief Replies to a request.
+	 *
+	 * @param req    Target request.
+	 * @param status Status of the request.
+	 * @param ret    Return value.
+	 * @param size   Size of the return value.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int rpc_reply(const struct rpc_request *req, int status, const void *ret, size_t size);
+
+/**@}*/
+
+#endif /* NANVIX_HAL_TARGET_RPC_H_ */
@@ -64,6 +64,9 @@
 		#ifndef SYNC_IOCTL_SET_ASYNC_BEHAVIOR
 		#error "SYNC_IOCTL_SET_ASYNC_BEHAVIOR not defined"
 		#endif
+		#ifndef SYNC_IOCTL_SET_COUNTING_MODE
+		#error "SYNC_IOCTL_SET_COUNTING_MODE not defined"
+		#endif
 
 		/* Functions */
 		#ifndef __sync_setup_fn
@@ -105,6 +108,7 @@
 	#define SYNC_OPEN_MAX                 1
 	#define SYNC_OPEN_OFFSET              SYNC_CREATE_MAX
 	#define SYNC_IOCTL_SET_ASYNC_BEHAVIOR 0
+	#define SYNC_IOCTL_SET_COUNTING_MODE  1
 
 #endif /* !__TARGET_HAS_SYNC */
 
@@ -172,6 +176,33 @@
 	 */
 	EXTERN int sync_wait(int syncid);
 
+	/**
+	 * @brief Waits for several signals on a synchronization point.
+	 *
+	 * @param syncid   ID of the Target Sync.
+	 * @param nsignals Number of signals to consume.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 *
+	 * @note In counting mode each signal is consumed individually,
+	 * otherwise @p nsignals complete barriers are consumed.
+	 */
+	EXTERN int sync_wait_n(int syncid, int nsignals);
+
+	/**
+	 * @brief Gets the number of pending signals on a synchronization point.
+	 *
+	 * @param syncid ID of the Target Sync.
+	 *
+	 * @returns Upon successful completion, the number of signals that
+	 * may be consumed without blocking is returned. Upon failure, a
+	 * negative error code is returned instead.
+	 *
+	 * @note This function is non-blocking.
+	 */
+	EXTERN int sync_npending(int syncid);
+
 	/**
 	 * @brief Send signal on a specific synchronization point.
 	 *
@@ -47,23 +47,23 @@ EXTERN NORETURN void kmain(int, const char *[]);
  * @brief Cores table.
  */
 PUBLIC struct coreinfo ALIGN(K1B_CACHE_LINE_SIZE) cores[K1B_CLUSTER_NUM_CORES] = {
-	{ true,  CORE_RUNNING,   0, NULL, K1B_SPINLOCK_UNLOCKED }, /* Master Core   */
-	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED   }, /* Slave Core 1  */
-	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED   }, /* Slave Core 2  */
-	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED   }, /* Slave Core 3  */
+	{ true,  CORE_RUNNING,   0, NULL, K1B_SPINLOCK_UNLOCKED, -1 }, /* Master Core   */
+	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED,   -1 }, /* Slave Core 1  */
+	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED,   -1 }, /* Slave Core 2  */
+	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED,   -1 }, /* Slave Core 3  */
 #if defined(__node__)
-	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED   }, /* Slave Core 4  */
-	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED   }, /* Slave Core 5  */
-	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED   }, /* Slave Core 6  */
-	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED   }, /* Slave Core 7  */
-	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED   }, /* Slave Core 8  */
-	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED   }, /* Slave Core 9  */
-	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED   }, /* Slave Core 10 */
-	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED   }, /* Slave Core 11 */
-	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED   }, /* Slave Core 12 */
-	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED   }, /* Slave Core 13 */
-	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED   }, /* Slave Core 14 */
-	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED   }, /* Slave Core 15 */
+	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED,   -1 }, /* Slave Core 4  */
+	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED,   -1 }, /* Slave Core 5  */
+	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED,   -1 }, /* Slave Core 6  */
+	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED,   -1 }, /* Slave Core 7  */
+	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED,   -1 }, /* Slave Core 8  */
+	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED,   -1 }, /* Slave Core 9  */
+	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED,   -1 }, /* Slave Core 10 */
+	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED,   -1 }, /* Slave Core 11 */
+	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED,   -1 }, /* Slave Core 12 */
+	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED,   -1 }, /* Slave Core 13 */
+	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED,   -1 }, /* Slave Core 14 */
+	{ false, CORE_RESETTING, 0, NULL, K1B_SPINLOCK_LOCKED,   -1 }, /* Slave Core 15 */
 #endif
 };
 
@@ -369,7 +369,10 @@ PUBLIC int k1b_cluster_tlb_shootdown(vaddr_t vaddr)
 
 	/* Shootdown software TLBs. */
 	for (int i = 0; i < K1B_CLUSTER_NUM_CORES; i++)
+	{
 		kmemcpy(&k1b_tlb[i].jtlb[idx], &tlbe, K1B_TLBE_SIZE);
+		tlb_index_invalidate(i);
+	}
 
 	return (0);
 }
@@ -425,6 +428,8 @@ PUBLIC void k1b_cluster_mem_warmup(void)
 	start = 0; end = MEMORY_SIZE;
 	for (vaddr_t vaddr = start; vaddr < end; vaddr += K1B_PAGE_SIZE)
 		k1b_cluster_tlb_inval(vaddr, K1B_PAGE_SHIFT, 0);
+
+	tlb_index_invalidate(k1b_core_get_id());
 }
 
 /*============================================================================*
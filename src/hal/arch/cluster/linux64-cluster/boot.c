@@ -32,32 +32,48 @@
 /**
  * @brief Lookup table for thread IDs.
  */
-PUBLIC pthread_t linux64_cores_tab[LINUX64_CLUSTER_NUM_CORES];
+PUBLIC pthread_t linux64_cores_tab[LINUX64_CLUSTER_NUM_CORES_MAX];
+
+/**
+ * @brief Number of cores powered on.
+ */
+PUBLIC int linux64_cluster_ncores = LINUX64_CLUSTER_NUM_CORES;
 
 /**
  * @brief Entry point for slave core.
  */
 PRIVATE void *linux64_do_slave(void *args)
 {
-	UNUSED(args);
+	linux64_core_context_setup((int)(intptr_t) args);
+	linux64_cluster_topology_bind_core();
 	linux64_cluster_setup();
 }
 
 /**
  * @todo TODO: provide a detailed description for this function.
  */
-PUBLIC int linux64_cluster_boot(void)
+PUBLIC int linux64_cluster_boot(int ncores)
 {
-	kprintf("[hal][cluster] powering on cluster...");
+	/* Invalid number of cores. */
+	if (!WITHIN(ncores, 1, LINUX64_CLUSTER_NUM_CORES_MAX + 1))
+		return (-EINVAL);
+
+	linux64_cluster_ncores = ncores;
+
+	kprintf("[hal][cluster] powering on cluster with %d cores...", ncores);
 
 	linux64_cluster_memory_boot();
+	linux64_cluster_timer_boot();
 
 	/* Save ID of master core. */
 	linux64_cores_tab[0] = pthread_self();
+	linux64_core_context_setup(LINUX64_CLUSTER_COREID_MASTER);
+	linux64_cluster_topology_bind_core();
+	linux64_cluster_topology_dump();
 
-	for (int i = 1; i < LINUX64_CLUSTER_NUM_CORES; i++)
+	for (int i = 1; i < linux64_cluster_ncores; i++)
 	{
-		if (pthread_create(&linux64_cores_tab[i], NULL, linux64_do_slave, NULL))
+		if (pthread_create(&linux64_cores_tab[i], NULL, linux64_do_slave, (void *)(intptr_t) i))
 			return (-EINVAL);
 	}
 
@@ -37,17 +37,17 @@ EXTERN NORETURN void kmain(int, const char *[]);
 /**
  * @brief Cores table.
  */
-PUBLIC struct coreinfo cores[LINUX64_CLUSTER_NUM_CORES] = {
-	{ true,  CORE_RUNNING,   0, NULL, LINUX64_SPINLOCK_UNLOCKED }, /* Master Core   */
-	{ false, CORE_RESETTING, 0, NULL, LINUX64_SPINLOCK_UNLOCKED }, /* Slave Core 1  */
-	{ false, CORE_RESETTING, 0, NULL, LINUX64_SPINLOCK_UNLOCKED }, /* Slave Core 2  */
-	{ false, CORE_RESETTING, 0, NULL, LINUX64_SPINLOCK_UNLOCKED }, /* Slave Core 3  */
+PUBLIC struct coreinfo cores[LINUX64_CLUSTER_NUM_CORES_MAX] = {
+	[0] =
+		{ true,  CORE_RUNNING,   0, NULL, LINUX64_SPINLOCK_UNLOCKED, -1 }, /* Master Core */
+	[1 ... (LINUX64_CLUSTER_NUM_CORES_MAX - 1)] =
+		{ false, CORE_RESETTING, 0, NULL, LINUX64_SPINLOCK_UNLOCKED, -1 }, /* Slave Cores */
 };
 
 /**
  * @brief Reset buffers
  */
-PRIVATE jmp_buf reset_buffers[LINUX64_CLUSTER_NUM_CORES];
+PRIVATE jmp_buf reset_buffers[LINUX64_CLUSTER_NUM_CORES_MAX];
 
 /**
  * @todo TODO: provide a detailed description for this function.
@@ -59,6 +59,7 @@ PRIVATE NORETURN void linux64_cluster_slave_setup(void)
 	cluster_fence_wait();
 
 	linux64_core_setup();
+	linux64_cluster_ipi_setup();
 
 	coreid = linux64_core_get_id();
 
@@ -91,11 +92,12 @@ PRIVATE NORETURN void linux64_cluster_master_setup(void)
 {
 	kprintf("[hal][cluster] initializing cluster...");
 
-	for (int i = 1; i < LINUX64_CLUSTER_NUM_CORES; i++)
+	for (int i = 1; i < linux64_cluster_ncores; i++)
 		linux64_spinlock_lock(&cores[i].lock);
 
 	mem_setup();
 	linux64_core_setup();
+	linux64_cluster_ipi_setup();
 
 	cluster_fence_release();
 	kmain(0, NULL);
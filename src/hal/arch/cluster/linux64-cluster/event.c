@@ -0,0 +1,117 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __NEED_HAL_CLUSTER
+
+#include <nanvix/hal/cluster.h>
+#include <nanvix/const.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * @name Event States
+ */
+/**@{*/
+#define LINUX64_CLUSTER_EVENT_NONE     0 /**< No event.              */
+#define LINUX64_CLUSTER_EVENT_PENDING  1 /**< Event pending.         */
+#define LINUX64_CLUSTER_EVENT_SLEEPING 2 /**< Core asleep in futex.  */
+/**@}*/
+
+/**
+ * @brief Futex words of the cores.
+ */
+PRIVATE struct
+{
+	uint32_t state; /**< Event state. */
+} ALIGN(CACHE_LINE_SIZE) events[LINUX64_CLUSTER_NUM_CORES_MAX];
+
+/*============================================================================*
+ * linux64_cluster_event_notify()                                             *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_event_notify() function marks an event as
+ * pending in the core @p coreid. The host kernel is entered only if
+ * the target core is asleep.
+ */
+PUBLIC int linux64_cluster_event_notify(int coreid)
+{
+	int mycoreid;
+
+	/* Invalid core. */
+	if (UNLIKELY(!WITHIN(coreid, 0, linux64_cluster_ncores)))
+		return (-EINVAL);
+
+	mycoreid = linux64_core_get_id();
+
+	/* Bad core. */
+	if (UNLIKELY(coreid == mycoreid))
+		return (-EINVAL);
+
+	if (__atomic_exchange_n(&events[coreid].state, LINUX64_CLUSTER_EVENT_PENDING, __ATOMIC_RELEASE)
+			== LINUX64_CLUSTER_EVENT_SLEEPING)
+	{
+		syscall(SYS_futex, &events[coreid].state, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * linux64_cluster_event_wait()                                               *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_event_wait() function consumes a pending event
+ * of the calling core, or sleeps on its futex word until one is
+ * posted.
+ */
+PUBLIC void linux64_cluster_event_wait(void)
+{
+	int mycoreid;
+	uint32_t expected;
+
+	mycoreid = linux64_core_get_id();
+
+	while (true)
+	{
+		/* Consume pending event. */
+		if (__atomic_exchange_n(&events[mycoreid].state, LINUX64_CLUSTER_EVENT_NONE, __ATOMIC_ACQUIRE)
+				== LINUX64_CLUSTER_EVENT_PENDING)
+			break;
+
+		/* Announce that we are going to sleep. */
+		expected = LINUX64_CLUSTER_EVENT_NONE;
+		if (!__atomic_compare_exchange_n(&events[mycoreid].state, &expected,
+				LINUX64_CLUSTER_EVENT_SLEEPING, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+			continue;
+
+		/* Returns at once if an event was posted meanwhile. */
+		syscall(SYS_futex, &events[mycoreid].state, FUTEX_WAIT_PRIVATE,
+			LINUX64_CLUSTER_EVENT_SLEEPING, NULL, NULL, 0
+		);
+	}
+}
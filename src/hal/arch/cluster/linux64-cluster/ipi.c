@@ -0,0 +1,113 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __NEED_HAL_CLUSTER
+
+#include <nanvix/hal/cluster.h>
+#include <nanvix/const.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * @brief IPI lines of the cores.
+ */
+PRIVATE struct
+{
+	pid_t tid;        /**< Host thread of the core. */
+	uint32_t pending; /**< IPI not acknowledged?    */
+} ALIGN(CACHE_LINE_SIZE) ipis[LINUX64_CLUSTER_NUM_CORES_MAX];
+
+/*============================================================================*
+ * linux64_cluster_ipi_setup()                                                *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_ipi_setup() function records the host thread
+ * that backs the underlying core, so that IPIs can be directed to it.
+ */
+PUBLIC void linux64_cluster_ipi_setup(void)
+{
+	int mycoreid;
+
+	/* The IPI signal must be a real-time one. */
+	KASSERT(WITHIN(LINUX64_INT_IPI, SIGRTMIN, SIGRTMAX + 1));
+
+	mycoreid = linux64_core_get_id();
+
+	ipis[mycoreid].tid = syscall(SYS_gettid);
+	__atomic_store_n(&ipis[mycoreid].pending, 0, __ATOMIC_RELEASE);
+}
+
+/*============================================================================*
+ * linux64_cluster_ipi_send()                                                 *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_ipi_send() function raises the IPI line of the
+ * core @p coreid. As in hardware, raising a line that is still
+ * pending has no further effect, so IPIs coalesce until the target
+ * core acknowledges them.
+ */
+PUBLIC void linux64_cluster_ipi_send(int coreid)
+{
+	/* Invalid core. */
+	if (UNLIKELY(!WITHIN(coreid, 0, linux64_cluster_ncores)))
+		return;
+
+	/* Interrupt the target core. */
+	if (__atomic_exchange_n(&ipis[coreid].pending, 1, __ATOMIC_ACQ_REL) == 0)
+		syscall(SYS_tgkill, getpid(), ipis[coreid].tid, LINUX64_INT_IPI);
+
+	/* Wakeup the target core, in case it has IPIs masked. */
+	linux64_cluster_event_notify(coreid);
+}
+
+/*============================================================================*
+ * linux64_cluster_ipi_ack()                                                  *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_ipi_ack() function lowers the IPI line of the
+ * underlying core.
+ */
+PUBLIC void linux64_cluster_ipi_ack(void)
+{
+	__atomic_store_n(&ipis[linux64_core_get_id()].pending, 0, __ATOMIC_RELEASE);
+}
+
+/*============================================================================*
+ * linux64_cluster_ipi_wait()                                                 *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_ipi_wait() function puts the underlying core to
+ * sleep until an IPI is sent to it. An IPI that was sent after the
+ * last wait makes this function return at once, even if it was
+ * already handled.
+ */
+PUBLIC void linux64_cluster_ipi_wait(void)
+{
+	linux64_cluster_event_wait();
+}
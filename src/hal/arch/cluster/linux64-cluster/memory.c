@@ -25,7 +25,15 @@
 #include <nanvix/hal/cluster/memory.h>
 #include <arch/cluster/linux64-cluster/cores.h>
 #include <arch/cluster/linux64-cluster/memory.h>
-#include <stdlib.h>
+#include <arch/cluster/linux64-cluster/topology.h>
+#include <nanvix/hlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdio.h>
+#include <unistd.h>
 
 PRIVATE void *linux64_user_base_virt_ptr;
 PRIVATE void *linux64_ustack_base_virt_ptr;
@@ -58,26 +66,905 @@ PUBLIC unsigned char __DATA_END   = 0;
 PUBLIC unsigned char __BSS_START  = 0;
 PUBLIC unsigned char __BSS_END    = 0;
 
+/**
+ * @name Memory Sizes
+ */
+/**@{*/
+PUBLIC size_t linux64_kmem_size  = LINUX64_KMEM_SIZE_DEFAULT;
+PUBLIC size_t linux64_kpool_size = LINUX64_KPOOL_SIZE_DEFAULT;
+PUBLIC size_t linux64_umem_size  = LINUX64_UMEM_SIZE_DEFAULT;
+/**@}*/
+
 /**
  * @brief Memory layout.
  */
 PUBLIC struct memory_region mem_layout[LINUX64_CLUSTER_MEM_REGIONS];
 
 /**
- * @ brief counter for the flush function
+ * @brief Memory configuration.
+ */
+PRIVATE struct
+{
+	int hugepages; /**< Huge page backing. */
+	bool booted;   /**< Powered on?        */
+} linux64_cluster_mem = {
+	.hugepages = LINUX64_CLUSTER_HUGEPAGES_NONE,
+	.booted    = false,
+};
+
+/*============================================================================*
+ * Emulated MMU                                                               *
+ *============================================================================*/
+
+/**
+ * @brief Memory regions backed by the emulated MMU.
+ *
+ * Each region is mapped twice. The virtual view is protected according
+ * to the contents of the TLB, while the physical view is always
+ * accessible and is used for walking page tables.
+ */
+PRIVATE struct
+{
+	vaddr_t base; /**< Base address of the virtual view. */
+	size_t size;  /**< Size (in bytes).                  */
+	char *phys;   /**< Physical view.                    */
+} linux64_cluster_mmu_regions[LINUX64_CLUSTER_MMU_REGIONS];
+
+/**
+ * @brief Number of memory regions backed by the emulated MMU.
+ */
+PRIVATE int linux64_cluster_mmu_nregions = 0;
+
+/**
+ * @brief Emulated TLB.
+ *
+ * Host protections are process-wide, thus a single TLB is shared by
+ * all cores of the cluster. Hits are not observable, so replacement
+ * policies rely only on the order of misses.
+ */
+PRIVATE struct
+{
+	int mode;                  /**< MMU mode.                 */
+	int length;                /**< Number of entries.        */
+	int policy;                /**< Replacement policy.       */
+	int next;                  /**< Next FIFO victim.         */
+	unsigned seed;             /**< Random victim generator.  */
+	linux64_spinlock_t lock;   /**< Lock.                     */
+
+	/**
+	 * @brief Entries.
+	 */
+	struct
+	{
+		vaddr_t vaddr;         /**< Base address.             */
+		size_t size;           /**< Size (zero if invalid).   */
+		bool writable;         /**< Writable?                 */
+	} entries[LINUX64_CLUSTER_TLB_LENGTH_MAX];
+} linux64_cluster_tlb = {
+	.mode   = LINUX64_CLUSTER_MMU_COSMETIC,
+	.length = LINUX64_CLUSTER_TLB_LENGTH,
+	.policy = LINUX64_CLUSTER_TLB_FIFO,
+	.next   = 0,
+	.seed   = 1,
+	.lock   = LINUX64_SPINLOCK_UNLOCKED,
+};
+
+/**
+ * @brief TLB statistics.
+ */
+PRIVATE struct linux64_cluster_tlb_stats linux64_cluster_tlb_stats[LINUX64_CLUSTER_NUM_CORES_MAX];
+
+/**
+ * @brief Last address that missed on each core.
+ *
+ * A miss on a read-only entry that is already in the TLB is either a
+ * race with another core or a protection fault. It is the latter only
+ * if the same core faults twice in a row on the same address.
+ */
+PRIVATE vaddr_t linux64_cluster_tlb_last[LINUX64_CLUSTER_NUM_CORES_MAX];
+
+/**
+ * @brief Locks the emulated TLB.
+ *
+ * @param oldset Store location for the previous signal mask.
+ *
+ * Signals are blocked while the lock is held, because an interrupt
+ * handler that touches emulated memory would otherwise deadlock.
+ */
+PRIVATE void linux64_cluster_tlb_lock(sigset_t *oldset)
+{
+	sigset_t set;
+
+	sigfillset(&set);
+	pthread_sigmask(SIG_BLOCK, &set, oldset);
+	linux64_spinlock_lock(&linux64_cluster_tlb.lock);
+}
+
+/**
+ * @brief Unlocks the emulated TLB.
+ *
+ * @param oldset Signal mask to restore.
+ */
+PRIVATE void linux64_cluster_tlb_unlock(const sigset_t *oldset)
+{
+	linux64_spinlock_unlock(&linux64_cluster_tlb.lock);
+	pthread_sigmask(SIG_SETMASK, oldset, NULL);
+}
+
+/**
+ * @brief Looks up the emulated memory region of an address.
+ *
+ * @param vaddr Target address.
+ *
+ * @returns The index of the region where @p vaddr lies, or a negative
+ * number if it does not lie in emulated memory.
+ */
+PRIVATE int linux64_cluster_mmu_region_lookup(vaddr_t vaddr)
+{
+	for (int i = 0; i < linux64_cluster_mmu_nregions; i++)
+	{
+		if (WITHIN(vaddr, linux64_cluster_mmu_regions[i].base,
+				linux64_cluster_mmu_regions[i].base + linux64_cluster_mmu_regions[i].size))
+			return (i);
+	}
+
+	return (-1);
+}
+
+/**
+ * @brief Translates a physical address into the physical view.
+ *
+ * @param paddr Target physical address.
+ *
+ * @returns A pointer through which @p paddr may always be accessed.
+ */
+PRIVATE void *linux64_cluster_mmu_phys(paddr_t paddr)
+{
+	int i;
+
+	if ((i = linux64_cluster_mmu_region_lookup(paddr)) < 0)
+		return ((void *) paddr);
+
+	return (&linux64_cluster_mmu_regions[i].phys[paddr - linux64_cluster_mmu_regions[i].base]);
+}
+
+/**
+ * @brief Registers a memory region in the emulated MMU.
+ *
+ * @param base Base address of the virtual view.
+ * @param phys Physical view.
+ * @param size Size of the region (in bytes).
+ */
+PRIVATE void linux64_cluster_mmu_region_add(char *base, char *phys, size_t size)
+{
+	KASSERT(linux64_cluster_mmu_nregions < LINUX64_CLUSTER_MMU_REGIONS);
+
+	linux64_cluster_mmu_regions[linux64_cluster_mmu_nregions].base = (vaddr_t) base;
+	linux64_cluster_mmu_regions[linux64_cluster_mmu_nregions].size = size;
+	linux64_cluster_mmu_regions[linux64_cluster_mmu_nregions].phys = phys;
+	linux64_cluster_mmu_nregions++;
+}
+
+/**
+ * @brief Evicts an entry from the emulated TLB.
+ *
+ * @param idx Index of the target entry.
+ */
+PRIVATE void linux64_cluster_tlb_evict(int idx)
+{
+	if (linux64_cluster_tlb.entries[idx].size == 0)
+		return;
+
+	KASSERT(mprotect((void *) linux64_cluster_tlb.entries[idx].vaddr,
+		linux64_cluster_tlb.entries[idx].size, PROT_NONE) == 0);
+
+	linux64_cluster_tlb.entries[idx].size = 0;
+}
+
+/**
+ * @brief Looks up the emulated TLB.
+ *
+ * @param vaddr Target address.
+ *
+ * @returns The index of the entry that maps @p vaddr, or a negative
+ * number if there is no such entry.
  */
-PRIVATE unsigned linux64_cluster_tlb_flush_count[LINUX64_CLUSTER_NUM_CORES];
+PRIVATE int linux64_cluster_tlb_lookup(vaddr_t vaddr)
+{
+	for (int i = 0; i < linux64_cluster_tlb.length; i++)
+	{
+		if (linux64_cluster_tlb.entries[i].size == 0)
+			continue;
+
+		if (WITHIN(vaddr, linux64_cluster_tlb.entries[i].vaddr,
+				linux64_cluster_tlb.entries[i].vaddr + linux64_cluster_tlb.entries[i].size))
+			return (i);
+	}
+
+	return (-1);
+}
 
 /**
- * @brief Flushes the TLB.
+ * @brief Chooses an entry of the emulated TLB to be replaced.
+ *
+ * @returns The index of the chosen entry.
+ */
+PRIVATE int linux64_cluster_tlb_victim(void)
+{
+	int idx;
+
+	/* Use a free entry, if any. */
+	for (int i = 0; i < linux64_cluster_tlb.length; i++)
+	{
+		if (linux64_cluster_tlb.entries[i].size == 0)
+			return (i);
+	}
+
+	if (linux64_cluster_tlb.policy == LINUX64_CLUSTER_TLB_RANDOM)
+	{
+		/* xorshift */
+		linux64_cluster_tlb.seed ^= linux64_cluster_tlb.seed << 13;
+		linux64_cluster_tlb.seed ^= linux64_cluster_tlb.seed >> 17;
+		linux64_cluster_tlb.seed ^= linux64_cluster_tlb.seed << 5;
+		return (linux64_cluster_tlb.seed % linux64_cluster_tlb.length);
+	}
+
+	idx = linux64_cluster_tlb.next;
+	linux64_cluster_tlb.next = (idx + 1) % linux64_cluster_tlb.length;
+
+	return (idx);
+}
+
+/**
+ * @brief Refills the emulated TLB.
+ *
+ * @param region Region of the faulting address.
+ * @param vaddr  Faulting address.
+ * @param stats  TLB statistics of the faulting core.
+ *
+ * @returns Upon successful completion, zero is returned. If @p vaddr
+ * is not mapped in the root page directory, -EFAULT is returned
+ * instead.
+ */
+PRIVATE int linux64_cluster_tlb_refill(
+	int region,
+	vaddr_t vaddr,
+	struct linux64_cluster_tlb_stats *stats
+)
+{
+	int idx;
+	vaddr_t base;
+	vaddr_t end;
+	bool writable;
+	struct pde *pde;
+	struct pte *pte;
+	struct pte *pgtab;
+
+	/* Walk the root page directory. */
+	pde = pde_get(root_pgdir, vaddr);
+	if (!pde_is_present(pde))
+		return (-EFAULT);
+
+	/* Huge page. */
+	if (pde_is_huge(pde))
+	{
+		base = vaddr & LINUX64_PGTAB_MASK;
+		end = base + LINUX64_HUGE_PAGE_SIZE;
+		writable = pde_is_write(pde);
+	}
+
+	/* Small page. */
+	else
+	{
+		pgtab = linux64_cluster_mmu_phys(pde_frame_get(pde) << LINUX64_PAGE_SHIFT);
+		pte = pte_get(pgtab, vaddr);
+		if (!pte_is_present(pte))
+			return (-EFAULT);
+
+		base = vaddr & LINUX64_PAGE_MASK;
+		end = base + LINUX64_PAGE_SIZE;
+		writable = pte_is_write(pte);
+	}
+
+	/* Protections do not go beyond the region. */
+	if (base < linux64_cluster_mmu_regions[region].base)
+		base = linux64_cluster_mmu_regions[region].base;
+	if (end > linux64_cluster_mmu_regions[region].base + linux64_cluster_mmu_regions[region].size)
+		end = linux64_cluster_mmu_regions[region].base + linux64_cluster_mmu_regions[region].size;
+
+	/* Replace an entry. */
+	idx = linux64_cluster_tlb_victim();
+	if (linux64_cluster_tlb.entries[idx].size != 0)
+	{
+		linux64_cluster_tlb_evict(idx);
+		stats->evictions++;
+	}
+
+	KASSERT(mprotect((void *) base, end - base,
+		PROT_READ | (writable ? PROT_WRITE : 0)) == 0);
+
+	linux64_cluster_tlb.entries[idx].vaddr = base;
+	linux64_cluster_tlb.entries[idx].size = end - base;
+	linux64_cluster_tlb.entries[idx].writable = writable;
+
+	return (0);
+}
+
+/*============================================================================*
+ * linux64_core_mmu_fault()                                                   *
+ *============================================================================*/
+
+/**
+ * The linux64_core_mmu_fault() function handles a fault on address
+ * @p vaddr. If the page that contains @p vaddr is mapped in the root
+ * page directory, it is brought into the emulated TLB, and the
+ * faulting access may then be retried.
+ */
+PUBLIC int linux64_core_mmu_fault(vaddr_t vaddr)
+{
+	int ret;
+	int idx;
+	int coreid;
+	int region;
+	sigset_t oldset;
+	struct linux64_cluster_tlb_stats *stats;
+
+	/* Not in emulated memory. */
+	if ((region = linux64_cluster_mmu_region_lookup(vaddr)) < 0)
+		return (-ENOENT);
+
+	coreid = linux64_core_get_id();
+	stats = &linux64_cluster_tlb_stats[coreid];
+
+	linux64_cluster_tlb_lock(&oldset);
+
+		/* Entry already in the TLB. */
+		if ((idx = linux64_cluster_tlb_lookup(vaddr)) >= 0)
+		{
+			ret = 0;
+
+			if (!linux64_cluster_tlb.entries[idx].writable && (linux64_cluster_tlb_last[coreid] == vaddr))
+			{
+				stats->protection_faults++;
+				ret = -EACCES;
+			}
+		}
+
+		/* TLB miss. */
+		else
+		{
+			stats->misses++;
+
+			if ((ret = linux64_cluster_tlb_refill(region, vaddr, stats)) < 0)
+				stats->page_faults++;
+		}
+
+		linux64_cluster_tlb_last[coreid] = (ret == 0) ? vaddr : 0;
+
+	linux64_cluster_tlb_unlock(&oldset);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * linux64_cluster_tlb_flush()                                                *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_tlb_flush() function flushes the TLB of the
+ * cluster. In emulated mode, this revokes access to every page that
+ * was in the TLB, so changes to page tables take effect.
  */
 PUBLIC int linux64_cluster_tlb_flush(void)
 {
-	linux64_cluster_tlb_flush_count[linux64_core_get_id()]++;
+	sigset_t oldset;
+
+	linux64_cluster_tlb_stats[linux64_core_get_id()].flushes++;
+
+	if (linux64_cluster_tlb.mode == LINUX64_CLUSTER_MMU_COSMETIC)
+		return (0);
+
+	linux64_cluster_tlb_lock(&oldset);
+
+		for (int i = 0; i < linux64_cluster_tlb.length; i++)
+			linux64_cluster_tlb_evict(i);
+
+		linux64_cluster_tlb.next = 0;
+
+	linux64_cluster_tlb_unlock(&oldset);
+
+	return (0);
+}
+
+/*============================================================================*
+ * linux64_cluster_tlb_stats_get()                                            *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_tlb_stats_get() function stores the TLB
+ * statistics of the core @p coreid in the location pointed to by @p
+ * stats.
+ */
+PUBLIC int linux64_cluster_tlb_stats_get(int coreid, struct linux64_cluster_tlb_stats *stats)
+{
+	/* Invalid core. */
+	if (!WITHIN(coreid, 0, LINUX64_CLUSTER_NUM_CORES_MAX))
+		return (-EINVAL);
+
+	/* Invalid store location. */
+	if (stats == NULL)
+		return (-EINVAL);
+
+	kmemcpy(stats, &linux64_cluster_tlb_stats[coreid], sizeof(struct linux64_cluster_tlb_stats));
 
 	return (0);
 }
 
+/*============================================================================*
+ * linux64_cluster_mmu_get()                                                  *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_mmu_get() function stores the MMU mode of the
+ * cluster, as well as the length and the replacement policy of its
+ * TLB, in the locations pointed to by @p mode, @p tlb_length and @p
+ * tlb_policy, respectively.
+ */
+PUBLIC int linux64_cluster_mmu_get(int *mode, int *tlb_length, int *tlb_policy)
+{
+	/* Invalid store location. */
+	if ((mode == NULL) || (tlb_length == NULL) || (tlb_policy == NULL))
+		return (-EINVAL);
+
+	*mode = linux64_cluster_tlb.mode;
+	*tlb_length = linux64_cluster_tlb.length;
+	*tlb_policy = linux64_cluster_tlb.policy;
+
+	return (0);
+}
+
+/*============================================================================*
+ * linux64_cluster_mmu_configure()                                            *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_mmu_configure() function sets the MMU mode of
+ * the cluster to @p mode. In emulated mode, memory regions are backed
+ * by mappings whose protections follow a TLB with @p tlb_length
+ * entries and replacement policy @p tlb_policy.
+ */
+PUBLIC int linux64_cluster_mmu_configure(int mode, int tlb_length, int tlb_policy)
+{
+	/* Invalid mode. */
+	if ((mode != LINUX64_CLUSTER_MMU_COSMETIC) && (mode != LINUX64_CLUSTER_MMU_EMULATED))
+		return (-EINVAL);
+
+	/* Invalid TLB length. */
+	if (!WITHIN(tlb_length, 1, LINUX64_CLUSTER_TLB_LENGTH_MAX + 1))
+		return (-EINVAL);
+
+	/* Invalid replacement policy. */
+	if ((tlb_policy != LINUX64_CLUSTER_TLB_FIFO) && (tlb_policy != LINUX64_CLUSTER_TLB_RANDOM))
+		return (-EINVAL);
+
+	/* Memory is already up. */
+	if (linux64_cluster_mem.booted)
+		return (-EBUSY);
+
+	linux64_cluster_tlb.mode = mode;
+	linux64_cluster_tlb.length = tlb_length;
+	linux64_cluster_tlb.policy = tlb_policy;
+
+	return (0);
+}
+
+/*============================================================================*
+ * Memory Images                                                              *
+ *============================================================================*/
+
+/**
+ * @brief Magic number of memory layout files.
+ */
+#define LINUX64_CLUSTER_IMAGE_MAGIC 0x6e616e766978696dUL
+
+/**
+ * @brief Memory images.
+ *
+ * When a directory for memory images is set, these regions are backed
+ * by files in there, and outlive the cluster. Their base addresses are
+ * kept in a layout file, so that pointers into them stay valid across
+ * restarts.
+ */
+PRIVATE struct
+{
+	const char *desc; /**< Name.             */
+	vaddr_t base;     /**< Base address.     */
+	size_t size;      /**< Size (in bytes).  */
+} linux64_cluster_images[LINUX64_CLUSTER_IMAGES_NUM] = {
+	[LINUX64_CLUSTER_IMAGE_KMEM]  = { "kmem",  0, 0 },
+	[LINUX64_CLUSTER_IMAGE_KPOOL] = { "kpool", 0, 0 },
+	[LINUX64_CLUSTER_IMAGE_UMEM]  = { "umem",  0, 0 },
+};
+
+/**
+ * @brief Layout of memory images, as stored in a layout file.
+ */
+struct linux64_cluster_image_layout
+{
+	uint64_t magic; /**< Magic number. */
+
+	/**
+	 * @brief Memory images.
+	 */
+	struct
+	{
+		uint64_t base; /**< Base address.    */
+		uint64_t size; /**< Size (in bytes). */
+	} images[LINUX64_CLUSTER_IMAGES_NUM];
+};
+
+/**
+ * @brief Directory of memory images (empty if none).
+ */
+PRIVATE char linux64_cluster_images_dir[LINUX64_CLUSTER_IMAGES_PATH_MAX] = "";
+
+/**
+ * @brief Number of the cluster that owns the memory images.
+ */
+PRIVATE int linux64_cluster_images_clusternum = 0;
+
+/**
+ * @brief Builds the path of a file of the memory images.
+ *
+ * @param path Store location for the path.
+ * @param name Name of the file.
+ */
+PRIVATE void linux64_cluster_image_path(char *path, const char *name)
+{
+	KASSERT(snprintf(path, PATH_MAX, "%s/cluster-%d.%s",
+		linux64_cluster_images_dir,
+		linux64_cluster_images_clusternum,
+		name
+	) < PATH_MAX);
+}
+
+/**
+ * @brief Opens the file of a memory image.
+ *
+ * @param image Target memory image (negative if none).
+ * @param size  Size of the image (in bytes).
+ * @param hint  Store location for the previous base address of the
+ *              image.
+ *
+ * @returns A file descriptor for the image, or a negative number if
+ * it should not be backed by a file. An image whose size has changed
+ * is discarded, and @p hint is left untouched.
+ */
+PRIVATE int linux64_cluster_image_open(int image, size_t size, vaddr_t *hint)
+{
+	int fd;
+	struct stat st;
+	char path[PATH_MAX];
+	struct linux64_cluster_image_layout layout;
+
+	/* Volatile memory. */
+	if ((image < 0) || (linux64_cluster_images_dir[0] == '\0'))
+		return (-1);
+
+	/* Lookup previous base address. */
+	linux64_cluster_image_path(path, "layout");
+	if ((fd = open(path, O_RDONLY)) >= 0)
+	{
+		if ((read(fd, &layout, sizeof(layout)) == sizeof(layout)) &&
+			(layout.magic == LINUX64_CLUSTER_IMAGE_MAGIC) &&
+			(layout.images[image].size == size))
+			*hint = layout.images[image].base;
+
+		KASSERT(close(fd) == 0);
+	}
+
+	linux64_cluster_image_path(path, linux64_cluster_images[image].desc);
+	if ((fd = open(path, O_RDWR | O_CREAT, 0600)) < 0)
+		kpanic("[hal][cluster] cannot open %s image", linux64_cluster_images[image].desc);
+	KASSERT(fstat(fd, &st) == 0);
+
+	/* Discard image. */
+	if ((size_t) st.st_size != size)
+	{
+		if (st.st_size != 0)
+			kprintf("[hal][cluster] %s image resized", linux64_cluster_images[image].desc);
+
+		*hint = 0;
+		KASSERT(ftruncate(fd, 0) == 0);
+		KASSERT(ftruncate(fd, size) == 0);
+	}
+
+	return (fd);
+}
+
+/**
+ * @brief Saves the layout of memory images.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int linux64_cluster_image_layout_save(void)
+{
+	int fd;
+	int ret;
+	char path[PATH_MAX];
+	struct linux64_cluster_image_layout layout;
+
+	kmemset(&layout, 0, sizeof(layout));
+	layout.magic = LINUX64_CLUSTER_IMAGE_MAGIC;
+	for (int i = 0; i < LINUX64_CLUSTER_IMAGES_NUM; i++)
+	{
+		layout.images[i].base = linux64_cluster_images[i].base;
+		layout.images[i].size = linux64_cluster_images[i].size;
+	}
+
+	linux64_cluster_image_path(path, "layout");
+	if ((fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0600)) < 0)
+		return (-EIO);
+
+	ret = ((write(fd, &layout, sizeof(layout)) == sizeof(layout)) && (fsync(fd) == 0)) ?
+		0 : -EIO;
+
+	KASSERT(close(fd) == 0);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * linux64_cluster_memory_persist()                                           *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_memory_persist() function backs the kernel
+ * memory, kernel page pool and user memory regions with memory images
+ * in the directory @p dir. An existing image is resumed if its size
+ * did not change.
+ */
+PUBLIC int linux64_cluster_memory_persist(const char *dir)
+{
+	/* Invalid directory. */
+	if ((dir == NULL) || (dir[0] == '\0'))
+		return (-EINVAL);
+
+	/* Directory name too long. */
+	if (kstrlen(dir) >= LINUX64_CLUSTER_IMAGES_PATH_MAX)
+		return (-ENAMETOOLONG);
+
+	/* Memory is already up. */
+	if (linux64_cluster_mem.booted)
+		return (-EBUSY);
+
+	kstrcpy(linux64_cluster_images_dir, dir);
+
+	return (0);
+}
+
+/*============================================================================*
+ * linux64_cluster_memory_image_select()                                      *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_memory_image_select() function selects the
+ * memory images of the cluster @p clusternum, so that clusters sharing
+ * a directory do not share images.
+ */
+PUBLIC void linux64_cluster_memory_image_select(int clusternum)
+{
+	KASSERT(!linux64_cluster_mem.booted);
+
+	linux64_cluster_images_clusternum = clusternum;
+}
+
+/*============================================================================*
+ * linux64_cluster_memory_snapshot()                                          *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_memory_snapshot() function writes back the
+ * memory images of the cluster, along with their layout, so that a
+ * restarted cluster resumes from this point.
+ */
+PUBLIC int linux64_cluster_memory_snapshot(void)
+{
+	/* No memory images. */
+	if (linux64_cluster_images_dir[0] == '\0')
+		return (-ENOTSUP);
+
+	/* Memory is not up. */
+	if (!linux64_cluster_mem.booted)
+		return (-EAGAIN);
+
+	for (int i = 0; i < LINUX64_CLUSTER_IMAGES_NUM; i++)
+	{
+		if (msync((void *) linux64_cluster_images[i].base, linux64_cluster_images[i].size, MS_SYNC) != 0)
+			return (-EIO);
+	}
+
+	return (linux64_cluster_image_layout_save());
+}
+
+/*============================================================================*
+ * Memory Regions                                                             *
+ *============================================================================*/
+
+/**
+ * @brief Reserves address space for a memory region.
+ *
+ * @param size Size of the region (in bytes).
+ * @param hint Preferred base address (zero if none).
+ *
+ * @returns The base address of the reserved range, which is aligned
+ * to a page table boundary. The range is not accessible and takes no
+ * memory.
+ */
+PRIVATE char *linux64_cluster_region_reserve(size_t size, vaddr_t hint)
+{
+	char *reserved;
+	char *base;
+
+	/* Try the preferred address first. */
+	if (hint != 0)
+	{
+		reserved = mmap((void *) hint, size, PROT_NONE,
+			MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED_NOREPLACE, -1, 0);
+		if (reserved == (char *) hint)
+			return (reserved);
+		if (reserved != MAP_FAILED)
+			KASSERT(munmap(reserved, size) == 0);
+	}
+
+	reserved = mmap(NULL, size + LINUX64_PGTAB_SIZE, PROT_NONE,
+		MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	KASSERT(reserved != MAP_FAILED);
+	base = (char *) TRUNCATE((vaddr_t) reserved, LINUX64_PGTAB_SIZE);
+
+	/* Give back what is not needed for alignment. */
+	if (base != reserved)
+		KASSERT(munmap(reserved, base - reserved) == 0);
+	KASSERT(munmap(base + size, (reserved + LINUX64_PGTAB_SIZE) - base) == 0);
+
+	return (base);
+}
+
+/**
+ * @brief Allocates a memory region.
+ *
+ * @param size  Size of the region (in bytes).
+ * @param image Memory image of the region (negative if none).
+ *
+ * @returns The base address of the region, which is aligned to a page
+ * table boundary. Memory is committed on first touch, except for
+ * explicit huge pages, which are reserved up front and only used for
+ * regions that span whole host huge pages. In emulated mode, the
+ * region is inaccessible until its pages get into the TLB.
+ */
+PRIVATE void *linux64_cluster_region_alloc(size_t size, int image)
+{
+	int fd;
+	int flags;
+	bool hugetlb;
+	char *base;
+	char *phys;
+	vaddr_t hint;
+
+	hint = 0;
+	fd = linux64_cluster_image_open(image, size, &hint);
+
+	base = linux64_cluster_region_reserve(size, hint);
+
+	/* Image moved, so pointers in it are stale. */
+	if ((hint != 0) && (base != (char *) hint))
+		kprintf("[hal][cluster] %s image moved", linux64_cluster_images[image].desc);
+
+	if ((fd < 0) && (linux64_cluster_tlb.mode == LINUX64_CLUSTER_MMU_EMULATED))
+	{
+		KASSERT((fd = memfd_create("nanvix-linux64-mem", 0)) >= 0);
+		KASSERT(ftruncate(fd, size) == 0);
+	}
+
+	/* File-backed memory. */
+	if (fd >= 0)
+	{
+		/* Emulated MMU. */
+		if (linux64_cluster_tlb.mode == LINUX64_CLUSTER_MMU_EMULATED)
+		{
+			KASSERT(mmap(base, size, PROT_NONE, MAP_SHARED | MAP_FIXED, fd, 0) == base);
+			phys = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			KASSERT(phys != MAP_FAILED);
+
+			linux64_cluster_mmu_region_add(base, phys, size);
+		}
+
+		/* Cosmetic MMU. */
+		else
+			KASSERT(mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == base);
+
+		KASSERT(close(fd) == 0);
+	}
+
+	/* Anonymous memory. */
+	else
+	{
+		flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED;
+		hugetlb = (linux64_cluster_mem.hugepages == LINUX64_CLUSTER_HUGEPAGES_EXPLICIT) &&
+			ALIGNED(size, LINUX64_CLUSTER_HUGEPAGE_SIZE);
+
+		/*
+		 * Explicit huge pages may run out. Reserve them up front,
+		 * so that we fall back to small pages now, rather than
+		 * getting a SIGBUS on first touch.
+		 */
+		if (!hugetlb || (mmap(base, size, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0) != base))
+		{
+			if (hugetlb)
+				kprintf("[hal][cluster] no huge pages for %d KB region", (int)(size/KB));
+
+			KASSERT(mmap(base, size, PROT_READ | PROT_WRITE, flags | MAP_NORESERVE, -1, 0) == base);
+		}
+	}
+
+	/* Transparent huge pages are just a hint. */
+	if (linux64_cluster_mem.hugepages == LINUX64_CLUSTER_HUGEPAGES_TRANSPARENT)
+		madvise(base, size, MADV_HUGEPAGE);
+
+	if (image >= 0)
+	{
+		linux64_cluster_images[image].base = (vaddr_t) base;
+		linux64_cluster_images[image].size = size;
+	}
+
+	return (base);
+}
+
+/*============================================================================*
+ * linux64_cluster_memory_configure()                                         *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_memory_configure() function sets the sizes of
+ * the kernel memory, kernel page pool and user memory regions to @p
+ * kmem, @p kpool and @p umem, respectively. Regions are
+ * backed by huge pages according to @p hugepages. The emulated MMU
+ * falls back to transparent huge pages, because protections of
+ * explicit ones may not be changed at page granularity.
+ */
+PUBLIC int linux64_cluster_memory_configure(
+	size_t kmem,
+	size_t kpool,
+	size_t umem,
+	int hugepages
+)
+{
+	/* Kernel regions should fit in a single page table. */
+	if (!WITHIN(kmem, LINUX64_PAGE_SIZE, LINUX64_KMEM_SIZE + 1) || !ALIGNED(kmem, LINUX64_PAGE_SIZE))
+		return (-EINVAL);
+	if (!WITHIN(kpool, LINUX64_PAGE_SIZE, LINUX64_KPOOL_SIZE + 1) || !ALIGNED(kpool, LINUX64_PAGE_SIZE))
+		return (-EINVAL);
+
+	/* User region should span whole page tables. */
+	if (!WITHIN(umem, LINUX64_PGTAB_SIZE, LINUX64_UMEM_SIZE + 1) || !ALIGNED(umem, LINUX64_PGTAB_SIZE))
+		return (-EINVAL);
+
+	/* Invalid huge page backing. */
+	if (!WITHIN(hugepages, LINUX64_CLUSTER_HUGEPAGES_NONE, LINUX64_CLUSTER_HUGEPAGES_EXPLICIT + 1))
+		return (-EINVAL);
+
+	/* Memory is already up. */
+	if (linux64_cluster_mem.booted)
+		return (-EBUSY);
+
+	linux64_kmem_size = kmem;
+	linux64_kpool_size = kpool;
+	linux64_umem_size = umem;
+	linux64_cluster_mem.hugepages = hugepages;
+
+	return (0);
+}
 
 /**
  * @todo TODO: provide a detailed description for this function.
@@ -86,26 +973,51 @@ PUBLIC void linux64_cluster_memory_boot(void)
 {
 	kprintf("[hal][cluster] powering on memory...");
 
+	if (linux64_cluster_tlb.mode == LINUX64_CLUSTER_MMU_EMULATED)
+	{
+		kprintf("[hal][cluster] emulating mmu with %d-entry %s tlb",
+			linux64_cluster_tlb.length,
+			(linux64_cluster_tlb.policy == LINUX64_CLUSTER_TLB_FIFO) ? "fifo" : "random"
+		);
+	}
+
+	linux64_cluster_mem.booted = true;
+
+	/* Emulated protections and memory images need small pages. */
+	if (((linux64_cluster_tlb.mode == LINUX64_CLUSTER_MMU_EMULATED) || (linux64_cluster_images_dir[0] != '\0')) &&
+		(linux64_cluster_mem.hugepages == LINUX64_CLUSTER_HUGEPAGES_EXPLICIT))
+		linux64_cluster_mem.hugepages = LINUX64_CLUSTER_HUGEPAGES_TRANSPARENT;
+
 	/* Grab some memory. */
-	KASSERT(posix_memalign(&linux64_user_base_virt_ptr,   LINUX64_PGTAB_SIZE, LINUX64_UMEM_SIZE) == 0);
-	KASSERT(posix_memalign(&linux64_ustack_base_virt_ptr, LINUX64_PGTAB_SIZE, LINUX64_PAGE_SIZE) == 0);
-	KASSERT(posix_memalign(&linux64_kernel_base_virt_ptr, LINUX64_PGTAB_SIZE, LINUX64_KMEM_SIZE) == 0);
-	KASSERT(posix_memalign(&linux64_kpool_base_virt_ptr,  LINUX64_PGTAB_SIZE, LINUX64_KPOOL_SIZE) == 0);
+	linux64_user_base_virt_ptr   = linux64_cluster_region_alloc(linux64_umem_size,  LINUX64_CLUSTER_IMAGE_UMEM);
+	linux64_ustack_base_virt_ptr = linux64_cluster_region_alloc(LINUX64_PAGE_SIZE,  -1);
+	linux64_kernel_base_virt_ptr = linux64_cluster_region_alloc(linux64_kmem_size,  LINUX64_CLUSTER_IMAGE_KMEM);
+	linux64_kpool_base_virt_ptr  = linux64_cluster_region_alloc(linux64_kpool_size, LINUX64_CLUSTER_IMAGE_KPOOL);
+
+	/* Remember where images live. */
+	if ((linux64_cluster_images_dir[0] != '\0') && (linux64_cluster_image_layout_save() < 0))
+		kprintf("[hal][cluster] cannot save memory layout");
+
+	/* Keep memory close to the cores. */
+	linux64_cluster_topology_bind_memory(linux64_user_base_virt_ptr,   linux64_umem_size);
+	linux64_cluster_topology_bind_memory(linux64_ustack_base_virt_ptr, LINUX64_PAGE_SIZE);
+	linux64_cluster_topology_bind_memory(linux64_kernel_base_virt_ptr, linux64_kmem_size);
+	linux64_cluster_topology_bind_memory(linux64_kpool_base_virt_ptr,  linux64_kpool_size);
 
 	/* Build memory layout. */
 	LINUX64_USER_BASE_VIRT   = (vaddr_t) linux64_user_base_virt_ptr;
 	LINUX64_USTACK_BASE_VIRT = (vaddr_t) linux64_ustack_base_virt_ptr;
 	LINUX64_KERNEL_BASE_VIRT = (vaddr_t) linux64_kernel_base_virt_ptr;
 	LINUX64_KPOOL_BASE_VIRT  = (vaddr_t) linux64_kpool_base_virt_ptr;
-	LINUX64_USER_END_VIRT    = LINUX64_USER_BASE_VIRT + LINUX64_UMEM_SIZE;
-	LINUX64_KERNEL_END_VIRT  = LINUX64_KERNEL_BASE_VIRT + LINUX64_KMEM_SIZE;
-	LINUX64_KPOOL_END_VIRT   = LINUX64_KPOOL_BASE_VIRT + LINUX64_KPOOL_SIZE;
+	LINUX64_USER_END_VIRT    = LINUX64_USER_BASE_VIRT + linux64_umem_size;
+	LINUX64_KERNEL_END_VIRT  = LINUX64_KERNEL_BASE_VIRT + linux64_kmem_size;
+	LINUX64_KPOOL_END_VIRT   = LINUX64_KPOOL_BASE_VIRT + linux64_kpool_size;
 
 	mem_layout[0].pbase = LINUX64_KERNEL_BASE_VIRT;
 	mem_layout[0].vbase = LINUX64_KERNEL_BASE_VIRT;
 	mem_layout[0].pend  = LINUX64_KERNEL_END_VIRT;
 	mem_layout[0].vend  = LINUX64_KERNEL_END_VIRT;
-	mem_layout[0].size  = LINUX64_KMEM_SIZE;
+	mem_layout[0].size  = linux64_kmem_size;
 	mem_layout[0].writable = true;
 	mem_layout[0].executable = true;
 	mem_layout[0].root_pgtab_num = 0;
@@ -115,7 +1027,7 @@ PUBLIC void linux64_cluster_memory_boot(void)
 	mem_layout[1].vbase = LINUX64_KPOOL_BASE_VIRT;
 	mem_layout[1].pend  = LINUX64_KPOOL_END_VIRT;
 	mem_layout[1].vend  = LINUX64_KPOOL_END_VIRT;
-	mem_layout[1].size  = LINUX64_KPOOL_SIZE;
+	mem_layout[1].size  = linux64_kpool_size;
 	mem_layout[1].writable = true;
 	mem_layout[1].executable = false;
 	mem_layout[1].root_pgtab_num = 1;
@@ -22,27 +22,156 @@
  * SOFTWARE.
  */
 
-#include <arch/cluster/linux64-cluster/timer.h>
+/* Must come first. */
+#define __NEED_HAL_CLUSTER
+
+#include <nanvix/hal/cluster.h>
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+#include <signal.h>
+#include <sys/syscall.h>
 #include <time.h>
+#include <unistd.h>
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
 
 /**
- * @brief Startup time.
+ * @brief Nanoseconds in a second.
  */
-PRIVATE clock_t clock_init;
+#define LINUX64_NSEC_PER_SEC 1000000000ULL
 
 /**
- * @brief Reads the timestamp counter from the DSU.
+ * @brief Startup time (in nanoseconds).
+ */
+PRIVATE uint64_t clock_init;
+
+/**
+ * @brief Host timers of the cores.
+ */
+PRIVATE struct
+{
+	bool created;  /**< Host timer created? */
+	timer_t timer; /**< Host timer.         */
+	unsigned freq; /**< Tick frequency.     */
+} timers[LINUX64_CLUSTER_NUM_CORES_MAX];
+
+/**
+ * @brief Reads the host monotonic clock.
  *
- * @returns The timestamp counter from the DSU.
+ * @returns The host monotonic clock, in nanoseconds.
+ */
+PRIVATE uint64_t linux64_clock_gettime(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t) ts.tv_sec*LINUX64_NSEC_PER_SEC + ts.tv_nsec);
+}
+
+/**
+ * The linux64_cluster_timer_boot() function sets the origin of the
+ * cluster clock. All cores share it, so timestamps taken in
+ * different cores are comparable.
+ */
+PUBLIC void linux64_cluster_timer_boot(void)
+{
+	clock_init = linux64_clock_gettime();
+}
+
+/**
+ * @brief Programs the host timer of a core.
  *
- * @author Daniel Coscia
+ * @param coreid ID of the target core.
+ * @param freq   Frequency of timer interrupts (in Hz). Zero
+ *               disarms the timer.
  */
-PUBLIC void linux64_timer_init(void)
+PRIVATE void linux64_timer_program(int coreid, unsigned freq)
 {
-    clock_init = clock();
+	struct itimerspec its;
+
+	kmemset(&its, 0, sizeof(struct itimerspec));
+
+	/* Zero disarms the timer. */
+	if (freq != 0)
+	{
+		uint64_t period = LINUX64_NSEC_PER_SEC/freq;
+
+		its.it_interval.tv_sec = period/LINUX64_NSEC_PER_SEC;
+		its.it_interval.tv_nsec = period%LINUX64_NSEC_PER_SEC;
+		its.it_value = its.it_interval;
+	}
+
+	KASSERT(timer_settime(timers[coreid].timer, 0, &its, NULL) == 0);
 }
 
+/**
+ * The linux64_timer_init() function arms a periodic host timer that
+ * delivers INTERRUPT_TIMER to the thread of the underlying core at
+ * @p freq Hz. Frequencies above the one of the cluster clock are
+ * rejected, since their period would round down to zero, which
+ * disarms the host timer.
+ */
+PUBLIC void linux64_timer_init(unsigned freq)
+{
+	int coreid;
+
+	/* Period would be zero. */
+	KASSERT(freq <= LINUX64_CLUSTER_CLUSTER_FREQ);
+
+	coreid = linux64_core_get_id();
+
+	/* Create timer for this core. */
+	if (!timers[coreid].created)
+	{
+		struct sigevent sev;
+
+		kmemset(&sev, 0, sizeof(struct sigevent));
+		sev.sigev_notify = SIGEV_THREAD_ID;
+		sev.sigev_signo = LINUX64_INT_TIMER;
+		sev.sigev_notify_thread_id = syscall(SYS_gettid);
+
+		KASSERT(timer_create(CLOCK_MONOTONIC, &sev, &timers[coreid].timer) == 0);
+
+		timers[coreid].created = true;
+	}
+
+	timers[coreid].freq = freq;
+	linux64_timer_program(coreid, freq);
+}
+
+/**
+ * The linux64_timer_stop() function disarms the host timer of the
+ * underlying core, but remembers its frequency.
+ */
+PUBLIC void linux64_timer_stop(void)
+{
+	int coreid = linux64_core_get_id();
+
+	if (timers[coreid].created)
+		linux64_timer_program(coreid, 0);
+}
+
+/**
+ * The linux64_timer_restart() function rearms the host timer of the
+ * underlying core with the frequency it last had.
+ */
+PUBLIC void linux64_timer_restart(void)
+{
+	int coreid = linux64_core_get_id();
+
+	if (timers[coreid].created)
+		linux64_timer_program(coreid, timers[coreid].freq);
+}
+
+/**
+ * The linux64_cluster_clock_read() function reads the host monotonic
+ * clock, which has nanosecond resolution and advances at the same
+ * rate no matter how many threads are running.
+ */
 PUBLIC uint64_t linux64_cluster_clock_read(void)
 {
-    return (clock() - clock_init);
+	return (linux64_clock_gettime() - clock_init);
 }
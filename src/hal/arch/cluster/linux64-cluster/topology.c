@@ -0,0 +1,325 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __NEED_HAL_CLUSTER
+
+#include <nanvix/hal/cluster.h>
+#include <arch/cluster/linux64-cluster/topology.h>
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#if (LINUX64_CLUSTER_HOST_CPUS_MAX > CPU_SETSIZE)
+#error "too many host CPUs"
+#endif
+
+/**
+ * @brief Placement of the underlying cluster.
+ */
+PRIVATE struct
+{
+	int policy;                              /**< Placement policy.         */
+	int node;                                /**< Host node of the cluster. */
+	int cpus[LINUX64_CLUSTER_NUM_CORES_MAX]; /**< Host CPU of each core.    */
+} topology = {
+	.policy = LINUX64_CLUSTER_AFFINITY_NONE,
+	.node = -1,
+	.cpus = { [0 ... (LINUX64_CLUSTER_NUM_CORES_MAX - 1)] = -1 },
+};
+
+/**
+ * @brief Placement domain: host CPUs that share a last level cache,
+ * or a NUMA node if cache information is not available.
+ */
+struct linux64_cluster_domain
+{
+	int node;                                /**< Host node.      */
+	int ncpus;                               /**< Number of CPUs. */
+	int cpus[LINUX64_CLUSTER_HOST_CPUS_MAX]; /**< Host CPUs.      */
+};
+
+/**
+ * @brief Placement domains of the host.
+ */
+PRIVATE struct linux64_cluster_domain domains[LINUX64_CLUSTER_HOST_NODES_MAX];
+
+/*============================================================================*
+ * linux64_cluster_topology_read()                                            *
+ *============================================================================*/
+
+/**
+ * @brief Reads a list of host CPUs from sysfs.
+ *
+ * @param path Path to a file in the cpulist format (e.g., 0-3,8).
+ * @param set  Store location for the CPUs.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int linux64_cluster_topology_read(const char *path, cpu_set_t *set)
+{
+	FILE *fp;
+	int first;
+	int last;
+
+	if ((fp = fopen(path, "r")) == NULL)
+		return (-ENOENT);
+
+	CPU_ZERO(set);
+
+	while (fscanf(fp, "%d", &first) == 1)
+	{
+		/* Range of CPUs. */
+		if (fscanf(fp, "-%d", &last) != 1)
+			last = first;
+
+		for (int cpu = first; (cpu <= last) && (cpu < CPU_SETSIZE); cpu++)
+			CPU_SET(cpu, set);
+
+		/* Next range. */
+		if (fgetc(fp) != ',')
+			break;
+	}
+
+	fclose(fp);
+
+	return ((CPU_COUNT(set) > 0) ? 0 : -EINVAL);
+}
+
+/*============================================================================*
+ * linux64_cluster_topology_scan()                                            *
+ *============================================================================*/
+
+/**
+ * @brief Groups host CPUs into placement domains.
+ *
+ * Only CPUs in the affinity mask of the host process are
+ * considered, so the host CPUs can be further restricted with
+ * taskset(1).
+ *
+ * @returns The number of placement domains.
+ */
+PRIVATE int linux64_cluster_topology_scan(void)
+{
+	int ndomains;
+	char path[128];
+	cpu_set_t allowed;
+	cpu_set_t assigned;
+	cpu_set_t shared;
+	cpu_set_t nodes[LINUX64_CLUSTER_HOST_NODES_MAX];
+
+	KASSERT(sched_getaffinity(0, sizeof(cpu_set_t), &allowed) == 0);
+
+	/* Read host nodes. */
+	for (int i = 0; i < LINUX64_CLUSTER_HOST_NODES_MAX; i++)
+	{
+		snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", i);
+		if (linux64_cluster_topology_read(path, &nodes[i]) < 0)
+			CPU_ZERO(&nodes[i]);
+	}
+
+	ndomains = 0;
+	CPU_ZERO(&assigned);
+
+	for (int cpu = 0; cpu < LINUX64_CLUSTER_HOST_CPUS_MAX; cpu++)
+	{
+		struct linux64_cluster_domain *domain;
+
+		if (!CPU_ISSET(cpu, &allowed) || CPU_ISSET(cpu, &assigned))
+			continue;
+
+		/* Too many domains. */
+		if (ndomains == LINUX64_CLUSTER_HOST_NODES_MAX)
+			break;
+
+		domain = &domains[ndomains++];
+		domain->node = -1;
+		domain->ncpus = 0;
+
+		for (int i = 0; i < LINUX64_CLUSTER_HOST_NODES_MAX; i++)
+		{
+			if (CPU_ISSET(cpu, &nodes[i]))
+			{
+				domain->node = i;
+				break;
+			}
+		}
+
+		/* CPUs that share the last level cache. */
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index3/shared_cpu_list", cpu);
+		if (linux64_cluster_topology_read(path, &shared) < 0)
+		{
+			if (domain->node >= 0)
+				CPU_OR(&shared, &nodes[domain->node], &nodes[domain->node]);
+			else
+				CPU_OR(&shared, &allowed, &allowed);
+		}
+
+		CPU_AND(&shared, &shared, &allowed);
+		CPU_SET(cpu, &shared);
+
+		for (int i = cpu; i < LINUX64_CLUSTER_HOST_CPUS_MAX; i++)
+		{
+			if (CPU_ISSET(i, &shared) && !CPU_ISSET(i, &assigned))
+			{
+				domain->cpus[domain->ncpus++] = i;
+				CPU_SET(i, &assigned);
+			}
+		}
+	}
+
+	return (ndomains);
+}
+
+/*============================================================================*
+ * linux64_cluster_topology_boot()                                            *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_topology_boot() function chooses a host CPU
+ * for each core of the underlying cluster. With the compact policy,
+ * clusters are dealt to placement domains in round-robin, and the
+ * cores of a cluster are packed into consecutive CPUs of its domain.
+ * Clusters that share a domain are given disjoint CPUs, as long as
+ * there are enough of them. Pinning is opt-in: unless the compact
+ * policy is requested at boot, placement is left to the host
+ * scheduler.
+ */
+PUBLIC int linux64_cluster_topology_boot(int clusternum, int ncores, int policy)
+{
+	int ndomains;
+	int offset;
+	struct linux64_cluster_domain *domain;
+
+	/* Invalid cluster. */
+	if (clusternum < 0)
+		return (-EINVAL);
+
+	/* Invalid number of cores. */
+	if (!WITHIN(ncores, 1, LINUX64_CLUSTER_NUM_CORES_MAX + 1))
+		return (-EINVAL);
+
+	topology.policy = policy;
+
+	switch (policy)
+	{
+		case LINUX64_CLUSTER_AFFINITY_NONE:
+			return (0);
+
+		case LINUX64_CLUSTER_AFFINITY_COMPACT:
+			break;
+
+		/* Invalid policy. */
+		default:
+			return (-EINVAL);
+	}
+
+	if ((ndomains = linux64_cluster_topology_scan()) == 0)
+		return (-EAGAIN);
+
+	domain = &domains[clusternum%ndomains];
+	offset = (clusternum/ndomains)*ncores;
+
+	topology.node = domain->node;
+	for (int i = 0; i < ncores; i++)
+		topology.cpus[i] = domain->cpus[(offset + i)%domain->ncpus];
+
+	return (0);
+}
+
+/*============================================================================*
+ * linux64_cluster_topology_bind_core()                                       *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_topology_bind_core() function pins the thread
+ * of the underlying core to the host CPU chosen at boot time.
+ */
+PUBLIC void linux64_cluster_topology_bind_core(void)
+{
+	int cpu;
+	cpu_set_t set;
+
+	/* Not pinned. */
+	if ((cpu = topology.cpus[linux64_core_get_id()]) < 0)
+		return;
+
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+
+	KASSERT(pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0);
+}
+
+/*============================================================================*
+ * linux64_cluster_topology_bind_memory()                                     *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_topology_bind_memory() function asks the host
+ * to back the memory region that starts at @p base and spans @p size
+ * bytes with frames of the host node of the cluster. If the host
+ * refuses to, the region is left to the default policy.
+ */
+PUBLIC void linux64_cluster_topology_bind_memory(void *base, size_t size)
+{
+	unsigned long nodemask;
+
+	/* Not bound. */
+	if (topology.node < 0)
+		return;
+
+	nodemask = 1UL << topology.node;
+
+	if (syscall(SYS_mbind, base, size, MPOL_BIND, &nodemask, LINUX64_CLUSTER_HOST_NODES_MAX + 1, MPOL_MF_MOVE) < 0)
+		kprintf("[hal][cluster] cannot bind memory to node %d", topology.node);
+}
+
+/*============================================================================*
+ * linux64_cluster_topology_dump()                                            *
+ *============================================================================*/
+
+/**
+ * The linux64_cluster_topology_dump() function prints the host CPU
+ * of each core in the underlying cluster.
+ */
+PUBLIC void linux64_cluster_topology_dump(void)
+{
+	if (topology.policy == LINUX64_CLUSTER_AFFINITY_NONE)
+	{
+		kprintf("[hal][cluster] cores not pinned");
+		return;
+	}
+
+	if (topology.node >= 0)
+		kprintf("[hal][cluster] memory bound to node %d", topology.node);
+
+	for (int i = 0; i < linux64_cluster_ncores; i++)
+		kprintf("[hal][cluster] core %d pinned to cpu %d", i, topology.cpus[i]);
+}
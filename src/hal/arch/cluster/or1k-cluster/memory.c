@@ -263,6 +263,8 @@ PUBLIC void or1k_cluster_tlb_init(void)
 		itlbtr += OR1K_PAGE_SIZE;
 		xtlbmr += OR1K_PAGE_SIZE;
 	}
+
+	tlb_index_invalidate(coreid);
 }
 
 /*============================================================================*
@@ -308,17 +310,28 @@ PRIVATE void or1k_cluster_do_tlb_fault(
 		kpanic("[hal] page fault at %x", exception_get_addr(excp));
 	}
 
+	/* Huge page: refill from the PDE. */
+	if (pde_is_huge(pde))
+	{
+		paddr = (pde_frame_get(pde) << OR1K_PAGE_SHIFT)
+			+ (vaddr & ~OR1K_PGTAB_MASK);
+	}
+
 	/* Lookup PTE. */
-	pgtab = (struct pte *)(pde_frame_get(pde) << OR1K_PAGE_SHIFT);
-	pte = pte_get(pgtab, vaddr);
-	if (!pte_is_present(pte))
+	else
 	{
-		or1k_context_dump(ctx);
-		kpanic("[hal] page fault at %x", exception_get_addr(excp));
+		pgtab = (struct pte *)(pde_frame_get(pde) << OR1K_PAGE_SHIFT);
+		pte = pte_get(pgtab, vaddr);
+		if (!pte_is_present(pte))
+		{
+			or1k_context_dump(ctx);
+			kpanic("[hal] page fault at %x", exception_get_addr(excp));
+		}
+
+		paddr = pte_frame_get(pte) << OR1K_PAGE_SHIFT;
 	}
 
 	/* Writing mapping to TLB. */
-	paddr = pte_frame_get(pte) << OR1K_PAGE_SHIFT;
 
 	tlb_type = (excp->num == OR1K_EXCP_ITLB_FAULT) ?
 		OR1K_TLB_INSTRUCTION : OR1K_TLB_DATA;
@@ -34,11 +34,11 @@ EXTERN NORETURN void kmain(int, const char *[]);
  * @brief Cores table.
  */
 PUBLIC struct coreinfo cores[RISCV32_CLUSTER_NUM_CORES] = {
-	{ true,  CORE_RUNNING,   0, NULL, RV32GC_SPINLOCK_UNLOCKED }, /* Master Core   */
-	{ false, CORE_RESETTING, 0, NULL, RV32GC_SPINLOCK_LOCKED   }, /* Slave Core 1  */
-	{ false, CORE_RESETTING, 0, NULL, RV32GC_SPINLOCK_LOCKED   }, /* Slave Core 2  */
-	{ false, CORE_RESETTING, 0, NULL, RV32GC_SPINLOCK_LOCKED   }, /* Slave Core 3  */
-	{ false, CORE_RESETTING, 0, NULL, RV32GC_SPINLOCK_LOCKED   }, /* Slave Core 4  */
+	{ true,  CORE_RUNNING,   0, NULL, RV32GC_SPINLOCK_UNLOCKED, -1 }, /* Master Core   */
+	{ false, CORE_RESETTING, 0, NULL, RV32GC_SPINLOCK_LOCKED,   -1 }, /* Slave Core 1  */
+	{ false, CORE_RESETTING, 0, NULL, RV32GC_SPINLOCK_LOCKED,   -1 }, /* Slave Core 2  */
+	{ false, CORE_RESETTING, 0, NULL, RV32GC_SPINLOCK_LOCKED,   -1 }, /* Slave Core 3  */
+	{ false, CORE_RESETTING, 0, NULL, RV32GC_SPINLOCK_LOCKED,   -1 }, /* Slave Core 4  */
 };
 
 /*============================================================================*
@@ -72,7 +72,416 @@ PRIVATE struct cache_info
 	unsigned icache_line_prefetch_count;   /**< Number of Line Invalidates */
 	unsigned icache_line_invalidate_count; /**< Number of Line Prefetches  */
 	/**@}*/
-} linux64_core_cache_info[LINUX64_CLUSTER_NUM_CORES];
+} linux64_core_cache_info[LINUX64_CLUSTER_NUM_CORES_MAX];
+
+/*============================================================================*
+ * Data Cache Model                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Start of the executable.
+ *
+ * Call sites are printed as offsets from here, so that they can be
+ * fed to addr2line.
+ */
+EXTERN char __executable_start;
+
+/**
+ * @brief Names of cache maintenance operations.
+ */
+PRIVATE const char *linux64_dcache_op_names[LINUX64_DCACHE_OPS_NUM] = {
+	"invalidate",
+	"flush",
+	"fence",
+	"line invalidate",
+	"line prefetch"
+};
+
+/**
+ * @brief Geometry of the data cache model.
+ */
+PRIVATE struct
+{
+	unsigned nlines; /**< Number of lines (zero if off). */
+	unsigned nways;  /**< Associativity.                 */
+	unsigned nsets;  /**< Number of sets.                */
+} linux64_dcache_model_geometry = { 0, 1, 0 };
+
+/**
+ * @brief Line of the data cache model.
+ */
+struct linux64_dcache_line
+{
+	uint64_t tag;   /**< Line number. */
+	uint32_t stamp; /**< Last use.    */
+	bool valid;     /**< Valid?       */
+	bool dirty;     /**< Dirty?       */
+};
+
+/**
+ * @brief Call site of a cache maintenance operation.
+ */
+struct linux64_dcache_site
+{
+	const void *addr; /**< Return address.   */
+	int op;           /**< Operation.        */
+	unsigned count;   /**< Number of calls.  */
+	uint64_t cycles;  /**< Estimated cycles. */
+};
+
+/**
+ * @brief Data cache model of a core.
+ */
+PRIVATE struct linux64_dcache_model
+{
+	volatile bool busy;                                               /**< Being updated?           */
+	uint32_t clock;                                                   /**< Clock for LRU.           */
+	unsigned nvalid;                                                  /**< Valid lines.             */
+	unsigned ndirty;                                                  /**< Dirty lines.             */
+	unsigned untracked;                                               /**< Calls out of site table. */
+	struct linux64_dcache_model_stats stats;                          /**< Statistics.              */
+	struct linux64_dcache_line lines[LINUX64_DCACHE_MODEL_LINES_MAX]; /**< Lines, set by set.       */
+	struct linux64_dcache_site sites[LINUX64_DCACHE_MODEL_SITES];     /**< Call sites.              */
+} linux64_dcache_models[LINUX64_CLUSTER_NUM_CORES_MAX];
+
+/**
+ * @brief Enters the data cache model of the underlying core.
+ *
+ * @returns The data cache model of the underlying core, or NULL if
+ * the model is off or is being updated by an interrupted flow.
+ */
+PRIVATE struct linux64_dcache_model *linux64_dcache_model_enter(void)
+{
+	struct linux64_dcache_model *model;
+
+	/* Model is off. */
+	if (linux64_dcache_model_geometry.nlines == 0)
+		return (NULL);
+
+	model = &linux64_dcache_models[linux64_core_get_id()];
+
+	/* Reentered from an interrupt handler. */
+	if (model->busy)
+		return (NULL);
+
+	model->busy = true;
+
+	return (model);
+}
+
+/**
+ * @brief Leaves the data cache model of the underlying core.
+ *
+ * @param model Target model.
+ */
+PRIVATE void linux64_dcache_model_leave(struct linux64_dcache_model *model)
+{
+	model->busy = false;
+}
+
+/**
+ * @brief Charges a cache maintenance operation to its call site.
+ *
+ * @param model  Target model.
+ * @param op     Target operation.
+ * @param site   Call site.
+ * @param cycles Estimated cycles.
+ */
+PRIVATE void linux64_dcache_model_charge(
+	struct linux64_dcache_model *model,
+	int op,
+	const void *site,
+	uint64_t cycles
+)
+{
+	unsigned hash;
+
+	model->stats.ops[op]++;
+	model->stats.cycles[op] += cycles;
+
+	hash = (((uintptr_t) site) >> 2) + op;
+	for (unsigned i = 0; i < LINUX64_DCACHE_MODEL_SITES; i++)
+	{
+		struct linux64_dcache_site *s;
+
+		s = &model->sites[(hash + i)%LINUX64_DCACHE_MODEL_SITES];
+
+		/* Take a new slot. */
+		if (s->count == 0)
+		{
+			s->addr = site;
+			s->op = op;
+		}
+
+		/* Slot of another site. */
+		else if ((s->addr != site) || (s->op != op))
+			continue;
+
+		s->count++;
+		s->cycles += cycles;
+		return;
+	}
+
+	model->untracked++;
+}
+
+/**
+ * @brief Feeds a cache maintenance operation to the data cache model.
+ *
+ * @param op   Target operation.
+ * @param site Call site.
+ *
+ * Dirty lines are written back before an invalidation drops them,
+ * and each valid line is charged a refill, because the code that
+ * invalidates the cache is about to read its data again.
+ */
+PRIVATE void linux64_dcache_model_op(int op, const void *site)
+{
+	uint64_t cycles;
+	struct linux64_dcache_model *model;
+
+	if ((model = linux64_dcache_model_enter()) == NULL)
+		return;
+
+	cycles = LINUX64_DCACHE_COST_OP;
+
+	if ((op == LINUX64_DCACHE_OP_INVALIDATE) || (op == LINUX64_DCACHE_OP_FLUSH))
+	{
+		cycles += linux64_dcache_model_geometry.nlines*LINUX64_DCACHE_COST_WALK;
+		cycles += model->ndirty*LINUX64_DCACHE_COST_WRITEBACK;
+		model->stats.writebacks += model->ndirty;
+
+		if (op == LINUX64_DCACHE_OP_INVALIDATE)
+			cycles += model->nvalid*LINUX64_DCACHE_COST_MISS;
+
+		for (unsigned i = 0; i < linux64_dcache_model_geometry.nlines; i++)
+		{
+			model->lines[i].dirty = false;
+			if (op == LINUX64_DCACHE_OP_INVALIDATE)
+				model->lines[i].valid = false;
+		}
+
+		model->ndirty = 0;
+		if (op == LINUX64_DCACHE_OP_INVALIDATE)
+			model->nvalid = 0;
+	}
+
+	linux64_dcache_model_charge(model, op, site, cycles);
+
+	linux64_dcache_model_leave(model);
+}
+
+/**
+ * The linux64_core_dcache_model_configure() function sets the
+ * geometry of the data cache model to @p size bytes and @p ways
+ * lines per set. Lines are @ref CACHE_LINE_SIZE bytes long and are
+ * replaced in LRU order.
+ */
+PUBLIC int linux64_core_dcache_model_configure(size_t size, unsigned ways)
+{
+	size_t nlines;
+	size_t nsets;
+
+	/* Turn model off. */
+	if (size == 0)
+	{
+		linux64_dcache_model_geometry.nlines = 0;
+		return (0);
+	}
+
+	/* Invalid associativity. */
+	if (!WITHIN(ways, 1, LINUX64_DCACHE_MODEL_WAYS_MAX + 1))
+		return (-EINVAL);
+
+	/* Invalid size. */
+	if (!ALIGNED(size, ways*CACHE_LINE_SIZE))
+		return (-EINVAL);
+	if ((nlines = size/CACHE_LINE_SIZE) > LINUX64_DCACHE_MODEL_LINES_MAX)
+		return (-EINVAL);
+
+	/* Number of sets should be a power of two. */
+	nsets = nlines/ways;
+	if (nsets & (nsets - 1))
+		return (-EINVAL);
+
+	linux64_dcache_model_geometry.nlines = nlines;
+	linux64_dcache_model_geometry.nways = ways;
+	linux64_dcache_model_geometry.nsets = nsets;
+
+	return (0);
+}
+
+/**
+ * The linux64_core_dcache_model_access() function feeds an access to
+ * @p size bytes at @p addr to the data cache model of the underlying
+ * core. Cache maintenance is only as expensive as the lines it finds,
+ * so code that wants a realistic estimate should feed the accesses it
+ * cares about.
+ */
+PUBLIC void linux64_core_dcache_model_access(const void *addr, size_t size, bool write)
+{
+	uint64_t first;
+	uint64_t last;
+	struct linux64_dcache_model *model;
+
+	/* Nothing to do. */
+	if (size == 0)
+		return;
+
+	if ((model = linux64_dcache_model_enter()) == NULL)
+		return;
+
+	first = ((uintptr_t) addr) >> CACHE_LINE_SIZE_LOG2;
+	last = (((uintptr_t) addr) + size - 1) >> CACHE_LINE_SIZE_LOG2;
+
+	for (uint64_t tag = first; tag <= last; tag++)
+	{
+		struct linux64_dcache_line *set;
+		struct linux64_dcache_line *line = NULL;
+		struct linux64_dcache_line *victim = NULL;
+
+		set = &model->lines[(tag & (linux64_dcache_model_geometry.nsets - 1))*linux64_dcache_model_geometry.nways];
+
+		for (unsigned i = 0; i < linux64_dcache_model_geometry.nways; i++)
+		{
+			if (set[i].valid && (set[i].tag == tag))
+			{
+				line = &set[i];
+				break;
+			}
+
+			/* Prefer invalid lines, then the least recently used. */
+			if ((victim == NULL) || (victim->valid && (!set[i].valid || (set[i].stamp < victim->stamp))))
+				victim = &set[i];
+		}
+
+		/* Hit. */
+		if (line != NULL)
+		{
+			model->stats.hits++;
+			model->stats.access_cycles += LINUX64_DCACHE_COST_HIT;
+		}
+
+		/* Miss. */
+		else
+		{
+			line = victim;
+			model->stats.misses++;
+			model->stats.access_cycles += LINUX64_DCACHE_COST_MISS;
+
+			if (!line->valid)
+				model->nvalid++;
+			else if (line->dirty)
+			{
+				model->ndirty--;
+				model->stats.writebacks++;
+				model->stats.access_cycles += LINUX64_DCACHE_COST_WRITEBACK;
+			}
+
+			line->tag = tag;
+			line->valid = true;
+			line->dirty = false;
+		}
+
+		if (write && !line->dirty)
+		{
+			line->dirty = true;
+			model->ndirty++;
+		}
+
+		line->stamp = ++model->clock;
+	}
+
+	linux64_dcache_model_leave(model);
+}
+
+/**
+ * The linux64_core_dcache_model_stats_get() function stores the
+ * statistics of the data cache model of the core @p coreid in the
+ * location pointed to by @p stats.
+ */
+PUBLIC int linux64_core_dcache_model_stats_get(int coreid, struct linux64_dcache_model_stats *stats)
+{
+	/* Invalid core. */
+	if (!WITHIN(coreid, 0, LINUX64_CLUSTER_NUM_CORES_MAX))
+		return (-EINVAL);
+
+	/* Invalid store location. */
+	if (stats == NULL)
+		return (-EINVAL);
+
+	/* Model is off. */
+	if (linux64_dcache_model_geometry.nlines == 0)
+		return (-ENOTSUP);
+
+	kmemcpy(stats, &linux64_dcache_models[coreid].stats, sizeof(struct linux64_dcache_model_stats));
+
+	return (0);
+}
+
+/**
+ * The linux64_core_dcache_model_dump() function prints the estimated
+ * cost of each cache maintenance operation in the underlying core,
+ * followed by the call sites that spent most cycles on them.
+ */
+PUBLIC void linux64_core_dcache_model_dump(void)
+{
+	bool dumped[LINUX64_DCACHE_MODEL_SITES];
+	struct linux64_dcache_model *model;
+
+	/* Model is off. */
+	if (linux64_dcache_model_geometry.nlines == 0)
+		return;
+
+	model = &linux64_dcache_models[linux64_core_get_id()];
+
+	kprintf("dcache_model = %d sets x %d ways",
+		linux64_dcache_model_geometry.nsets,
+		linux64_dcache_model_geometry.nways
+	);
+	kprintf("dcache_model_hits = %d", (int) model->stats.hits);
+	kprintf("dcache_model_misses = %d", (int) model->stats.misses);
+	kprintf("dcache_model_writebacks = %d", (int) model->stats.writebacks);
+
+	for (int i = 0; i < LINUX64_DCACHE_OPS_NUM; i++)
+	{
+		kprintf("dcache_model %s = %d calls, %d cycles",
+			linux64_dcache_op_names[i],
+			(int) model->stats.ops[i],
+			(int) model->stats.cycles[i]
+		);
+	}
+
+	/* Dump call sites, most expensive first. */
+	for (int i = 0; i < LINUX64_DCACHE_MODEL_SITES; i++)
+		dumped[i] = false;
+	for (int k = 0; k < LINUX64_DCACHE_MODEL_SITES; k++)
+	{
+		int top = -1;
+
+		for (int i = 0; i < LINUX64_DCACHE_MODEL_SITES; i++)
+		{
+			if (dumped[i] || (model->sites[i].count == 0))
+				continue;
+			if ((top < 0) || (model->sites[i].cycles > model->sites[top].cycles))
+				top = i;
+		}
+
+		if (top < 0)
+			break;
+
+		dumped[top] = true;
+		kprintf("dcache_model %s at +%x = %d calls, %d cycles",
+			linux64_dcache_op_names[model->sites[top].op],
+			(unsigned) ((const char *) model->sites[top].addr - &__executable_start),
+			model->sites[top].count,
+			(int) model->sites[top].cycles
+		);
+	}
+
+	if (model->untracked > 0)
+		kprintf("dcache_model untracked = %d calls", model->untracked);
+}
 
 /*============================================================================*
  * Data Cache                                                                 *
@@ -111,43 +520,53 @@ PUBLIC size_t linux64_core_dcache_size_log2_get(void)
 }
 
 /**
- * @brief Incremement the counter, invalidate don't have sense in linux64.
+ * @brief Incremement the counter and feed the data cache model, invalidate
+ * don't have sense in linux64.
  */
 PUBLIC void linux64_core_dcache_invalidate(void)
 {
 	linux64_core_cache_info[linux64_core_get_id()].dcache_invalidate_count++;
+	linux64_dcache_model_op(LINUX64_DCACHE_OP_INVALIDATE, __builtin_return_address(0));
 }
 
 /**
- * @brief Incremement the counter, flush don't have sense in linux64.
+ * @brief Incremement the counter and feed the data cache model, flush
+ * don't have sense in linux64.
  */
 PUBLIC void linux64_core_dcache_flush(void)
 {
 	linux64_core_cache_info[linux64_core_get_id()].dcache_flush_count++;
+	linux64_dcache_model_op(LINUX64_DCACHE_OP_FLUSH, __builtin_return_address(0));
 }
 
 /**
- * @brief Incremement the counter, fence don't have sense in linux64.
+ * @brief Incremement the counter and feed the data cache model, fence
+ * don't have sense in linux64.
  */
 PUBLIC void linux64_core_dcache_fence(void)
 {
 	linux64_core_cache_info[linux64_core_get_id()].dcache_fence_count++;
+	linux64_dcache_model_op(LINUX64_DCACHE_OP_FENCE, __builtin_return_address(0));
 }
 
 /**
- * @brief Incremement the counter, prefetch line don't have sense in linux64.
+ * @brief Incremement the counter and feed the data cache model, prefetch line
+ * don't have sense in linux64.
  */
-PUBLIC void linux64_core_dcache_prefetch_line(void)
+PUBLIC void linux64_core_dcache_line_prefetch(void)
 {
 	linux64_core_cache_info[linux64_core_get_id()].dcache_line_prefetch_count++;
+	linux64_dcache_model_op(LINUX64_DCACHE_OP_LINE_PREFETCH, __builtin_return_address(0));
 }
 
 /**
- * @brief Incremement the counter, invalidate line don't have sense in linux64.
+ * @brief Incremement the counter and feed the data cache model, invalidate line
+ * don't have sense in linux64.
  */
-PUBLIC void linux64_core_dcache_invalidate_line(void)
+PUBLIC void linux64_core_dcache_line_invalidate(void)
 {
 	linux64_core_cache_info[linux64_core_get_id()].dcache_line_invalidate_count++;
+	linux64_dcache_model_op(LINUX64_DCACHE_OP_LINE_INVALIDATE, __builtin_return_address(0));
 }
 
 /**
@@ -173,6 +592,7 @@ PUBLIC void linux64_core_dcache_dump_stats(void)
 	kprintf("dcache_fence = %d", linux64_core_cache_info[linux64_core_get_id()].dcache_fence_count);
 	kprintf("dcache_line_prefetch = %d", linux64_core_cache_info[linux64_core_get_id()].dcache_line_prefetch_count);
 	kprintf("dcache_line_invalidate = %d", linux64_core_cache_info[linux64_core_get_id()].dcache_line_invalidate_count);
+	linux64_core_dcache_model_dump();
 }
 
 /**
@@ -203,6 +623,16 @@ PUBLIC void linux64_core_dcache_setup(void)
 		linux64_log2(linux64_core_cache_info[linux64_core_get_id()].cache_size);
 	linux64_core_cache_info[linux64_core_get_id()].cache_size =
 		linux64_pow(2, linux64_core_cache_info[linux64_core_get_id()].cache_size_log2);
+
+	/* Start data cache model cold. */
+	if (linux64_dcache_model_geometry.nlines > 0)
+	{
+		kmemset(
+			&linux64_dcache_models[linux64_core_get_id()],
+			0,
+			sizeof(struct linux64_dcache_model)
+		);
+	}
 }
 
 /*============================================================================*
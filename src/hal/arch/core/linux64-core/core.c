@@ -28,6 +28,28 @@
 #include <arch/core/linux64.h>
 #include <nanvix/const.h>
 
+/**
+ * @brief Context of the underlying core.
+ */
+PUBLIC __thread struct linux64_core_context linux64_core_context = {
+	.coreid = -1,
+	.level = INTERRUPT_LEVEL_NONE,
+	.perf_monitors = { [0 ... (LINUX64_PERF_MONITORS_NUM - 1)] = -1 },
+};
+
+/**
+ * @brief Initializes the context of the underlying core.
+ */
+PUBLIC void linux64_core_context_setup(int coreid)
+{
+	linux64_core_context.coreid = coreid;
+	linux64_core_context.level = INTERRUPT_LEVEL_NONE;
+	linux64_core_context.masked = 0;
+	linux64_core_context.pending = 0;
+	for (int i = 0; i < LINUX64_PERF_MONITORS_NUM; i++)
+		linux64_core_context.perf_monitors[i] = -1;
+}
+
 /**
  * @brief Setup a core.
  */
@@ -36,6 +58,7 @@ PUBLIC void linux64_core_setup(void)
 	linux64_core_dcache_setup();
 	linux64_core_icache_setup();
 	linux64_excp_setup();
+	linux64_interrupts_setup();
 	linux64_interrupts_enable();
 	linux64_perf_setup();
 }
@@ -24,15 +24,10 @@
 
 #include <nanvix/hal/core/exception.h>
 #include <arch/core/linux64/ctx.h>
+#include <arch/core/linux64/core.h>
 #include <nanvix/const.h>
 #include <nanvix/hlib.h>
 
-/*
- * XXX This belongs to the Cluster AL. We should find a nicer
- * way of doing this ot avoid any possible circular dependency.
- */
-EXTERN int linux64_core_get_id(void);
-
 /**
  * @cond linux64
  *
@@ -57,14 +52,34 @@ PUBLIC struct exception_info exceptions[LINUX64_EXCP_NUM] = {
 
 /**
  * @brief Exception Handler called by the signal() function
+ *
+ * Memory faults are first handed to the emulated MMU, which either
+ * refills the TLB and retries the faulting access, or reports a page
+ * fault that the kernel may handle. The access is retried after the
+ * page fault handler returns, so a handler that does not map the
+ * page loops forever. Any other exception is fatal.
  */
-PRIVATE void linux64_excp_handler(int excpnum)
+PRIVATE void linux64_excp_handler(int excpnum, siginfo_t *info, void *uctx)
 {
+	int ret;
 	struct context ctx;
 	struct exception excp;
 
+	UNUSED(uctx);
+
 	excp.num = excpnum;
-	ctx.id = linux64_core_get_id();
+	excp.addr = (vaddr_t) info->si_addr;
+	ctx.id = linux64_core_context.coreid;
+
+	/* Fault in emulated memory. */
+	if ((excpnum == SIGSEGV) && ((ret = linux64_core_mmu_fault(excp.addr)) != -ENOENT))
+	{
+		/* Page fault. */
+		if (ret < 0)
+			do_exception(&excp, &ctx);
+
+		return;
+	}
 
 	do_exception(&excp, &ctx);
 
@@ -79,7 +94,7 @@ PRIVATE void linux64_excp_handler(int excpnum)
  */
 PRIVATE struct {
 	int num;
-	void (*handler)(int);
+	void (*handler)(int, siginfo_t *, void *);
 
 } linux64_signals[] = {
 	{ SIGFPE,  linux64_excp_handler },
@@ -92,11 +107,26 @@ PRIVATE struct {
 
 /**
  * @brief Setup the signals
+ *
+ * Exceptions are taken with every other signal blocked, so that no
+ * interrupt handler runs in between. Memory faults are not deferred
+ * though, because the kernel may touch emulated memory while handling
+ * a page fault.
  */
 PUBLIC void linux64_excp_setup(void)
 {
+	struct sigaction act;
+
+	kmemset(&act, 0, sizeof(struct sigaction));
+	act.sa_flags = SA_SIGINFO | SA_NODEFER;
+	sigfillset(&act.sa_mask);
+	sigdelset(&act.sa_mask, SIGSEGV);
+
 	for (int i = 0; linux64_signals[i].num != -1; i++)
-		KASSERT(signal(linux64_signals[i].num, linux64_signals[i].handler) != SIG_ERR);
+	{
+		act.sa_sigaction = linux64_signals[i].handler;
+		KASSERT(sigaction(linux64_signals[i].num, &act, NULL) == 0);
+	}
 }
 
 /**
@@ -24,12 +24,10 @@
 
 #include <nanvix/hal/core/interrupt.h>
 #include <arch/core/linux64/int.h>
+#include <arch/core/linux64/core.h>
 #include <nanvix/const.h>
-
-/**
- * @brief Current level. 
- */
-PRIVATE int current_it_level = INTERRUPT_LEVEL_NONE;
+#include <nanvix/hlib.h>
+#include <pthread.h>
 
 /**
  * @brief Generic handler of an interrupt
@@ -49,7 +47,18 @@ PRIVATE void linux64_do_interrupt(int intnum)
  */
 PRIVATE int linux64_int_signals[] = {
 	SIGALRM,
-    SIGINT,
+	SIGINT,
+	LINUX64_INT_IPI,
+	LINUX64_INT_TIMER,
+	-1
+};
+
+/**
+ * @brief Interrupts that come from outside of the cluster.
+ */
+PRIVATE int linux64_int_external[] = {
+	SIGALRM,
+	SIGINT,
 	-1
 };
 
@@ -66,14 +75,118 @@ PUBLIC void (*interrupt_handlers[LINUX64_INT_MAX_NUM])(int) = {
 };
 
 /**
- * @brief Enable all the interrupts.
+ * @brief Bit of an interrupt in the per-core masks.
  */
-PUBLIC void linux64_interrupts_enable(void)
+#define LINUX64_INT_BIT(intnum) (1ULL << (intnum))
+
+/**
+ * @brief Gets the interrupts that the underlying core may take.
+ *
+ * @returns The interrupts that are neither masked nor disabled by
+ * the current interrupt level of the underlying core.
+ */
+PRIVATE uint64_t linux64_interrupts_deliverable(void)
+{
+	uint64_t allowed;
+
+	switch (linux64_core_context.level)
+	{
+		/* INTERRUPT_LEVEL_LOW */
+		case 0:
+			allowed = ~0ULL;
+			break;
+
+		/**
+		 * INTERRUPT_LEVEL_HIGH:
+		 * INTERRUPT_LEVEL_MEDIUM:
+		 */
+		case 1:
+			allowed = ~LINUX64_INT_BIT(SIGINT);
+			break;
+
+		/* INTERRUPT_LEVEL_NONE */
+		default:
+			allowed = 0;
+			break;
+	}
+
+	return (allowed & ~linux64_core_context.masked);
+}
+
+/**
+ * @brief Host signal handler.
+ *
+ * @param signum Number of the signal.
+ *
+ * Interrupts that the underlying core may not take are not lost, but
+ * deferred until they are enabled again.
+ */
+PRIVATE void linux64_do_signal(int signum)
+{
+	if (!(linux64_interrupts_deliverable() & LINUX64_INT_BIT(signum)))
+	{
+		__atomic_or_fetch(&linux64_core_context.pending, LINUX64_INT_BIT(signum), __ATOMIC_RELAXED);
+		return;
+	}
+
+	do_interrupt(signum);
+}
+
+/**
+ * @brief Handles deferred interrupts that became deliverable.
+ */
+PRIVATE void linux64_interrupts_replay(void)
 {
+	int intnum;
+
+	/* Fast path. */
+	if (LIKELY(!(__atomic_load_n(&linux64_core_context.pending, __ATOMIC_RELAXED)
+			& linux64_interrupts_deliverable())))
+		return;
+
+	while ((intnum = linux64_interrupt_next()) != 0)
+		do_interrupt(intnum);
+}
+
+/**
+ * @brief Initializes interrupts in the underlying core.
+ *
+ * Signal dispositions are process-wide, so they are set once to a
+ * dispatcher that checks the state of the core that takes the
+ * signal. Interrupts that come from outside of the cluster are
+ * routed to the master core, which is the only one to leave them
+ * unblocked. Interrupt masking is then done without any syscall.
+ */
+PUBLIC void linux64_interrupts_setup(void)
+{
+	sigset_t set;
+	struct sigaction act;
+
+	kmemset(&act, 0, sizeof(struct sigaction));
+	act.sa_handler = linux64_do_signal;
+	act.sa_flags = SA_RESTART;
+	sigemptyset(&act.sa_mask);
+	for (int i = 0; linux64_int_signals[i] != -1; i++)
+		sigaddset(&act.sa_mask, linux64_int_signals[i]);
+
 	for (int i = 0; linux64_int_signals[i] != -1; i++)
-		signal(linux64_int_signals[i], do_interrupt);
+		KASSERT(sigaction(linux64_int_signals[i], &act, NULL) == 0);
+
+	sigemptyset(&set);
+	for (int i = 0; linux64_int_external[i] != -1; i++)
+		sigaddset(&set, linux64_int_external[i]);
 
-	current_it_level = INTERRUPT_LEVEL_LOW;
+	/* ID of the master core is zero. */
+	pthread_sigmask((linux64_core_context.coreid == 0) ? SIG_UNBLOCK : SIG_BLOCK, &set, NULL);
+}
+
+/**
+ * @brief Enable all the interrupts.
+ */
+PUBLIC void linux64_interrupts_enable(void)
+{
+	linux64_core_context.level = INTERRUPT_LEVEL_LOW;
+	linux64_interrupts_replay();
 }
 
 /**
@@ -81,10 +194,7 @@ PUBLIC void linux64_interrupts_enable(void)
  */
 PUBLIC void linux64_interrupts_disable(void)
 {
-	for (int i = 0; linux64_int_signals[i] != -1; i++)
-		signal(linux64_int_signals[i], NULL);
-
-	current_it_level = INTERRUPT_LEVEL_NONE;
+	linux64_core_context.level = INTERRUPT_LEVEL_NONE;
 }
 
 /**
@@ -92,7 +202,7 @@ PUBLIC void linux64_interrupts_disable(void)
  */
 PUBLIC int linux64_interrupts_get_level(void)
 {
-	return (current_it_level);
+	return (linux64_core_context.level);
 }
 
 /**
@@ -105,35 +215,12 @@ PUBLIC int linux64_interrupts_set_level(int newlevel)
 	if (newlevel < INTERRUPT_LEVEL_LOW || newlevel > INTERRUPT_LEVEL_NONE)
 		return (-EINVAL);
 
-	oldlevel = current_it_level;
+	oldlevel = linux64_core_context.level;
+	linux64_core_context.level = newlevel;
 
-	switch (newlevel)
-	{
-		/* INTERRUPT_LEVEL_HIGH */
-		case 0:
-		{
-			linux64_interrupts_enable();
-		} break;
-
-		/**
-		 * INTERRUPT_LEVEL_HIGH:
-		 * INTERRUPT_LEVEL_MEDIUM:
-		 */
-		case 1:
-		{
-
-			/* Disable SIGINT interrupt. */
-			signal(linux64_int_signals[1], NULL);
-
-			current_it_level = newlevel;
-		} break;
-
-		/* INTERRUPT_LEVEL_NONE */
-		default:
-		{
-			linux64_interrupts_disable();
-		} break;
-	}
+	/* Some deferred interrupts may be deliverable now. */
+	if (newlevel < oldlevel)
+		linux64_interrupts_replay();
 
 	return (oldlevel);
 }
@@ -147,9 +234,11 @@ PUBLIC int linux64_interrupts_set_level(int newlevel)
  */
 PUBLIC int linux64_interrupt_mask(int intnum)
 {
-	if (signal(intnum, NULL) == SIG_ERR)
+	if (!WITHIN(intnum, 0, LINUX64_INT_MAX_NUM))
 		return (-EINVAL);
 
+	linux64_core_context.masked |= LINUX64_INT_BIT(intnum);
+
 	return (0);
 }
 
@@ -162,27 +251,33 @@ PUBLIC int linux64_interrupt_mask(int intnum)
  */
 PUBLIC int linux64_interrupt_unmask(int intnum)
 {
-	if (signal(intnum, do_interrupt) == SIG_ERR)
+	if (!WITHIN(intnum, 0, LINUX64_INT_MAX_NUM))
 		return (-EINVAL);
 
+	linux64_core_context.masked &= ~LINUX64_INT_BIT(intnum);
+	linux64_interrupts_replay();
+
 	return (0);
 }
 
 /**
  * @brief Give the next interrupt called while blocked.
  *
- * @return The number of the next interrupt OR a negative value if there is none.
+ * @return The number of the next interrupt OR zero if there is none.
  */
 PUBLIC int linux64_interrupt_next(void)
 {
-	sigset_t set;
-	sigpending(&set);
+	int intnum;
+	uint64_t ready;
 
-	for (int i = 0; linux64_int_signals[i] != -1; i++)
-	{
-		if (sigismember(&set, linux64_int_signals[i]))
-			return (linux64_int_signals[i]);
-	}
+	ready = __atomic_load_n(&linux64_core_context.pending, __ATOMIC_RELAXED)
+		& linux64_interrupts_deliverable();
+
+	if (!ready)
+		return (0);
+
+	intnum = __builtin_ctzll(ready);
+	__atomic_and_fetch(&linux64_core_context.pending, ~LINUX64_INT_BIT(intnum), __ATOMIC_RELAXED);
 
-	return (-EINVAL);
+	return (intnum);
 }
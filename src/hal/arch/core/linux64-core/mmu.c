@@ -48,6 +48,37 @@ PUBLIC int linux64_page_map(struct pte *pgtab, paddr_t paddr, vaddr_t vaddr, int
 	return (0);
 }
 
+/**
+ * @brief For a given page directory, addresses and permissions, maps a virtual
+ * address into a physical address by the specified page directory with the
+ * permissions required, using a single huge page. The page directory entry
+ * is flagged, so that it is not taken for a page table.
+ *
+ * @param pgdir Page directory to be used.
+ * @param paddr Physical address target.
+ * @param vaddr Virtual address to be mapped.
+ * @param w Write permission.
+ */
+PUBLIC int linux64_huge_page_map(struct pte *pgdir, paddr_t paddr, vaddr_t vaddr, int w)
+{
+	struct pde *pde;
+
+	if(pgdir == NULL)
+		return (-EINVAL);
+
+	/* Misaligned huge page. */
+	if ((paddr | vaddr) & (LINUX64_HUGE_PAGE_SIZE - 1))
+		return (-EINVAL);
+
+	pde = &((struct pde *) pgdir)[pde_idx_get(vaddr)];
+	pde->writable = (w) ? 1 : 0;
+	pde->huge = 1;
+	pde->present = 1;
+	pde->frame = LINUX64_FRAME(paddr >> LINUX64_PAGE_SHIFT);
+
+	return (0);
+}
+
 /**
  * @brief For a given page directory, addresses and permissions, maps a virtual
  * address into a physical address by the specified page directory with the
@@ -63,6 +94,7 @@ PUBLIC int linux64_pgtab_map(struct pde *pgdir, paddr_t paddr, vaddr_t vaddr)
 		return (-EINVAL);
 
 	int i = pde_idx_get(vaddr);
+	pgdir[i].huge = 0;
 	pgdir[i].present = 1;
 	pgdir[i].frame = LINUX64_FRAME(paddr >> LINUX64_PAGE_SHIFT);
 
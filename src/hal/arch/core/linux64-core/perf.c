@@ -27,6 +27,7 @@
 
 #include <arch/core/linux64/types.h>
 #include <arch/core/linux64/perf.h>
+#include <arch/core/linux64/core.h>
 #include <nanvix/hlib.h>
 #include <sys/ioctl.h>
 #include <syscall.h>
@@ -42,12 +43,6 @@ PRIVATE int perf_event_open(struct perf_event_attr *hw_event, pid_t pid, int cpu
 	return (syscall(__NR_perf_event_open, (linux64_dword_t) hw_event, pid, cpu, group_fd, flags));
 }
 
-/**
- * @Brief Array of File Descriptor containing the values of the counters
- */
-int linux64_perf_monitors[LINUX64_PERF_MONITORS_NUM];
-
-
 /**
  * @Brief Check if the perf and event values are valide
  */
@@ -70,7 +65,7 @@ PUBLIC int event_isvalid(int event)
 PUBLIC void linux64_perf_setup(void)
 {
 	for(int i = 0; i < LINUX64_PERF_MONITORS_NUM; i++)
-		linux64_perf_monitors[i] = -1;
+		linux64_core_context.perf_monitors[i] = -1;
 }
 
 /**
@@ -95,17 +90,17 @@ PUBLIC int linux64_perf_start(int perf, int event)
 	attr.disabled = 1;
 	attr.exclude_kernel = 1;
 	attr.exclude_hv = 1;
-	linux64_perf_monitors[perf] = perf_event_open(&attr,
+	linux64_core_context.perf_monitors[perf] = perf_event_open(&attr,
 												LINUX64_PERF_ARG1,
 												LINUX64_PERF_ARG2,
 												LINUX64_PERF_ARG3,
 												LINUX64_PERF_ARG4);
 
-	if (linux64_perf_monitors[perf] == -1)
+	if (linux64_core_context.perf_monitors[perf] == -1)
 		return (-EINVAL);
 
-	ioctl(linux64_perf_monitors[perf], PERF_EVENT_IOC_RESET, 0);
-	ioctl(linux64_perf_monitors[perf], PERF_EVENT_IOC_ENABLE, 0);
+	ioctl(linux64_core_context.perf_monitors[perf], PERF_EVENT_IOC_RESET, 0);
+	ioctl(linux64_core_context.perf_monitors[perf], PERF_EVENT_IOC_ENABLE, 0);
 	return (0);
 }
 
@@ -122,7 +117,7 @@ PUBLIC int linux64_perf_stop(int perf)
 	if (!perf_isvalid(perf))
 		return (-EINVAL);
 
-	ioctl(linux64_perf_monitors[perf], PERF_EVENT_IOC_DISABLE, 0);
+	ioctl(linux64_core_context.perf_monitors[perf], PERF_EVENT_IOC_DISABLE, 0);
 	return (0);
 }
 
@@ -139,7 +134,7 @@ PUBLIC int linux64_perf_restart(int perf)
 	if (!perf_isvalid(perf))
 		return (-1);
 
-	ioctl(linux64_perf_monitors[perf], PERF_EVENT_IOC_RESET, 0);
+	ioctl(linux64_core_context.perf_monitors[perf], PERF_EVENT_IOC_RESET, 0);
 	return (0);
 }
 
@@ -157,7 +152,7 @@ PUBLIC uint64_t linux64_perf_read(int perf)
 		return (-1);
 
 	uint64_t res = 0;
-	if (read(linux64_perf_monitors[perf], &res, sizeof(unsigned long)) < 1)
+	if (read(linux64_core_context.perf_monitors[perf], &res, sizeof(unsigned long)) < 1)
 		return (0);
 	else
 		return (res);
@@ -0,0 +1,182 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __NEED_CORE_LINUX64
+
+#include <arch/core/linux64.h>
+#include <arch/cluster/linux64-cluster/cores.h>
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+
+#if (__LINUX64_SPINLOCK == LINUX64_SPINLOCK_MCS)
+
+/**
+ * @brief Number of queue nodes per core.
+ *
+ * This bounds how many MCS locks a core may hold at once. The master
+ * core holds the lock of every slave core while the cluster boots,
+ * hence some headroom above the largest cluster.
+ */
+#define LINUX64_SPINLOCK_NODES_NUM (LINUX64_CLUSTER_NUM_CORES_MAX + 16)
+
+/**
+ * @brief Queue nodes of the underlying core.
+ */
+PRIVATE __thread struct linux64_spinlock_node linux64_spinlock_nodes[LINUX64_SPINLOCK_NODES_NUM];
+
+/**
+ * @brief Grabs a free queue node of the underlying core.
+ *
+ * @returns A free queue node.
+ */
+PRIVATE struct linux64_spinlock_node *linux64_spinlock_node_get(void)
+{
+	for (int i = 0; i < LINUX64_SPINLOCK_NODES_NUM; i++)
+	{
+		struct linux64_spinlock_node *node = &linux64_spinlock_nodes[i];
+
+		/* Exchange, as a signal handler may lock too. */
+		if (__atomic_exchange_n(&node->used, 1, __ATOMIC_ACQUIRE) == 0)
+		{
+			node->next = NULL;
+			node->locked = 1;
+			return (node);
+		}
+	}
+
+	kpanic("[hal][core] too many spinlocks held");
+
+	return (NULL);
+}
+
+/**
+ * @brief Releases a queue node.
+ *
+ * @param node Target queue node.
+ */
+PRIVATE void linux64_spinlock_node_put(struct linux64_spinlock_node *node)
+{
+	__atomic_store_n(&node->used, 0, __ATOMIC_RELEASE);
+}
+
+/*============================================================================*
+ * linux64_spinlock_lock()                                                    *
+ *============================================================================*/
+
+/**
+ * @see linux64_spinlock_lock().
+ */
+PUBLIC void linux64_spinlock_lock(linux64_spinlock_t *lock)
+{
+	unsigned spent = 0;
+	struct linux64_spinlock_node *node;
+	struct linux64_spinlock_node *pred;
+
+	node = linux64_spinlock_node_get();
+
+	/* Enqueue. */
+	pred = __atomic_exchange_n(&lock->tail, node, __ATOMIC_ACQ_REL);
+
+	/* Wait for our turn. */
+	if (pred != NULL)
+	{
+		__atomic_store_n(&pred->next, node, __ATOMIC_RELEASE);
+
+		while (__atomic_load_n(&node->locked, __ATOMIC_ACQUIRE))
+			linux64_spinlock_spin(1, &spent);
+	}
+
+	lock->holder = node;
+}
+
+/*============================================================================*
+ * linux64_spinlock_trylock()                                                 *
+ *============================================================================*/
+
+/**
+ * @see linux64_spinlock_trylock().
+ */
+PUBLIC int linux64_spinlock_trylock(linux64_spinlock_t *lock)
+{
+	struct linux64_spinlock_node *node;
+	struct linux64_spinlock_node *expected = NULL;
+
+	/* Held or contended. */
+	if (__atomic_load_n(&lock->tail, __ATOMIC_RELAXED) != NULL)
+		return (0);
+
+	node = linux64_spinlock_node_get();
+
+	if (!__atomic_compare_exchange_n(&lock->tail, &expected, node, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+	{
+		linux64_spinlock_node_put(node);
+		return (0);
+	}
+
+	lock->holder = node;
+
+	return (1);
+}
+
+/*============================================================================*
+ * linux64_spinlock_unlock()                                                  *
+ *============================================================================*/
+
+/**
+ * @see linux64_spinlock_unlock().
+ */
+PUBLIC void linux64_spinlock_unlock(linux64_spinlock_t *lock)
+{
+	unsigned spent = 0;
+	struct linux64_spinlock_node *node;
+	struct linux64_spinlock_node *next;
+
+	node = lock->holder;
+
+	next = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+
+	/* No known successor. */
+	if (next == NULL)
+	{
+		struct linux64_spinlock_node *expected = node;
+
+		/* Nobody waiting. */
+		if (__atomic_compare_exchange_n(&lock->tail, &expected, NULL, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+		{
+			linux64_spinlock_node_put(node);
+			return;
+		}
+
+		/* A successor is enqueueing itself. */
+		while ((next = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE)) == NULL)
+			linux64_spinlock_spin(1, &spent);
+	}
+
+	/* Hand over. */
+	__atomic_store_n(&next->locked, 0, __ATOMIC_RELEASE);
+	linux64_spinlock_node_put(node);
+}
+
+#endif /* __LINUX64_SPINLOCK == LINUX64_SPINLOCK_MCS */
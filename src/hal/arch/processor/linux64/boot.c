@@ -32,8 +32,10 @@
 /**
  * @todo TODO: provide a detailed description for this function.
  */
-PUBLIC int linux64_processor_boot(int nclusters)
+PUBLIC int linux64_processor_boot(int nclusters, int ncores, int affinity)
 {
+	int ret;
+
 	UNUSED(nclusters);
 
 	kprintf("[hal][processor] powering on...");
@@ -41,7 +43,14 @@ PUBLIC int linux64_processor_boot(int nclusters)
 	linux64_processor_clusters_boot();
 	linux64_processor_noc_boot();
 
-	return (linux64_cluster_boot());
+	/* Place cores on host CPUs. */
+	if ((ret = linux64_cluster_topology_boot(cluster_get_num(), ncores, affinity)) < 0)
+		return (ret);
+
+	/* Memory images are kept per cluster. */
+	linux64_cluster_memory_image_select(cluster_get_num());
+
+	return (linux64_cluster_boot(ncores));
 }
 
 /**
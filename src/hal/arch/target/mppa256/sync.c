@@ -961,6 +961,14 @@ again:
 				ret = (0);
 			} break;
 
+			/**
+			 * Hardware synchronization points only latch one signal
+			 * per source, thus signals cannot be accumulated.
+			 */
+			case MPPA256_SYNC_IOCTL_SET_COUNTING_MODE:
+				ret = (-ENOTSUP);
+				break;
+
 			default:
 				break;
 		}
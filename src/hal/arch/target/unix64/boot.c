@@ -36,11 +36,109 @@
  */
 PRIVATE struct
 {
-	int nclusters; /**< Number of Clusters */
+	int nclusters;      /**< Number of Clusters     */
+	int ncores;         /**< Number of Cores        */
+	int affinity;       /**< Placement of Cores     */
+	int mmu;            /**< MMU Mode               */
+	int tlb_length;     /**< Number of TLB Entries  */
+	int tlb_policy;     /**< TLB Replacement Policy */
+	int kmem;           /**< Kernel Memory (in KB)  */
+	int kpool;          /**< Kernel Pool (in KB)    */
+	int umem;           /**< User Memory (in KB)    */
+	int hugepages;      /**< Huge Page Backing      */
+	int dcache_size;    /**< Modeled D-Cache (KB)   */
+	int dcache_ways;    /**< Modeled D-Cache Ways   */
+	const char *memdir; /**< Memory Images          */
 } boot_args = {
-	1
+	1,
+	LINUX64_CLUSTER_NUM_CORES,
+	LINUX64_CLUSTER_AFFINITY_NONE,
+	LINUX64_CLUSTER_MMU_COSMETIC,
+	LINUX64_CLUSTER_TLB_LENGTH,
+	LINUX64_CLUSTER_TLB_FIFO,
+	LINUX64_KMEM_SIZE_DEFAULT/KB,
+	LINUX64_KPOOL_SIZE_DEFAULT/KB,
+	LINUX64_UMEM_SIZE_DEFAULT/KB,
+	LINUX64_CLUSTER_HUGEPAGES_NONE,
+	0,
+	LINUX64_DCACHE_MODEL_WAYS,
+	NULL
 };
 
+/**
+ * @brief Parses a placement policy.
+ *
+ * @param policy Name of the policy.
+ *
+ * @returns The placement policy named @p policy, or a negative
+ * error code if there is no such policy.
+ */
+PRIVATE int unix64_parse_affinity(const char *policy)
+{
+	if (!strcmp(policy, "none"))
+		return (LINUX64_CLUSTER_AFFINITY_NONE);
+	if (!strcmp(policy, "compact"))
+		return (LINUX64_CLUSTER_AFFINITY_COMPACT);
+
+	return (-EINVAL);
+}
+
+/**
+ * @brief Parses an MMU mode.
+ *
+ * @param mode Name of the mode.
+ *
+ * @returns The MMU mode named @p mode, or a negative error code if
+ * there is no such mode.
+ */
+PRIVATE int unix64_parse_mmu(const char *mode)
+{
+	if (!strcmp(mode, "cosmetic"))
+		return (LINUX64_CLUSTER_MMU_COSMETIC);
+	if (!strcmp(mode, "emulated"))
+		return (LINUX64_CLUSTER_MMU_EMULATED);
+
+	return (-EINVAL);
+}
+
+/**
+ * @brief Parses a TLB replacement policy.
+ *
+ * @param policy Name of the policy.
+ *
+ * @returns The replacement policy named @p policy, or a negative
+ * error code if there is no such policy.
+ */
+PRIVATE int unix64_parse_tlb_policy(const char *policy)
+{
+	if (!strcmp(policy, "fifo"))
+		return (LINUX64_CLUSTER_TLB_FIFO);
+	if (!strcmp(policy, "random"))
+		return (LINUX64_CLUSTER_TLB_RANDOM);
+
+	return (-EINVAL);
+}
+
+/**
+ * @brief Parses a huge page backing.
+ *
+ * @param backing Name of the backing.
+ *
+ * @returns The huge page backing named @p backing, or a negative
+ * error code if there is no such backing.
+ */
+PRIVATE int unix64_parse_hugepages(const char *backing)
+{
+	if (!strcmp(backing, "none"))
+		return (LINUX64_CLUSTER_HUGEPAGES_NONE);
+	if (!strcmp(backing, "thp"))
+		return (LINUX64_CLUSTER_HUGEPAGES_TRANSPARENT);
+	if (!strcmp(backing, "explicit"))
+		return (LINUX64_CLUSTER_HUGEPAGES_EXPLICIT);
+
+	return (-EINVAL);
+}
+
 /**
  * @brief Parses boot arguments.
  *
@@ -51,15 +149,57 @@ PRIVATE void unix64_parse_boot_args(int argc, const char **argv)
 {
 	for (int i = 1; i < argc; /* noop*/)
 	{
+		int *arg;
+
+		/* Parse argument. */
+		if (!strcmp(argv[i], "--nclusters"))
+			arg = &boot_args.nclusters;
+		else if (!strcmp(argv[i], "--ncores"))
+			arg = &boot_args.ncores;
+
+		else if (!strcmp(argv[i], "--affinity"))
+			arg = &boot_args.affinity;
+		else if (!strcmp(argv[i], "--mmu"))
+			arg = &boot_args.mmu;
+		else if (!strcmp(argv[i], "--tlb-length"))
+			arg = &boot_args.tlb_length;
+		else if (!strcmp(argv[i], "--tlb-policy"))
+			arg = &boot_args.tlb_policy;
+		else if (!strcmp(argv[i], "--kmem-size"))
+			arg = &boot_args.kmem;
+		else if (!strcmp(argv[i], "--kpool-size"))
+			arg = &boot_args.kpool;
+		else if (!strcmp(argv[i], "--umem-size"))
+			arg = &boot_args.umem;
+		else if (!strcmp(argv[i], "--hugepages"))
+			arg = &boot_args.hugepages;
+		else if (!strcmp(argv[i], "--dcache-size"))
+			arg = &boot_args.dcache_size;
+		else if (!strcmp(argv[i], "--dcache-ways"))
+			arg = &boot_args.dcache_ways;
+		else if (!strcmp(argv[i], "--memdir"))
+			arg = NULL;
+
 		/* Unkonwn argument. */
-		if (strcmp(argv[i], "--nclusters"))
+		else
 			exit(-EINVAL);
 
 		/* Missing argument. */
-		if ((i + 1) > argc)
+		if ((i + 1) >= argc)
 			exit(-EINVAL);
 
-		sscanf(argv[i + 1], "%d", &boot_args.nclusters);
+		if (arg == NULL)
+			boot_args.memdir = argv[i + 1];
+		else if (arg == &boot_args.affinity)
+			*arg = unix64_parse_affinity(argv[i + 1]);
+		else if (arg == &boot_args.mmu)
+			*arg = unix64_parse_mmu(argv[i + 1]);
+		else if (arg == &boot_args.tlb_policy)
+			*arg = unix64_parse_tlb_policy(argv[i + 1]);
+		else if (arg == &boot_args.hugepages)
+			*arg = unix64_parse_hugepages(argv[i + 1]);
+		else
+			sscanf(argv[i + 1], "%d", arg);
 
 		fprintf(stderr, "[unix64] argv[%d]: %s %s\n", i, argv[i], argv[i + 1]);
 
@@ -69,14 +209,36 @@ PRIVATE void unix64_parse_boot_args(int argc, const char **argv)
 	/* Bad argument. */
 	if ((boot_args.nclusters < 1) || (boot_args.nclusters > PROCESSOR_CLUSTERS_NUM))
 		exit(-EINVAL);
+	if ((boot_args.ncores < 1) || (boot_args.ncores > LINUX64_CLUSTER_NUM_CORES_MAX))
+		exit(-EINVAL);
+	if (boot_args.affinity < 0)
+		exit(-EINVAL);
+	if ((boot_args.kmem < 0) || (boot_args.kpool < 0) || (boot_args.umem < 0))
+		exit(-EINVAL);
+	if (linux64_cluster_mmu_configure(boot_args.mmu, boot_args.tlb_length, boot_args.tlb_policy) < 0)
+		exit(-EINVAL);
+	if (linux64_cluster_memory_configure(
+			(size_t) boot_args.kmem*KB,
+			(size_t) boot_args.kpool*KB,
+			(size_t) boot_args.umem*KB,
+			boot_args.hugepages) < 0)
+		exit(-EINVAL);
+	if ((boot_args.memdir != NULL) && (linux64_cluster_memory_persist(boot_args.memdir) < 0))
+		exit(-EINVAL);
+	if ((boot_args.dcache_size < 0) || (boot_args.dcache_ways < 0))
+		exit(-EINVAL);
+	if (linux64_core_dcache_model_configure((size_t) boot_args.dcache_size*KB, boot_args.dcache_ways) < 0)
+		exit(-EINVAL);
 }
 
 /**
  * @brief Powers on the underlying target.
  *
  * @param nclusters Number of clusters to power on.
+ * @param ncores    Number of cores to power on in each cluster.
+ * @param affinity  Placement policy for cores.
  */
-PRIVATE int unix64_boot(int nclusters)
+PRIVATE int unix64_boot(int nclusters, int ncores, int affinity)
 {
 	/*
 	 * Early initialization of Virtual
@@ -86,7 +248,7 @@ PRIVATE int unix64_boot(int nclusters)
 
 	kprintf("[hal][target] powering on...");
 
-	return (linux64_processor_boot(nclusters));
+	return (linux64_processor_boot(nclusters, ncores, affinity));
 }
 
 /**
@@ -119,7 +281,7 @@ int main(int argc, const char **argv)
 	unix64_parse_boot_args(argc, argv);
 
 	/* Boot processor. */
-	if ((error = unix64_boot(boot_args.nclusters)) < 0)
+	if ((error = unix64_boot(boot_args.nclusters, boot_args.ncores, boot_args.affinity)) < 0)
 		return (error);
 
 	unix64_setup();
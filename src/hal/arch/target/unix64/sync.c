@@ -31,10 +31,12 @@
 #include <nanvix/hal/resource.h>
 #include <nanvix/const.h>
 #include <nanvix/hlib.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <mqueue.h>
 #include <pthread.h>
 #include <fcntl.h>
+#include <unistd.h>
 #include <posix/errno.h>
 #include <stdio.h>
 
@@ -50,6 +52,16 @@
  */
 #define UNIX64_SYNC_BASENAME "nanvix-sync"
 
+/**
+ * @brief Name of shared signal counters.
+ */
+#define UNIX64_SYNC_COUNTERS_NAME "/nanvix-sync-counters"
+
+/**
+ * @brief Number of signal counters per node.
+ */
+#define UNIX64_SYNC_COUNTERS_MAX (2*UNIX64_SYNC_CREATE_MAX)
+
 struct hash
 {
 	uint64_t source    :  5;
@@ -61,6 +73,49 @@ struct hash
 
 #define HASH_INITIALIZER ((struct hash){-1, 0, -1, 0, 0})
 
+/**
+ * @brief Builds the key of the counter that matches a hash.
+ */
+#define HASH_KEY(hash) \
+	((1ULL << 63) | ((uint64_t) (hash)->type << 32) | (uint64_t) (hash)->nodeslist)
+
+/**
+ * @name Special Counter Keys
+ */
+/**@{*/
+#define UNIX64_SYNC_COUNTER_BUSY  (~0ULL)       /**< Counter is being reset. */
+#define UNIX64_SYNC_COUNTER_OWNED (1ULL << 62) /**< Receiver is attached.   */
+/**@}*/
+
+/**
+ * @brief Signal counter.
+ *
+ * Signals coalesce at the destination node in counters that live in
+ * shared memory, one counter per synchronization point and source
+ * node. Message queues only carry doorbells that wake up receivers,
+ * thus a sender never fails for lack of queue space. A sender claims
+ * the counter if the receiver has not created the synchronization
+ * point yet, and such orphaned counters are reclaimed once no free
+ * counter is left.
+ */
+struct counter
+{
+	uint64_t key;                               /**< Sync point key (zero if free). */
+	uint32_t nsignals[PROCESSOR_NOC_NODES_NUM]; /**< Signals posted by each source. */
+};
+
+/**
+ * @brief Signal counters.
+ */
+PRIVATE struct
+{
+	int shm;                                                      /**< Underlying file descriptor. */
+	struct counter (*nodes)[UNIX64_SYNC_COUNTERS_MAX];            /**< Counters of each node.      */
+} counters = {
+	.shm   = -1,
+	.nodes = NULL,
+};
+
 /**
  * @brief Synchronization point.
  */
@@ -86,6 +141,7 @@ PRIVATE struct
 		struct resource resource;               /**< Generic resource information. */
 
 		int nbarriers;                          /**< Number of barriers completed. */
+		int counting;                           /**< Counting mode?                */
 		struct hash hash;                       /**< Local sync hash.              */
 		struct hash barrier;                    /**< Barrier control.              */
 		int nreceived[PROCESSOR_NOC_NODES_NUM]; /**< Number of signals received.   */
@@ -110,6 +166,7 @@ PRIVATE struct
 	.rxs[0 ... (UNIX64_SYNC_CREATE_MAX - 1)] = {
 		.resource  = RESOURCE_STATIC_INITIALIZER,
 		.nbarriers = 0,
+		.counting  = 0,
 		.hash      = HASH_INITIALIZER,
 		.barrier   = HASH_INITIALIZER,
 		.nreceived = {0, },
@@ -233,6 +290,115 @@ PRIVATE int do_unix64_sync_search_tx(struct hash * hash)
 	return (-EINVAL);
 }
 
+/*============================================================================*
+ * do_unix64_sync_counter_reset()                                             *
+ *============================================================================*/
+
+/**
+ * @brief Resets a signal counter.
+ *
+ * @param counter  Target counter.
+ * @param expected Expected key of the counter.
+ * @param key      New key of the counter.
+ *
+ * @returns One if the counter was reset, and zero otherwise.
+ *
+ * @note The counter is marked as busy while it is being reset, thus
+ * no concurrent claimer sees signals of a former owner.
+ */
+PRIVATE int do_unix64_sync_counter_reset(struct counter *counter, uint64_t expected, uint64_t key)
+{
+	if (!__atomic_compare_exchange_n(&counter->key, &expected, UNIX64_SYNC_COUNTER_BUSY, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+		return (0);
+
+	for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; ++i)
+		__atomic_store_n(&counter->nsignals[i], 0, __ATOMIC_RELAXED);
+
+	__atomic_store_n(&counter->key, key, __ATOMIC_RELEASE);
+
+	return (1);
+}
+
+/*============================================================================*
+ * do_unix64_sync_counter_get()                                               *
+ *============================================================================*/
+
+/**
+ * @brief Gets the signal counter of a synchronization point.
+ *
+ * @param nodenum Number of the destination node.
+ * @param hash    Hash of the target synchronization point.
+ * @param claim   Claim a free counter if none matches?
+ *
+ * @returns Upon successful completion, a pointer to the target
+ * counter is returned. Otherwise, NULL is returned instead.
+ *
+ * @note If no counter is free, one that has no receiver attached is
+ * reclaimed. Such counters hold signals that were sent to
+ * synchronization points that were unlinked or not created yet.
+ */
+PRIVATE struct counter *do_unix64_sync_counter_get(
+	int nodenum,
+	const struct hash *hash,
+	int claim
+)
+{
+	uint64_t key;           /* Counter key.         */
+	uint64_t current;       /* Current key.         */
+	struct counter *table; /* Counters of the node. */
+
+	key   = HASH_KEY(hash);
+	table = counters.nodes[nodenum];
+
+again:
+	for (int i = 0; i < UNIX64_SYNC_COUNTERS_MAX; ++i)
+	{
+		current = __atomic_load_n(&table[i].key, __ATOMIC_ACQUIRE);
+
+		if ((current & ~UNIX64_SYNC_COUNTER_OWNED) == key)
+			return (&table[i]);
+	}
+
+	if (!claim)
+		return (NULL);
+
+	/* Claim a free counter. */
+	for (int i = 0; i < UNIX64_SYNC_COUNTERS_MAX; ++i)
+	{
+		current = __atomic_load_n(&table[i].key, __ATOMIC_ACQUIRE);
+
+		/* Being reset, maybe for us. */
+		if (current == UNIX64_SYNC_COUNTER_BUSY)
+			goto again;
+
+		/* Claimed by a concurrent sender. */
+		if ((current & ~UNIX64_SYNC_COUNTER_OWNED) == key)
+			return (&table[i]);
+
+		if ((current == 0) && do_unix64_sync_counter_reset(&table[i], 0, key))
+			return (&table[i]);
+	}
+
+	/* Reclaim an orphaned counter. */
+	for (int i = 0; i < UNIX64_SYNC_COUNTERS_MAX; ++i)
+	{
+		current = __atomic_load_n(&table[i].key, __ATOMIC_ACQUIRE);
+
+		if ((current == 0) || (current == UNIX64_SYNC_COUNTER_BUSY))
+			goto again;
+
+		if (current & UNIX64_SYNC_COUNTER_OWNED)
+			continue;
+
+		if (do_unix64_sync_counter_reset(&table[i], current, key))
+			return (&table[i]);
+
+		goto again;
+	}
+
+	return (NULL);
+}
+
 /*============================================================================*
  * unix64_sync_create()                                                       *
  *============================================================================*/
@@ -246,8 +412,11 @@ PRIVATE int do_unix64_sync_search_tx(struct hash * hash)
  */
 PUBLIC int unix64_sync_create(const int * nodes, int nnodes, int type)
 {
-	int syncid;       /* Synchronization point. */
-	struct hash hash; /* Synch point Hash.      */
+	int syncid;              /* Synchronization point. */
+	int attached;            /* Attached to counter?   */
+	uint64_t key;            /* Counter key.           */
+	struct hash hash;        /* Synch point Hash.      */
+	struct counter *counter; /* Signal counter.        */
 
 	unix64_sync_lock();
 
@@ -260,14 +429,30 @@ PUBLIC int unix64_sync_create(const int * nodes, int nnodes, int type)
 		if (do_unix64_sync_search_rx(&hash) >= 0)
 			goto error;
 
+		/* Signals posted before creation are kept in the counter. */
+		do
+		{
+			if ((counter = do_unix64_sync_counter_get(hash.source, &hash, 1)) == NULL)
+				goto error;
+
+			key = HASH_KEY(&hash);
+
+			/* Attach to the counter, unless it was reclaimed meanwhile. */
+			attached = __atomic_compare_exchange_n(&counter->key, &key, key | UNIX64_SYNC_COUNTER_OWNED, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+		} while (!attached);
+
 		/* Allocate a synchronization point. */
 		if ((syncid = resource_alloc(&pool.rx)) < 0)
+		{
+			do_unix64_sync_counter_reset(counter, key | UNIX64_SYNC_COUNTER_OWNED, 0);
 			goto error;
+		}
 
 		/* Initialize synchronization point. */
 		synctab.rxs[syncid].hash      = hash;
 		synctab.rxs[syncid].barrier   = HASH_INITIALIZER;
 		synctab.rxs[syncid].nbarriers = 0;
+		synctab.rxs[syncid].counting  = 0;
 		kmemset(synctab.rxs[syncid].nreceived, 0, PROCESSOR_NOC_NODES_NUM * sizeof(int));
 
 		resource_set_rdonly(&synctab.rxs[syncid].resource);
@@ -346,6 +531,8 @@ error:
  */
 PUBLIC int unix64_sync_unlink(int syncid)
 {
+	struct counter *counter; /* Signal counter. */
+
 	syncid -= UNIX64_SYNC_CREATE_OFFSET;
 
 again:
@@ -366,8 +553,13 @@ again:
 			goto again;
 		}
 
+		/* Drop stale signals and release the counter. */
+		if ((counter = do_unix64_sync_counter_get(synctab.rxs[syncid].hash.source, &synctab.rxs[syncid].hash, 0)) != NULL)
+			do_unix64_sync_counter_reset(counter, HASH_KEY(&synctab.rxs[syncid].hash) | UNIX64_SYNC_COUNTER_OWNED, 0);
+
 		synctab.rxs[syncid].hash    = HASH_INITIALIZER;
 		synctab.rxs[syncid].barrier = HASH_INITIALIZER;
+		kmemset(synctab.rxs[syncid].nreceived, 0, PROCESSOR_NOC_NODES_NUM * sizeof(int));
 
 		resource_free(&pool.rx, syncid);
 
@@ -503,104 +695,164 @@ PRIVATE void unix64_sync_barrier_reset(struct rx * rx)
  * unix64_sync_barrier_consume()                                              *
  *============================================================================*/
 
-PRIVATE int unix64_sync_barrier_consume(struct rx * rx)
+PRIVATE int unix64_sync_barrier_consume(struct rx * rx, int nsignals)
 {
 	int consumed; /* Indicates if the barrier is consumed. */
 
 	unix64_sync_lock();
 
-		consumed = rx->nbarriers;
+		consumed = (rx->nbarriers >= nsignals);
 
-		/* Is the barrier complete? */
+		/* Are enough barriers complete? */
 		if (consumed)
-			rx->nbarriers--;
+			rx->nbarriers -= nsignals;
 
 	unix64_sync_unlock();
 
 	return (consumed);
 }
 
+/*============================================================================*
+ * do_unix64_sync_deliver()                                                   *
+ *============================================================================*/
+
+/**
+ * @brief Delivers signals to a synchronization point.
+ *
+ * @param rx       Target receiver.
+ * @param source   Source node of the signals.
+ * @param nsignals Number of signals.
+ *
+ * @note The sync module lock must be held.
+ */
+PRIVATE void do_unix64_sync_deliver(struct rx * rx, int source, int nsignals)
+{
+	/* Counting mode: every signal is accounted on its own. */
+	if (rx->counting)
+	{
+		rx->nbarriers += nsignals;
+		return;
+	}
+
+	rx->barrier.nodeslist |= (1 << source);
+	rx->nreceived[source] += nsignals;
+
+	while (unix64_sync_barrier_is_complete(rx))
+	{
+		unix64_sync_barrier_reset(rx);
+		rx->nbarriers++;
+	}
+}
+
+/*============================================================================*
+ * do_unix64_sync_harvest()                                                   *
+ *============================================================================*/
+
+/**
+ * @brief Collects coalesced signals of all local synchronization points.
+ *
+ * @note The sync module lock must be held.
+ */
+PRIVATE void do_unix64_sync_harvest(void)
+{
+	for (int i = 0; i < UNIX64_SYNC_CREATE_MAX; ++i)
+	{
+		struct counter *counter;
+
+		if (!resource_is_used(&synctab.rxs[i].resource))
+			continue;
+
+		counter = do_unix64_sync_counter_get(
+			synctab.rxs[i].hash.source,
+			&synctab.rxs[i].hash,
+			0
+		);
+
+		if (counter == NULL)
+			continue;
+
+		for (int j = 0; j < PROCESSOR_NOC_NODES_NUM; ++j)
+		{
+			uint32_t nsignals;
+
+			nsignals = __atomic_exchange_n(&counter->nsignals[j], 0, __ATOMIC_ACQ_REL);
+
+			if (nsignals > 0)
+				do_unix64_sync_deliver(&synctab.rxs[i], j, nsignals);
+		}
+	}
+}
+
 /*============================================================================*
  * do_unix64_sync_wait()                                                      *
  *============================================================================*/
 
 /**
- * @brief Waits for a signal.
+ * @brief Waits for signals.
  *
- * @param syncid ID of the target sync.
- * @param sig    Place where the received signal should be stored.
+ * @param rx       Target receiver.
+ * @param nsignals Number of signals to consume.
  *
  * @returns Upon successful completion, zero is returned. Upon
- * failure, a negative error code is returned instead.
+ * failure, a negative error code is returned instead. A positive
+ * number is returned if the caller should wait again.
  */
-PRIVATE int do_unix64_sync_wait(struct rx * rx)
+PRIVATE int do_unix64_sync_wait(struct rx * rx, int nsignals)
 {
-	int syncid;       /* Synchronization point. */
-	struct hash hash; /* Hash buffer.           */
+	struct hash hash; /* Hash buffer. */
 
 	/* Is the previous wait released me? */
-	if (unix64_sync_barrier_consume(rx))
+	if (unix64_sync_barrier_consume(rx, nsignals))
 		return (0);
 
-	spinlock_lock(&lock_wait);
+	pthread_mutex_lock(&lock_wait);
+
+		/* Collects signals that have already coalesced. */
+		unix64_sync_lock();
+			do_unix64_sync_harvest();
+		unix64_sync_unlock();
 
 		/* Is other core released me? */
-		if (unix64_sync_barrier_consume(rx))
+		if (unix64_sync_barrier_consume(rx, nsignals))
 		{
-			spinlock_unlock(&lock_wait);
+			pthread_mutex_unlock(&lock_wait);
 			return (0);
 		}
 
-		/* Reads a signal. */ 
+		/* Waits for a doorbell. */
 		if (mq_receive(mqueues[rx->hash.source].fd, (char *) &hash, sizeof(struct hash), NULL) == -1)
 		{
-			spinlock_unlock(&lock_wait);
+			pthread_mutex_unlock(&lock_wait);
 			return (-EAGAIN);
 		}
 
-		unix64_sync_lock();
-
-			if (!node_is_valid(hash.source))
-			{
-				do_unix64_sync_ignore_signal("Invalid source.", &hash);
-				goto release;
-			}
-
-			if ((syncid = do_unix64_sync_search_rx(&hash)) < 0)
-			{
-				do_unix64_sync_ignore_signal("Sync point not found.", &hash);
-				goto release;
-			}
-
-			synctab.rxs[syncid].barrier.nodeslist |= (1 << hash.source);
-			synctab.rxs[syncid].nreceived[hash.source]++;
-
-			if (unix64_sync_barrier_is_complete(&synctab.rxs[syncid]))
-			{
-				unix64_sync_barrier_reset(&synctab.rxs[syncid]);
-				synctab.rxs[syncid].nbarriers++;
-			}
+		if (!node_is_valid(hash.source))
+			do_unix64_sync_ignore_signal("Invalid source.", &hash);
 
-release:
+		unix64_sync_lock();
+			do_unix64_sync_harvest();
 		unix64_sync_unlock();
-	spinlock_unlock(&lock_wait);
+	pthread_mutex_unlock(&lock_wait);
 
 	/* Do again. */
 	return (1);
 }
 
 /*============================================================================*
- * unix64_sync_wait()                                                         *
+ * unix64_sync_wait_n()                                                       *
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * The unix64_sync_wait_n() function waits until @p nsignals signals
+ * are pending on the synchronization point @p syncid, and then
+ * consumes all of them at once. In counting mode, each received
+ * signal is a pending signal. Otherwise, each completed barrier is.
  *
  * @note This function is blocking.
  * @note This function is thread-safe.
  * @note This function is reentrant.
  */
-PUBLIC int unix64_sync_wait(int syncid)
+PUBLIC int unix64_sync_wait_n(int syncid, int nsignals)
 {
 	int ret;
 
@@ -624,9 +876,9 @@ again:
 			goto again;
 		}
 
-		if (synctab.rxs[syncid].nbarriers)
+		if (synctab.rxs[syncid].nbarriers >= nsignals)
 		{
-			synctab.rxs[syncid].nbarriers--;
+			synctab.rxs[syncid].nbarriers -= nsignals;
 			goto exit;
 		}
 
@@ -638,7 +890,7 @@ again:
 	 */
 	unix64_sync_unlock();
 
-	while ((ret = do_unix64_sync_wait(&synctab.rxs[syncid])) > 0);
+	while ((ret = do_unix64_sync_wait(&synctab.rxs[syncid], nsignals)) > 0);
 
 	unix64_sync_lock();
 		resource_set_notbusy(&synctab.rxs[syncid].resource);
@@ -648,6 +900,60 @@ exit:
 	return ((ret != 0) ? (-EAGAIN) : (0));
 }
 
+/*============================================================================*
+ * unix64_sync_wait()                                                         *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ *
+ * @note This function is blocking.
+ * @note This function is thread-safe.
+ * @note This function is reentrant.
+ */
+PUBLIC int unix64_sync_wait(int syncid)
+{
+	return (unix64_sync_wait_n(syncid, 1));
+}
+
+/*============================================================================*
+ * unix64_sync_npending()                                                     *
+ *============================================================================*/
+
+/**
+ * The unix64_sync_npending() function collects signals that have
+ * already coalesced at the local node and returns the number of
+ * signals that may be consumed from the synchronization point
+ * @p syncid without blocking.
+ *
+ * @note This function is non-blocking.
+ * @note This function is thread-safe.
+ * @note This function is reentrant.
+ */
+PUBLIC int unix64_sync_npending(int syncid)
+{
+	int npending; /* Pending signals. */
+
+	syncid -= UNIX64_SYNC_CREATE_OFFSET;
+
+	unix64_sync_lock();
+
+		do_unix64_sync_harvest();
+
+		/* Bad sync. */
+		if (!resource_is_used(&synctab.rxs[syncid].resource))
+		{
+			unix64_sync_unlock();
+			return (-EBADF);
+		}
+
+		npending = synctab.rxs[syncid].nbarriers;
+
+	unix64_sync_unlock();
+
+	return (npending);
+}
+
 /*============================================================================*
  * unix64_sync_signal()                                                       *
  *============================================================================*/
@@ -658,10 +964,14 @@ exit:
  * @param i      Initial node ID.
  * @param nnodes Number of nodes.
  * @param nodes  Node IDs.
+ * @param sent   Nodes that have already been signaled.
  * @param hash   Message.
  *
  * @returns Upon successful completion, zero is returned. Upon
  * failure, a negative error code is returned instead.
+ *
+ * @note Nodes that were signaled by a previous partial broadcast
+ * are skipped.
  */
 PRIVATE inline int do_unix64_sync_signal(
 	int i,
@@ -671,46 +981,32 @@ PRIVATE inline int do_unix64_sync_signal(
 	const struct hash * hash
 )
 {
-	int ret;        /* Return value.    */
-	int ntries = 5; /* Number of tries. */
-
 	for (; i < nnodes; ++i)
 	{
+		struct counter *counter;
+
 		if (sent[i])
 			continue;
 
-		do
-		{
-			struct timespec tm;
-
-			if (ntries-- == 0)
-			{
-				ret = (-ETIMEDOUT);
-				goto error;
-			}
-
-			clock_gettime(CLOCK_REALTIME, &tm);
-			tm.tv_sec += 1;
-
-			if (mq_timedsend(mqueues[nodes[i]].fd, (char *) hash, sizeof(struct hash), 1, &tm) == -1)
-			{
-				if (errno == EAGAIN)
-					continue;
-
-				ret = (-EAGAIN);
-				goto error;
-			}
+		/* Out of counters. */
+		if ((counter = do_unix64_sync_counter_get(nodes[i], hash, 1)) == NULL)
+			return (-EAGAIN);
 
-			sent[i] = 1;
-			break;
+		__atomic_fetch_add(&counter->nsignals[hash->source], 1, __ATOMIC_ACQ_REL);
+		sent[i] = 1;
 
-		} while (1);
+		/*
+		 * Rings the doorbell. If the queue is full, there are pending
+		 * doorbells that will make the receiver collect this signal.
+		 */
+		if (mq_send(mqueues[nodes[i]].fd, (char *) hash, sizeof(struct hash), 1) == -1)
+		{
+			if (errno != EAGAIN)
+				return (-EAGAIN);
+		}
 	}
 
-	ret = 0;
-
-error:
-	return (ret);
+	return (0);
 }
 
 /**
@@ -809,9 +1105,6 @@ PUBLIC int unix64_sync_ioctl(int syncid, unsigned request, va_list args)
 {
 	int ret = (-EINVAL); /* Return value. */
 
-	UNUSED(syncid);
-	UNUSED(args);
-
 	unix64_sync_lock();
 
 		switch (request)
@@ -825,6 +1118,39 @@ PUBLIC int unix64_sync_ioctl(int syncid, unsigned request, va_list args)
 				ret = (0);
 			} break;
 
+			case UNIX64_SYNC_IOCTL_SET_COUNTING_MODE:
+			{
+				struct rx *rx;
+
+				/* Only receivers accumulate signals. */
+				if (!WITHIN(syncid, UNIX64_SYNC_CREATE_OFFSET, UNIX64_SYNC_CREATE_OFFSET + UNIX64_SYNC_CREATE_MAX))
+				{
+					ret = (-EBADF);
+					break;
+				}
+
+				rx = &synctab.rxs[syncid - UNIX64_SYNC_CREATE_OFFSET];
+
+				/* Bad sync. */
+				if (!resource_is_used(&rx->resource))
+				{
+					ret = (-EBADF);
+					break;
+				}
+
+				do_unix64_sync_harvest();
+
+				/* Switching modes with a partial barrier would lose signals. */
+				if (resource_is_busy(&rx->resource) || (rx->barrier.nodeslist != 0))
+				{
+					ret = (-EBUSY);
+					break;
+				}
+
+				rx->counting = (va_arg(args, int) != 0);
+				ret          = (0);
+			} break;
+
 			default:
 				break;
 		}
@@ -847,9 +1173,43 @@ PUBLIC int unix64_sync_ioctl(int syncid, unsigned request, va_list args)
 PUBLIC void unix64_sync_setup(void)
 {
 	int local;
+	void *p;
+	size_t counters_sz = PROCESSOR_NOC_NODES_NUM*sizeof(*counters.nodes);
 
 	local = processor_node_get_num();
 
+	/* Open signal counters. */
+	KASSERT((counters.shm =
+		shm_open(UNIX64_SYNC_COUNTERS_NAME,
+			O_RDWR | O_CREAT,
+			S_IRUSR | S_IWUSR)
+		) != -1
+	);
+
+	/* Newly allocated counters are zero-filled. */
+	KASSERT(ftruncate(counters.shm, counters_sz) != -1);
+
+	KASSERT((p =
+		mmap(NULL,
+			counters_sz,
+			PROT_READ | PROT_WRITE,
+			MAP_SHARED,
+			counters.shm,
+			0)
+		) != MAP_FAILED
+	);
+	counters.nodes = p;
+
+	/*
+	 * Counters may outlive a crashed run, so the master cluster,
+	 * which boots first and unlinks them at shutdown, resets them.
+	 */
+	if (cluster_get_num() == PROCESSOR_CLUSTERNUM_MASTER)
+	{
+		kmemset(counters.nodes, 0, counters_sz);
+		__atomic_thread_fence(__ATOMIC_RELEASE);
+	}
+
 	/* Build pathname for NoC connector. */
 	sprintf(mqueues[local].pathname, "/%s-%d", UNIX64_SYNC_BASENAME, local);
 
@@ -908,6 +1268,13 @@ PUBLIC void unix64_sync_shutdown(void)
 
 		KASSERT(mq_close(mqueues[i].fd) == 0);
 	}
+
+	KASSERT(munmap(counters.nodes, PROCESSOR_NOC_NODES_NUM*sizeof(*counters.nodes)) != -1);
+	KASSERT(close(counters.shm) != -1);
+
+	/* Unlink signal counters. */
+	if (cluster_get_num() == PROCESSOR_CLUSTERNUM_MASTER)
+		shm_unlink(UNIX64_SYNC_COUNTERS_NAME);
 }
 
 #endif /* !__NANVIX_IKC_USES_ONLY_MAILBOX */
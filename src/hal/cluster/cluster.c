@@ -83,11 +83,6 @@ PUBLIC void cluster_fence_wait(void)
  * Cores Management                                                           *
  *============================================================================*/
 
-/**
- * @brief Number of core start trials.
- */
-#define CORE_START_NTRIALS 10
-
 /*----------------------------------------------------------------------------*
  * core_idle()                                                                *
  *----------------------------------------------------------------------------*/
@@ -104,9 +99,14 @@ PUBLIC void cluster_fence_wait(void)
  */
 PUBLIC void core_idle(void)
 {
+		int starter;
 		int coreid = core_get_id();
 
 		cores[coreid].state = CORE_IDLE;
+
+		/* Hand off this core to a core that waits to start it. */
+		starter = cores[coreid].starter;
+		cores[coreid].starter = -1;
 		dcache_invalidate();
 
 		/*
@@ -117,9 +117,14 @@ PUBLIC void core_idle(void)
 
 	spinlock_unlock(&cores[coreid].lock);
 
+	if (starter >= 0)
+		event_notify(starter);
+
 	interrupts_set_level(INTERRUPT_LEVEL_LOW);
 	interrupt_unmask(INTERRUPT_IPI);
 
+	timer_tickless_enter();
+
 	while (true)
 	{
 		spinlock_lock(&cores[coreid].lock);
@@ -138,6 +143,8 @@ PUBLIC void core_idle(void)
 
 		event_wait();
 	}
+
+	timer_tickless_exit();
 }
 
 /*----------------------------------------------------------------------------*
@@ -167,6 +174,8 @@ PUBLIC void core_sleep(void)
 		state = cores[coreid].state;
 	spinlock_unlock(&cores[coreid].lock);
 
+	timer_tickless_enter();
+
 	while (true)
 	{
 		spinlock_lock(&cores[coreid].lock);
@@ -192,6 +201,8 @@ PUBLIC void core_sleep(void)
 
 		event_wait();
 	}
+
+	timer_tickless_exit();
 }
 
 /*----------------------------------------------------------------------------*
@@ -256,14 +267,14 @@ PUBLIC int core_wakeup(int coreid)
  */
 PUBLIC int core_start(int coreid, void (*start)(void))
 {
-	int ntrials = 0;
+	int mycoreid;
 
 	/* Invalid core. */
 	if ((coreid < 0) || (coreid >= CORES_NUM))
 		return (-EINVAL);
 
 	/* Bad core. */
-	if (coreid == core_get_id())
+	if (coreid == (mycoreid = core_get_id()))
 		return (-EINVAL);
 
 	/* Bad start routine. */
@@ -275,23 +286,24 @@ again:
 	spinlock_lock(&cores[coreid].lock);
 	dcache_invalidate();
 
-		/* Wait for resetting state. */
-		if (cores[coreid].state == CORE_ZOMBIE)
+		/*
+		 * Wait for reset. The target core hands
+		 * itself off to us once it gets idle, in
+		 * core_idle(), so we sleep instead of
+		 * spinning on its lock.
+		 */
+		if ((cores[coreid].state == CORE_ZOMBIE) || (cores[coreid].state == CORE_RESETTING))
 		{
-			spinlock_unlock(&cores[coreid].lock);
-			goto again;
-		}
+			/* Another core will start it. */
+			if ((cores[coreid].starter >= 0) && (cores[coreid].starter != mycoreid))
+				goto error;
 
-		/* Wait for reset. */
-		if (cores[coreid].state == CORE_RESETTING)
-		{
+			cores[coreid].starter = mycoreid;
+			dcache_invalidate();
 			spinlock_unlock(&cores[coreid].lock);
 
-			if (ntrials++ < CORE_START_NTRIALS)
-				goto again;
-
-			kprintf("[hal][cluster] failed to start core");
-			goto error;
+			event_wait();
+			goto again;
 		}
 
 		/* Wakeup target core. */
@@ -302,15 +314,15 @@ again:
 			cores[coreid].wakeups = 0;
 			dcache_invalidate();
 
-			event_notify(coreid);
-
 			spinlock_unlock(&cores[coreid].lock);
+
+			event_notify(coreid);
 			return (0);
 		}
 
+error:
 	spinlock_unlock(&cores[coreid].lock);
 
-error:
 	return (-EBUSY);
 }
 
@@ -323,7 +335,9 @@ error:
  * underlying core, by calling the starting routine which was
  * previously registered with core_wakeup(). Furthermore, in the
  * first call ever made to core_run(), architectural structures of
- * the underlying core are initialized.
+ * the underlying core are initialized. If the starting routine
+ * returns, the lock of the underlying core is held on return, as
+ * it is after core_reset().
  *
  * @see core_idle(), core_start().
  *
@@ -346,6 +360,13 @@ PUBLIC void core_run(void)
 	spinlock_unlock(&cores[coreid].lock);
 
 	cores[coreid].start();
+
+	/*
+	 * The starting routine returned without
+	 * resetting the core, so acquire the lock
+	 * that core_idle() expects to release.
+	 */
+	spinlock_lock(&cores[coreid].lock);
 }
 
 /*----------------------------------------------------------------------------*
@@ -31,14 +31,27 @@
 #include <nanvix/const.h>
 #include <nanvix/hlib.h>
 
+/**
+ * @brief Number of bits in a word of an event bitmap.
+ */
+#define EVENTS_WORD_BITS (8*sizeof(unsigned))
+
+/**
+ * @brief Number of words in an event bitmap.
+ */
+#define EVENTS_BITMAP_LENGTH ((CORES_NUM_MAX + EVENTS_WORD_BITS - 1)/EVENTS_WORD_BITS)
+
 /**
  * @brief Table of events.
+ *
+ * Each bitmap has one bit per sender core, so core IDs are not bounded
+ * by the width of a word.
  */
 PUBLIC struct events_table
 {
-	unsigned pending; /**< Pending Events  */
-	unsigned handled; /**< Handled Events  */
-} events[CORES_NUM];
+	unsigned pending[EVENTS_BITMAP_LENGTH]; /**< Pending Events  */
+	unsigned handled[EVENTS_BITMAP_LENGTH]; /**< Handled Events  */
+} events[CORES_NUM_MAX];
 
 /**
  * @brief Event system lock.
@@ -50,6 +63,55 @@ spinlock_t event_lock;
  */
 PRIVATE event_handler_t _event_handler = NULL;
 
+/**
+ * @brief Asserts whether or not a core is set in an event bitmap.
+ *
+ * @param bitmap Target bitmap.
+ * @param coreid ID of the target core.
+ */
+PRIVATE inline bool events_test(const unsigned *bitmap, int coreid)
+{
+	return (bitmap[coreid/EVENTS_WORD_BITS] & (1U << (coreid%EVENTS_WORD_BITS)));
+}
+
+/**
+ * @brief Sets a core in an event bitmap.
+ *
+ * @param bitmap Target bitmap.
+ * @param coreid ID of the target core.
+ */
+PRIVATE inline void events_set(unsigned *bitmap, int coreid)
+{
+	bitmap[coreid/EVENTS_WORD_BITS] |= (1U << (coreid%EVENTS_WORD_BITS));
+}
+
+/**
+ * @brief Clears a core in an event bitmap.
+ *
+ * @param bitmap Target bitmap.
+ * @param coreid ID of the target core.
+ */
+PRIVATE inline void events_clear(unsigned *bitmap, int coreid)
+{
+	bitmap[coreid/EVENTS_WORD_BITS] &= ~(1U << (coreid%EVENTS_WORD_BITS));
+}
+
+/**
+ * @brief Asserts whether or not any core is set in an event bitmap.
+ *
+ * @param bitmap Target bitmap.
+ */
+PRIVATE inline bool events_any(const unsigned *bitmap)
+{
+	for (unsigned i = 0; i < EVENTS_BITMAP_LENGTH; i++)
+	{
+		if (bitmap[i])
+			return (true);
+	}
+
+	return (false);
+}
+
 /*============================================================================*
  * event_handler()                                                            *
  *============================================================================*/
@@ -77,10 +139,10 @@ PRIVATE void event_handler(int ev_src)
 	/* Handle event. */
 	for (int i = 0; i < CORES_NUM; i++)
 	{
-		if (events[coreid].pending & (1 << i))
+		if (events_test(events[coreid].pending, i))
 		{
-			events[coreid].pending &= ~(1 << i);
-			events[coreid].handled |=  (1 << i);
+			events_clear(events[coreid].pending, i);
+			events_set(events[coreid].handled, i);
 
 			spinlock_unlock(&event_lock);
 				_event_handler();
@@ -147,11 +209,7 @@ PUBLIC int event_unregister_handler(void)
  */
 PUBLIC void event_setup(void)
 {
-	for (int i = 0; i < CORES_NUM; i++)
-	{
-		events[i].pending = 0;
-		events[i].handled = 0;
-	}
+	kmemset(events, 0, sizeof(events));
 
 	spinlock_init(&event_lock);
 
@@ -192,7 +250,7 @@ PUBLIC int event_notify(int coreid)
 	section_guard_entry(&guard);
 
 		/* Set the pending event flag. */
-		events[coreid].pending |= (1 << mycoreid);
+		events_set(events[coreid].pending, mycoreid);
 
 #if (CLUSTER_HAS_IPI)
 		cluster_ipi_send(coreid);
@@ -224,15 +282,18 @@ PUBLIC void event_drop(void)
 
 	section_guard_entry(&guard);
 
-		if (events[mycoreid].pending)
+		for (int i = 0; i < CORES_NUM; i++)
 		{
-			kprintf("[hal][cluster] core %d dropping events %x",
-				mycoreid,
-				events[mycoreid].pending
-			);
-		}
+			if (events_test(events[mycoreid].pending, i))
+			{
+				kprintf("[hal][cluster] core %d dropping event from core %d",
+					mycoreid,
+					i
+				);
 
-		events[mycoreid].pending = 0;
+				events_clear(events[mycoreid].pending, i);
+			}
+		}
 
 	section_guard_exit(&guard);
 }
@@ -260,7 +321,7 @@ PUBLIC void event_wait(void)
 	{
 		section_guard_entry(&guard);
 
-			if (events[mycoreid].pending || events[mycoreid].handled)
+			if (events_any(events[mycoreid].pending) || events_any(events[mycoreid].handled))
 				break;
 
 		section_guard_exit(&guard);
@@ -273,15 +334,15 @@ PUBLIC void event_wait(void)
 	}
 
 		/* Handles pending events. */
-		if (events[mycoreid].pending)
+		if (events_any(events[mycoreid].pending))
 			event_handler(-1);
 
 		/* Clear event. */
 		for (int i = 0; i < CORES_NUM; i++)
 		{
-			if (events[mycoreid].handled & (1 << i))
+			if (events_test(events[mycoreid].handled, i))
 			{
-				events[mycoreid].handled &= ~(1 << i);
+				events_clear(events[mycoreid].handled, i);
 				break;
 			}
 		}
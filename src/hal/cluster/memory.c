@@ -24,8 +24,10 @@
 
 /* Must come first. */
 #define __NEED_HAL_CLUSTER
+#define __NEED_SECTION_GUARD
 
 #include <nanvix/hal/cluster.h>
+#include <nanvix/hal/section_guard.h>
 #include <nanvix/const.h>
 #include <nanvix/hlib.h>
 
@@ -64,6 +66,223 @@ PUBLIC struct pte *kpool_pgtab = cluster_root_pgtabs[1];
 
 #if (!CORE_HAS_TLB_HW)
 
+/*============================================================================*
+ * TLB Index                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Null link in a TLB index.
+ */
+#define TLB_INDEX_NULL 0xff
+
+/**
+ * @brief Number of buckets in a TLB index.
+ */
+#define TLB_INDEX_NBUCKETS TLB_LENGTH
+
+/**
+ * @brief Hashes an address into a bucket of a TLB index.
+ */
+#define TLB_INDEX_HASH(addr) \
+	(((addr) >> PAGE_SHIFT) & (TLB_INDEX_NBUCKETS - 1))
+
+/**
+ * TLB entries are linked by 8-bit indexes, and addresses are hashed
+ * with a mask.
+ */
+#if (TLB_LENGTH >= TLB_INDEX_NULL)
+	#error "TLB too large for TLB index"
+#endif
+#if (TLB_LENGTH & (TLB_LENGTH - 1))
+	#error "TLB_LENGTH should be a power of two"
+#endif
+
+/**
+ * @brief Shadow index of a TLB.
+ *
+ * Entries of the underlying TLB are chained both by virtual and by
+ * physical address, so that lookups do not scan the whole TLB. The
+ * index of a core is only changed by the core itself. Other cores
+ * may flag it as stale, and it is then rebuilt on its next use.
+ */
+struct tlb_index
+{
+	volatile bool stale;                   /**< Rebuild before use?      */
+	uint8_t vbuckets[TLB_INDEX_NBUCKETS];  /**< Chains by virtual addr.  */
+	uint8_t pbuckets[TLB_INDEX_NBUCKETS];  /**< Chains by physical addr. */
+	uint8_t vnext[TLB_LENGTH];             /**< Next entry by virtual.   */
+	uint8_t pnext[TLB_LENGTH];             /**< Next entry by physical.  */
+	bool linked[TLB_LENGTH];               /**< Entry in the index?      */
+};
+
+/**
+ * @brief TLB indexes (D-TLB and I-TLB of each core).
+ */
+PRIVATE struct tlb_index tlb_indexes[CORES_NUM_MAX][2] = {
+	[0 ... (CORES_NUM_MAX - 1)] = {
+		[0 ... 1] = { .stale = true }
+	}
+};
+
+/**
+ * @brief Unlinks a TLB entry from a chain.
+ *
+ * @param bucket Head of the target chain.
+ * @param next   Links of the target chain.
+ * @param idx    Target TLB entry.
+ *
+ * @returns Zero if the entry was found in the chain, and non-zero
+ * otherwise.
+ */
+PRIVATE int tlb_index_chain_remove(uint8_t *bucket, uint8_t *next, unsigned idx)
+{
+	for (uint8_t *link = bucket; *link != TLB_INDEX_NULL; link = &next[*link])
+	{
+		if (*link == idx)
+		{
+			*link = next[idx];
+			return (0);
+		}
+	}
+
+	return (-1);
+}
+
+/**
+ * @brief Adds a TLB entry to a TLB index.
+ *
+ * @param index Target TLB index.
+ * @param utlb  Underlying TLB.
+ * @param idx   Target TLB entry.
+ *
+ * Invalid entries are not indexed.
+ */
+PRIVATE void tlb_index_link(struct tlb_index *index, struct tlbe *utlb, unsigned idx)
+{
+	unsigned vhash; /* Virtual address hash.  */
+	unsigned phash; /* Physical address hash. */
+
+	if (!tlbe_is_valid(&utlb[idx]))
+		return;
+
+	vhash = TLB_INDEX_HASH(tlbe_vaddr_get(&utlb[idx]));
+	phash = TLB_INDEX_HASH(tlbe_paddr_get(&utlb[idx]));
+
+	index->vnext[idx] = index->vbuckets[vhash];
+	index->vbuckets[vhash] = idx;
+	index->pnext[idx] = index->pbuckets[phash];
+	index->pbuckets[phash] = idx;
+	index->linked[idx] = true;
+}
+
+/**
+ * @brief Removes a TLB entry from a TLB index.
+ *
+ * @param index Target TLB index.
+ * @param utlb  Underlying TLB.
+ * @param idx   Target TLB entry.
+ *
+ * This should be called before the entry is changed. If the entry
+ * was changed behind the index, the index is flagged as stale.
+ */
+PRIVATE void tlb_index_unlink(struct tlb_index *index, struct tlbe *utlb, unsigned idx)
+{
+	unsigned vhash; /* Virtual address hash.  */
+	unsigned phash; /* Physical address hash. */
+
+	if (!index->linked[idx])
+		return;
+
+	vhash = TLB_INDEX_HASH(tlbe_vaddr_get(&utlb[idx]));
+	phash = TLB_INDEX_HASH(tlbe_paddr_get(&utlb[idx]));
+
+	if (tlb_index_chain_remove(&index->vbuckets[vhash], index->vnext, idx) ||
+		tlb_index_chain_remove(&index->pbuckets[phash], index->pnext, idx))
+	{
+		index->stale = true;
+	}
+
+	index->linked[idx] = false;
+}
+
+/**
+ * @brief Rebuilds a TLB index from scratch.
+ *
+ * @param index Target TLB index.
+ * @param utlb  Underlying TLB.
+ */
+PRIVATE void tlb_index_rebuild(struct tlb_index *index, struct tlbe *utlb)
+{
+	index->stale = false;
+
+	kmemset(index->vbuckets, TLB_INDEX_NULL, sizeof(index->vbuckets));
+	kmemset(index->pbuckets, TLB_INDEX_NULL, sizeof(index->pbuckets));
+
+	for (unsigned i = 0; i < TLB_LENGTH; i++)
+	{
+		index->linked[i] = false;
+		tlb_index_link(index, utlb, i);
+	}
+}
+
+/**
+ * @brief Gets the TLB index of the calling core.
+ *
+ * @param tlb_type Target TLB.
+ * @param utlb     Underlying TLB.
+ *
+ * @returns The up-to-date TLB index of the target TLB.
+ */
+PRIVATE struct tlb_index *tlb_index_get(int tlb_type, struct tlbe *utlb)
+{
+	struct tlb_index *index;
+
+	/* Unified TLB. */
+	if ((tlb_type == TLB_INSTRUCTION) && (utlb == tlb_get_utlb(TLB_DATA)))
+		tlb_type = TLB_DATA;
+
+	index = &tlb_indexes[core_get_id()][(tlb_type == TLB_DATA) ? 1 : 0];
+
+	if (index->stale)
+		tlb_index_rebuild(index, utlb);
+
+	return (index);
+}
+
+/**
+ * @brief Searches a TLB index by virtual address.
+ *
+ * @param index Target TLB index.
+ * @param utlb  Underlying TLB.
+ * @param addr  Aligned virtual address.
+ *
+ * @returns The valid TLB entry that matches @p addr, or NULL if
+ * there is no such entry.
+ */
+PRIVATE struct tlbe *tlb_index_lookup_vaddr(struct tlb_index *index, struct tlbe *utlb, vaddr_t addr)
+{
+	unsigned i;
+
+	for (i = index->vbuckets[TLB_INDEX_HASH(addr)]; i != TLB_INDEX_NULL; i = index->vnext[i])
+	{
+		if ((tlbe_vaddr_get(&utlb[i]) == addr) && tlbe_is_valid(&utlb[i]))
+			return (&utlb[i]);
+	}
+
+	return (NULL);
+}
+
+/**
+ * The tlb_index_invalidate() function flags the TLB indexes of the
+ * core @p coreid as stale. It should be called whenever the TLB of
+ * that core is changed other than by tlb_write() and tlb_inval().
+ */
+PUBLIC void tlb_index_invalidate(int coreid)
+{
+	tlb_indexes[coreid][0].stale = true;
+	tlb_indexes[coreid][1].stale = true;
+}
+
 /*============================================================================*
  * tlb_lookup_vaddr()                                                         *
  *============================================================================*/
@@ -79,7 +298,7 @@ PUBLIC const struct tlbe *tlb_lookup_vaddr(int tlb_type, vaddr_t vaddr)
 {
 	vaddr_t addr;            /* Aligned address.   */
 	struct tlbe *utlb;       /* Underlying TLB.    */
-	const struct tlbe *tlbe; /* TLB Entry Pointer. */
+	struct tlb_index *index; /* TLB index.         */
 
 	/* Invalid TLB type. */
 	if ((tlb_type != TLB_INSTRUCTION) && (tlb_type != TLB_DATA))
@@ -87,20 +306,9 @@ PUBLIC const struct tlbe *tlb_lookup_vaddr(int tlb_type, vaddr_t vaddr)
 
 	addr   = vaddr & TLB_VADDR_MASK;
 	utlb   = tlb_get_utlb(tlb_type);
+	index  = tlb_index_get(tlb_type, utlb);
 
-	for (int i = 0; i < TLB_LENGTH; i++)
-	{
-		tlbe = &utlb[i];
-
-		/* Found */
-		if (tlbe_vaddr_get(tlbe) == addr)
-		{
-			if (tlbe_is_valid(tlbe))
-				return (tlbe);
-		}
-	}
-
-	return (NULL);
+	return (tlb_index_lookup_vaddr(index, utlb, addr));
 }
 
 /*============================================================================*
@@ -119,9 +327,10 @@ PUBLIC const struct tlbe *tlb_lookup_vaddr(int tlb_type, vaddr_t vaddr)
  */
 PUBLIC const struct tlbe *tlb_lookup_paddr(int tlb_type, paddr_t paddr)
 {
+	unsigned i;              /* TLB Index.         */
 	paddr_t addr;            /* Aligned address.   */
 	struct tlbe *utlb;       /* Underlying TLB.    */
-	const struct tlbe *tlbe; /* TLB Entry Pointer. */
+	struct tlb_index *index; /* TLB index.         */
 
 	/* Invalid TLB type. */
 	if ((tlb_type != TLB_INSTRUCTION) && (tlb_type != TLB_DATA))
@@ -129,17 +338,13 @@ PUBLIC const struct tlbe *tlb_lookup_paddr(int tlb_type, paddr_t paddr)
 
 	addr   = paddr & TLB_VADDR_MASK;
 	utlb   = tlb_get_utlb(tlb_type);
+	index  = tlb_index_get(tlb_type, utlb);
 
-	for (int i = 0; i < TLB_LENGTH; i++)
+	for (i = index->pbuckets[TLB_INDEX_HASH(addr)]; i != TLB_INDEX_NULL; i = index->pnext[i])
 	{
-		tlbe = &utlb[i];
-
 		/* Found */
-		if (tlbe_paddr_get(tlbe) == addr)
-		{
-			if (tlbe_is_valid(tlbe))
-				return (tlbe);
-		}
+		if ((tlbe_paddr_get(&utlb[i]) == addr) && tlbe_is_valid(&utlb[i]))
+			return (&utlb[i]);
 	}
 
 	return (NULL);
@@ -163,9 +368,11 @@ PUBLIC const struct tlbe *tlb_lookup_paddr(int tlb_type, paddr_t paddr)
  */
 PUBLIC int tlb_write(int tlb_type, vaddr_t vaddr, paddr_t paddr)
 {
-	int config;        /* Configuration flag. */
-	unsigned idx;      /* TLB Index.          */
-	struct tlbe *utlb; /* Underlying TLB.     */
+	int ret;                 /* Return value.       */
+	int config;              /* Configuration flag. */
+	unsigned idx;            /* TLB Index.          */
+	struct tlbe *utlb;       /* Underlying TLB.     */
+	struct tlb_index *index; /* TLB index.          */
 
 	/* Invalid TLB type. */
 	if ((tlb_type != TLB_INSTRUCTION) && (tlb_type != TLB_DATA))
@@ -174,11 +381,13 @@ PUBLIC int tlb_write(int tlb_type, vaddr_t vaddr, paddr_t paddr)
 	utlb   = tlb_get_utlb(tlb_type);
 	idx    = tlbe_get_index(vaddr);
 	config = tlb_get_vaddr_info(vaddr);
+	index  = tlb_index_get(tlb_type, utlb);
 
-	if (tlbe_write(&utlb[idx], tlb_type, vaddr, paddr, config) != 0)
-		return (-EAGAIN);
+	tlb_index_unlink(index, utlb, idx);
+	ret = tlbe_write(&utlb[idx], tlb_type, vaddr, paddr, config);
+	tlb_index_link(index, utlb, idx);
 
-	return (0);
+	return ((ret != 0) ? -EAGAIN : 0);
 }
 
 /*============================================================================*
@@ -193,20 +402,93 @@ PUBLIC int tlb_write(int tlb_type, vaddr_t vaddr, paddr_t paddr)
  */
 PUBLIC int tlb_inval(int tlb_type, vaddr_t vaddr)
 {
-	int idx;           /* TLB Index.      */
-	struct tlbe *utlb; /* Underlying TLB. */
+	int ret;                 /* Return value.   */
+	int idx;                 /* TLB Index.      */
+	struct tlbe *utlb;       /* Underlying TLB. */
+	struct tlb_index *index; /* TLB index.      */
 
 	/* Invalid TLB type. */
 	if ((tlb_type != TLB_INSTRUCTION) && (tlb_type != TLB_DATA))
 		return (-EINVAL);
 
-	idx  = tlbe_get_index(vaddr);
-	utlb = tlb_get_utlb(tlb_type);
+	idx   = tlbe_get_index(vaddr);
+	utlb  = tlb_get_utlb(tlb_type);
+	index = tlb_index_get(tlb_type, utlb);
 
-	if (tlbe_inval(&utlb[idx], tlb_type, vaddr) != 0)
-		return (-EAGAIN);
+	tlb_index_unlink(index, utlb, idx);
+	ret = tlbe_inval(&utlb[idx], tlb_type, vaddr);
+	tlb_index_link(index, utlb, idx);
 
-	return (0);
+	return ((ret != 0) ? -EAGAIN : 0);
+}
+
+/*============================================================================*
+ * tlb_inval_range()                                                          *
+ *============================================================================*/
+
+/**
+ * The tlb_inval_range() function invalidates the TLB entries that
+ * encode the virtual addresses in [@p vaddr, @p vaddr + @p size).
+ * Small ranges are looked up page by page in the TLB index. Ranges
+ * that span more pages than the TLB has entries are handled in a
+ * single pass over the TLB.
+ */
+PUBLIC int tlb_inval_range(int tlb_type, vaddr_t vaddr, size_t size)
+{
+	int ret;                 /* Return value.       */
+	vaddr_t start;           /* Start address.      */
+	vaddr_t end;             /* End address.        */
+	struct tlbe *tlbe;       /* TLB Entry Pointer.  */
+	struct tlbe *utlb;       /* Underlying TLB.     */
+	struct tlb_index *index; /* TLB index.          */
+
+	/* Invalid TLB type. */
+	if ((tlb_type != TLB_INSTRUCTION) && (tlb_type != TLB_DATA))
+		return (-EINVAL);
+
+	/* Invalid range. */
+	if ((size == 0) || ((vaddr + size) < vaddr))
+		return (-EINVAL);
+
+	ret   = 0;
+	start = vaddr & TLB_VADDR_MASK;
+	end   = vaddr + size;
+	utlb  = tlb_get_utlb(tlb_type);
+	index = tlb_index_get(tlb_type, utlb);
+
+	/* Small range. */
+	if (((end - start) >> PAGE_SHIFT) <= TLB_LENGTH)
+	{
+		for (vaddr_t addr = start; addr < end; addr += PAGE_SIZE)
+		{
+			if ((tlbe = tlb_index_lookup_vaddr(index, utlb, addr)) == NULL)
+				continue;
+
+			tlb_index_unlink(index, utlb, tlbe - utlb);
+			if (tlbe_inval(tlbe, tlb_type, addr) != 0)
+				ret = -EAGAIN;
+			tlb_index_link(index, utlb, tlbe - utlb);
+		}
+	}
+
+	/* Large range. */
+	else
+	{
+		for (unsigned i = 0; i < TLB_LENGTH; i++)
+		{
+			vaddr_t addr = tlbe_vaddr_get(&utlb[i]);
+
+			if (!tlbe_is_valid(&utlb[i]) || !WITHIN(addr, start, end))
+				continue;
+
+			tlb_index_unlink(index, utlb, i);
+			if (tlbe_inval(&utlb[i], tlb_type, addr) != 0)
+				ret = -EAGAIN;
+			tlb_index_link(index, utlb, i);
+		}
+	}
+
+	return (ret);
 }
 
 /*============================================================================*
@@ -268,9 +550,9 @@ PUBLIC void mem_info(void)
 	);
 	kprintf("[hal][cluster] memsize=%d MB kmem=%d KB kpool=%d KB umem=%d KB",
 		MEMORY_SIZE/MB,
-		KMEM_SIZE/KB,
-		KPOOL_SIZE/KB,
-		UMEM_SIZE/KB
+		kmem_size/KB,
+		kpool_size/KB,
+		umem_size/KB
 	);
 }
 
@@ -416,6 +698,458 @@ PUBLIC void mem_map(void)
 	tlb_load(PADDR(cluster_root_pgdir));
 }
 
+/*============================================================================*
+ * Page Frame Allocator                                                       *
+ *============================================================================*/
+
+/**
+ * @name Page Frame States
+ */
+/**@{*/
+#define FRAME_INNER    0 /**< Inside a block.              */
+#define FRAME_FREE     1 /**< Heads a free block.          */
+#define FRAME_USED     2 /**< Heads a used block.          */
+#define FRAME_CACHED   3 /**< Held by a per-core cache.    */
+#define FRAME_RESERVED 4 /**< Overlaps the memory layout.  */
+/**@}*/
+
+/**
+ * @brief Number of page frames moved at once between the per-core
+ * caches and the buddy allocator.
+ */
+#define FRAME_CACHE_BATCH (FRAME_CACHE_SIZE/2)
+
+/**
+ * @brief Page frame table.
+ *
+ * Only the first frame of a block carries its state and order, all
+ * others are @ref FRAME_INNER.
+ */
+PRIVATE struct frame
+{
+	int next;      /**< Next free block.     */
+	int prev;      /**< Previous free block. */
+	uint8_t order; /**< Block order.         */
+	uint8_t state; /**< Block state.         */
+} frame_table[MEM_FRAMES_MAX];
+
+/**
+ * @brief Buddy allocator.
+ */
+PRIVATE struct
+{
+	spinlock_t lock;                  /**< Lock.                      */
+	int nframes;                      /**< Page frames.               */
+	int nfree;                        /**< Free page frames.          */
+	int free[FRAME_ORDER_MAX + 1];    /**< Free blocks of each order. */
+	int nblocks[FRAME_ORDER_MAX + 1]; /**< Number of free blocks.     */
+} frame_buddy;
+
+/**
+ * @brief Per-core cache of order-0 page frames.
+ */
+PRIVATE struct frame_cache
+{
+	int nframes;                  /**< Number of page frames. */
+	int frames[FRAME_CACHE_SIZE]; /**< Page frames.           */
+} ALIGN(CACHE_LINE_SIZE) frame_caches[CORES_NUM_MAX];
+
+/**
+ * @brief Links a free block to the buddy allocator.
+ *
+ * @param idx   First page frame of the block.
+ * @param order Block order.
+ */
+PRIVATE void frame_buddy_link(int idx, int order)
+{
+	frame_table[idx].state = FRAME_FREE;
+	frame_table[idx].order = order;
+	frame_table[idx].prev = -1;
+	frame_table[idx].next = frame_buddy.free[order];
+	if (frame_buddy.free[order] >= 0)
+		frame_table[frame_buddy.free[order]].prev = idx;
+	frame_buddy.free[order] = idx;
+	frame_buddy.nblocks[order]++;
+}
+
+/**
+ * @brief Unlinks a free block from the buddy allocator.
+ *
+ * @param idx First page frame of the block.
+ */
+PRIVATE void frame_buddy_unlink(int idx)
+{
+	int order = frame_table[idx].order;
+
+	if (frame_table[idx].prev >= 0)
+		frame_table[frame_table[idx].prev].next = frame_table[idx].next;
+	else
+		frame_buddy.free[order] = frame_table[idx].next;
+	if (frame_table[idx].next >= 0)
+		frame_table[frame_table[idx].next].prev = frame_table[idx].prev;
+	frame_buddy.nblocks[order]--;
+}
+
+/**
+ * @brief Takes a block out of the buddy allocator.
+ *
+ * @param order Block order.
+ *
+ * @returns The first page frame of the block, or a negative number
+ * if there is no free block large enough.
+ *
+ * @note The buddy allocator should be locked.
+ */
+PRIVATE int frame_buddy_get(int order)
+{
+	int idx;
+	int j = order;
+
+	/* Find smallest block that fits. */
+	while (frame_buddy.free[j] < 0)
+	{
+		if (++j > FRAME_ORDER_MAX)
+			return (-1);
+	}
+
+	idx = frame_buddy.free[j];
+	frame_buddy_unlink(idx);
+
+	/* Split block. */
+	while (j > order)
+	{
+		j--;
+		frame_buddy_link(idx + (1 << j), j);
+	}
+
+	frame_table[idx].state = FRAME_USED;
+	frame_table[idx].order = order;
+	frame_buddy.nfree -= (1 << order);
+
+	return (idx);
+}
+
+/**
+ * @brief Gives a block back to the buddy allocator.
+ *
+ * @param idx   First page frame of the block.
+ * @param order Block order.
+ *
+ * @note The buddy allocator should be locked.
+ */
+PRIVATE void frame_buddy_put(int idx, int order)
+{
+	frame_buddy.nfree += (1 << order);
+
+	/* Coalesce with free buddies. */
+	while (order < FRAME_ORDER_MAX)
+	{
+		int buddy = idx ^ (1 << order);
+
+		if (buddy >= frame_buddy.nframes)
+			break;
+		if (frame_table[buddy].state != FRAME_FREE)
+			break;
+		if (frame_table[buddy].order != order)
+			break;
+
+		frame_buddy_unlink(buddy);
+		frame_table[buddy].state = FRAME_INNER;
+		frame_table[idx].state = FRAME_INNER;
+		idx &= buddy;
+		order++;
+	}
+
+	frame_buddy_link(idx, order);
+}
+
+/**
+ * @brief Enters the page frame cache of the calling core.
+ *
+ * @param level Store location for the previous interrupt level.
+ *
+ * @returns The page frame cache of the calling core.
+ */
+PRIVATE struct frame_cache *frame_cache_enter(int *level)
+{
+	*level = -1;
+	if (INTERRUPT_LEVEL_NONE > interrupts_get_level())
+		*level = interrupts_set_level(INTERRUPT_LEVEL_NONE);
+
+	return (&frame_caches[core_get_id()]);
+}
+
+/**
+ * @brief Leaves the page frame cache of the calling core.
+ *
+ * @param level Interrupt level to restore.
+ */
+PRIVATE void frame_cache_leave(int level)
+{
+	if (level >= 0)
+		interrupts_set_level(level);
+}
+
+/*============================================================================*
+ * frame_alloc()                                                              *
+ *============================================================================*/
+
+/**
+ * The frame_alloc() function allocates 2^@p order contiguous page
+ * frames of user memory. Single page frames are served from a cache
+ * of the calling core, which is refilled in batches.
+ */
+PUBLIC int frame_alloc(int order, paddr_t *paddr)
+{
+	int idx;
+	struct section_guard guard;
+
+	/* Invalid order. */
+	if (!WITHIN(order, 0, FRAME_ORDER_MAX + 1))
+		return (-EINVAL);
+
+	/* Invalid store location. */
+	if (paddr == NULL)
+		return (-EINVAL);
+
+	section_guard_init(&guard, &frame_buddy.lock, INTERRUPT_LEVEL_NONE);
+
+	if (order == 0)
+	{
+		int level;
+		struct frame_cache *cache;
+
+		cache = frame_cache_enter(&level);
+
+			/* Refill cache. */
+			if (cache->nframes == 0)
+			{
+				section_guard_entry(&guard);
+
+					while (cache->nframes < FRAME_CACHE_BATCH)
+					{
+						if ((idx = frame_buddy_get(0)) < 0)
+							break;
+
+						frame_table[idx].state = FRAME_CACHED;
+						cache->frames[cache->nframes++] = idx;
+					}
+
+				section_guard_exit(&guard);
+			}
+
+			idx = -1;
+			if (cache->nframes > 0)
+			{
+				idx = cache->frames[--cache->nframes];
+				frame_table[idx].state = FRAME_USED;
+			}
+
+		frame_cache_leave(level);
+	}
+	else
+	{
+		section_guard_entry(&guard);
+			idx = frame_buddy_get(order);
+		section_guard_exit(&guard);
+	}
+
+	/* Out of memory. */
+	if (idx < 0)
+		return (-ENOMEM);
+
+	*paddr = UBASE_PHYS + ((paddr_t) idx)*PAGE_SIZE;
+
+	return (0);
+}
+
+/*============================================================================*
+ * frame_free()                                                               *
+ *============================================================================*/
+
+/**
+ * The frame_free() function releases the 2^@p order contiguous page
+ * frames starting at @p paddr, which should have been allocated by
+ * frame_alloc() with the same order.
+ */
+PUBLIC int frame_free(paddr_t paddr, int order)
+{
+	int idx;
+	struct section_guard guard;
+
+	/* Invalid order. */
+	if (!WITHIN(order, 0, FRAME_ORDER_MAX + 1))
+		return (-EINVAL);
+
+	/* Not in user memory. */
+	if (!WITHIN(paddr, UBASE_PHYS, UBASE_PHYS + ((paddr_t) frame_buddy.nframes)*PAGE_SIZE))
+		return (-EINVAL);
+
+	/* Misaligned block. */
+	idx = (paddr - UBASE_PHYS)/PAGE_SIZE;
+	if (!ALIGNED(paddr, PAGE_SIZE) || (idx & ((1 << order) - 1)))
+		return (-EINVAL);
+
+	/* Not allocated with this order. */
+	if ((frame_table[idx].state != FRAME_USED) || (frame_table[idx].order != order))
+		return (-EINVAL);
+
+	section_guard_init(&guard, &frame_buddy.lock, INTERRUPT_LEVEL_NONE);
+
+	if (order == 0)
+	{
+		int level;
+		struct frame_cache *cache;
+
+		cache = frame_cache_enter(&level);
+
+			/* Drain cache. */
+			if (cache->nframes == FRAME_CACHE_SIZE)
+			{
+				section_guard_entry(&guard);
+
+					while (cache->nframes > FRAME_CACHE_SIZE - FRAME_CACHE_BATCH)
+						frame_buddy_put(cache->frames[--cache->nframes], 0);
+
+				section_guard_exit(&guard);
+			}
+
+			frame_table[idx].state = FRAME_CACHED;
+			cache->frames[cache->nframes++] = idx;
+
+		frame_cache_leave(level);
+	}
+	else
+	{
+		section_guard_entry(&guard);
+			frame_buddy_put(idx, order);
+		section_guard_exit(&guard);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * frame_stats_get()                                                          *
+ *============================================================================*/
+
+/**
+ * The frame_stats_get() function stores statistics of the page frame
+ * allocator in the location pointed to by @p stats. Page frames held
+ * by per-core caches are counted as free.
+ */
+PUBLIC int frame_stats_get(struct frame_stats *stats)
+{
+	/* Invalid store location. */
+	if (stats == NULL)
+		return (-EINVAL);
+
+	kmemset(stats, 0, sizeof(struct frame_stats));
+
+	for (int i = 0; i < CORES_NUM_MAX; i++)
+		stats->ncached += frame_caches[i].nframes;
+
+	spinlock_lock(&frame_buddy.lock);
+
+		stats->nframes = frame_buddy.nframes;
+		stats->nfree = frame_buddy.nfree + stats->ncached;
+		for (int i = 0; i <= FRAME_ORDER_MAX; i++)
+			stats->nblocks[i] = frame_buddy.nblocks[i];
+
+	spinlock_unlock(&frame_buddy.lock);
+
+	return (0);
+}
+
+/*============================================================================*
+ * frame_setup()                                                              *
+ *============================================================================*/
+
+/**
+ * @brief Initializes the page frame allocator.
+ *
+ * The frame_setup() function hands user memory to the buddy
+ * allocator. Page frames that overlap a region of the memory layout
+ * are reserved, and the remaining ones are carved in the largest
+ * blocks that fit.
+ */
+PRIVATE void frame_setup(void)
+{
+	int nreserved = 0;
+
+	spinlock_init(&frame_buddy.lock);
+	frame_buddy.nframes = MEM_FRAMES_MAX;
+	if ((umem_size/PAGE_SIZE) < MEM_FRAMES_MAX)
+		frame_buddy.nframes = umem_size/PAGE_SIZE;
+	frame_buddy.nfree = 0;
+	for (int i = 0; i <= FRAME_ORDER_MAX; i++)
+	{
+		frame_buddy.free[i] = -1;
+		frame_buddy.nblocks[i] = 0;
+	}
+
+	/* Reserve page frames in the memory layout. */
+	for (int i = 0; i < frame_buddy.nframes; i++)
+	{
+		paddr_t paddr = UBASE_PHYS + ((paddr_t) i)*PAGE_SIZE;
+
+		frame_table[i].state = FRAME_INNER;
+		for (int j = 0; j < MEM_REGIONS; j++)
+		{
+			if (WITHIN(paddr, mem_layout[j].pbase, mem_layout[j].pend))
+			{
+				frame_table[i].state = FRAME_RESERVED;
+				nreserved++;
+				break;
+			}
+		}
+	}
+
+	/* Carve blocks. */
+	for (int i = 0; i < frame_buddy.nframes; /* noop */)
+	{
+		int order;
+
+		if (frame_table[i].state == FRAME_RESERVED)
+		{
+			i++;
+			continue;
+		}
+
+		for (order = FRAME_ORDER_MAX; order > 0; order--)
+		{
+			bool fits;
+
+			if ((i & ((1 << order) - 1)) || (i + (1 << order) > frame_buddy.nframes))
+				continue;
+
+			fits = true;
+			for (int j = i; j < i + (1 << order); j++)
+			{
+				if (frame_table[j].state == FRAME_RESERVED)
+				{
+					fits = false;
+					break;
+				}
+			}
+
+			if (fits)
+				break;
+		}
+
+		frame_buddy_link(i, order);
+		frame_buddy.nfree += (1 << order);
+		i += (1 << order);
+	}
+
+	kmemset(frame_caches, 0, sizeof(frame_caches));
+
+	kprintf("[hal][cluster] %d page frames, %d reserved",
+		frame_buddy.nframes,
+		nreserved
+	);
+}
+
 /*============================================================================*
  * mem_setup()                                                                *
  *============================================================================*/
@@ -444,6 +1178,8 @@ PUBLIC void mem_setup(void)
 		mem_check_layout();
 
 		mem_map();
+		frame_setup();
+		slab_setup();
 	}
 
 	mem_warmup();
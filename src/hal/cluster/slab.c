@@ -0,0 +1,579 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __NEED_HAL_CLUSTER
+#define __NEED_SECTION_GUARD
+
+#include <nanvix/hal/cluster.h>
+#include <nanvix/hal/section_guard.h>
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+
+/**
+ * @brief Size of a slab (in bytes).
+ */
+#define SLAB_SIZE KPAGE_SIZE
+
+/**
+ * @brief Magic number of a slab.
+ */
+#define SLAB_MAGIC 0x51ab51abU
+
+/**
+ * @brief Offset of the first object in a slab.
+ */
+#define SLAB_OBJECTS_OFFSET TRUNCATE(sizeof(struct slab), SLAB_OBJECT_MIN)
+
+/**
+ * @brief Gets the slab of an object.
+ */
+#define SLAB_OF(obj) ((struct slab *)(((uintptr_t)(obj)) & ~(SLAB_SIZE - 1)))
+
+#if (SLAB_SIZE < 2*SLAB_OBJECT_MAX)
+	#error "slabs are too small for the largest size class"
+#endif
+
+/*============================================================================*
+ * Slabs                                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Slab.
+ *
+ * A slab is a page of the kernel page pool carved into objects of the
+ * same size. Its header lies at the beginning of the page.
+ */
+struct slab
+{
+	unsigned magic;    /**< Magic number.                  */
+	int cls;           /**< Size class.                    */
+	unsigned inuse;    /**< Objects out of the slab.       */
+	void *free;        /**< Free objects.                  */
+	struct slab *prev; /**< Previous slab with free space. */
+	struct slab *next; /**< Next slab with free space.     */
+};
+
+/**
+ * @brief Size class.
+ */
+PRIVATE struct slab_class
+{
+	spinlock_t lock;      /**< Lock.                  */
+	struct slab *partial; /**< Slabs with free space. */
+	unsigned nslabs;      /**< Slabs held.            */
+} slab_classes[SLAB_CLASSES];
+
+/**
+ * @brief Pages of the kernel page pool.
+ */
+PRIVATE struct
+{
+	spinlock_t lock; /**< Lock.                   */
+	vaddr_t base;    /**< First page of the pool. */
+	vaddr_t next;    /**< Next untouched page.    */
+	vaddr_t end;     /**< End of the pool.        */
+	void *free;      /**< Released pages.         */
+} slab_pages;
+
+/**
+ * @brief Gets the size of the objects of a size class.
+ *
+ * @param cls Target size class.
+ *
+ * @returns The size of the objects of the size class @p cls.
+ */
+static inline size_t slab_class_size(int cls)
+{
+	return (SLAB_OBJECT_MIN << cls);
+}
+
+/**
+ * @brief Gets the number of objects in a slab of a size class.
+ *
+ * @param cls Target size class.
+ *
+ * @returns The number of objects in a slab of the size class @p cls.
+ */
+static inline unsigned slab_class_objects(int cls)
+{
+	return ((SLAB_SIZE - SLAB_OBJECTS_OFFSET)/slab_class_size(cls));
+}
+
+/**
+ * @brief Gets the size class of an object size.
+ *
+ * @param size Object size (in bytes).
+ *
+ * @returns The smallest size class that fits objects of @p size
+ * bytes, or a negative number if there is no such class.
+ */
+PRIVATE int slab_class_lookup(size_t size)
+{
+	/* Invalid size. */
+	if ((size == 0) || (size > SLAB_OBJECT_MAX))
+		return (-1);
+
+	for (int i = 0; i < SLAB_CLASSES; i++)
+	{
+		if (size <= slab_class_size(i))
+			return (i);
+	}
+
+	return (-1);
+}
+
+/**
+ * @brief Gets a page from the kernel page pool.
+ *
+ * @returns A page of the kernel page pool, or NULL if the pool is
+ * exhausted.
+ */
+PRIVATE void *slab_page_get(void)
+{
+	void *page;
+
+	spinlock_lock(&slab_pages.lock);
+
+		/* Reuse a released page. */
+		if ((page = slab_pages.free) != NULL)
+			slab_pages.free = *((void **) page);
+
+		/* Touch a new page. */
+		else if (slab_pages.next < slab_pages.end)
+		{
+			page = (void *) slab_pages.next;
+			slab_pages.next += SLAB_SIZE;
+		}
+
+	spinlock_unlock(&slab_pages.lock);
+
+	return (page);
+}
+
+/**
+ * @brief Gives a page back to the kernel page pool.
+ *
+ * @param page Target page.
+ */
+PRIVATE void slab_page_put(void *page)
+{
+	spinlock_lock(&slab_pages.lock);
+
+		*((void **) page) = slab_pages.free;
+		slab_pages.free = page;
+
+	spinlock_unlock(&slab_pages.lock);
+}
+
+/**
+ * @brief Links a slab to the slabs with free space of its class.
+ *
+ * @param class Target size class.
+ * @param slab  Target slab.
+ */
+PRIVATE void slab_link(struct slab_class *class, struct slab *slab)
+{
+	slab->prev = NULL;
+	slab->next = class->partial;
+	if (class->partial != NULL)
+		class->partial->prev = slab;
+	class->partial = slab;
+}
+
+/**
+ * @brief Unlinks a slab from the slabs with free space of its class.
+ *
+ * @param class Target size class.
+ * @param slab  Target slab.
+ */
+PRIVATE void slab_unlink(struct slab_class *class, struct slab *slab)
+{
+	if (slab->prev != NULL)
+		slab->prev->next = slab->next;
+	else
+		class->partial = slab->next;
+	if (slab->next != NULL)
+		slab->next->prev = slab->prev;
+}
+
+/**
+ * @brief Creates a slab.
+ *
+ * @param cls Target size class.
+ *
+ * @returns A new slab of the size class @p cls, or NULL if the kernel
+ * page pool is exhausted.
+ */
+PRIVATE struct slab *slab_create(int cls)
+{
+	char *obj;
+	size_t size;
+	struct slab *slab;
+
+	if ((slab = slab_page_get()) == NULL)
+		return (NULL);
+
+	slab->magic = SLAB_MAGIC;
+	slab->cls = cls;
+	slab->inuse = 0;
+	slab->free = NULL;
+
+	/* Thread objects in address order. */
+	size = slab_class_size(cls);
+	obj = (char *) slab + SLAB_OBJECTS_OFFSET + (slab_class_objects(cls) - 1)*size;
+	for (unsigned i = 0; i < slab_class_objects(cls); i++, obj -= size)
+	{
+		*((void **) obj) = slab->free;
+		slab->free = obj;
+	}
+
+	return (slab);
+}
+
+/*============================================================================*
+ * Magazines                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Magazine.
+ */
+struct magazine
+{
+	unsigned nobjs;                   /**< Number of objects. */
+	void *objs[SLAB_MAGAZINE_SIZE];   /**< Objects.           */
+};
+
+/**
+ * @brief Per-core cache of a size class.
+ *
+ * Each core allocates from and releases to its loaded magazine. The
+ * previous magazine is swapped in when the loaded one runs out, so a
+ * core that alternates allocations and releases around a magazine
+ * boundary does not thrash the shared slabs.
+ */
+PRIVATE struct slab_cache
+{
+	struct magazine loaded;   /**< Loaded magazine.        */
+	struct magazine previous; /**< Previous magazine.      */
+	unsigned allocs;          /**< Allocations.            */
+	unsigned frees;           /**< Releases.               */
+	unsigned misses;          /**< Trips to shared slabs.  */
+	unsigned failures;        /**< Failed allocations.     */
+} ALIGN(CACHE_LINE_SIZE) slab_caches[CORES_NUM_MAX][SLAB_CLASSES];
+
+/**
+ * @brief Swaps the magazines of a per-core cache.
+ *
+ * @param cache Target cache.
+ */
+PRIVATE void slab_cache_swap(struct slab_cache *cache)
+{
+	struct magazine tmp;
+
+	tmp = cache->loaded;
+	cache->loaded = cache->previous;
+	cache->previous = tmp;
+}
+
+/**
+ * @brief Fills a magazine from the shared slabs.
+ *
+ * @param cls Target size class.
+ * @param mag Target magazine.
+ */
+PRIVATE void slab_magazine_fill(int cls, struct magazine *mag)
+{
+	struct slab *slab;
+	struct section_guard guard;
+	struct slab_class *class = &slab_classes[cls];
+
+	section_guard_init(&guard, &class->lock, INTERRUPT_LEVEL_NONE);
+
+	section_guard_entry(&guard);
+
+		while (mag->nobjs < SLAB_MAGAZINE_SIZE)
+		{
+			/* Grow the class. */
+			if ((slab = class->partial) == NULL)
+			{
+				if ((slab = slab_create(cls)) == NULL)
+					break;
+
+				slab_link(class, slab);
+				class->nslabs++;
+			}
+
+			mag->objs[mag->nobjs++] = slab->free;
+			slab->free = *((void **) slab->free);
+			slab->inuse++;
+
+			/* Slab is full. */
+			if (slab->free == NULL)
+				slab_unlink(class, slab);
+		}
+
+	section_guard_exit(&guard);
+}
+
+/**
+ * @brief Empties a magazine into the shared slabs.
+ *
+ * @param cls Target size class.
+ * @param mag Target magazine.
+ *
+ * Slabs that get empty are given back to the kernel page pool, but
+ * the last one of the class.
+ */
+PRIVATE void slab_magazine_empty(int cls, struct magazine *mag)
+{
+	void *obj;
+	struct slab *slab;
+	struct section_guard guard;
+	struct slab_class *class = &slab_classes[cls];
+
+	section_guard_init(&guard, &class->lock, INTERRUPT_LEVEL_NONE);
+
+	section_guard_entry(&guard);
+
+		while (mag->nobjs > 0)
+		{
+			obj = mag->objs[--mag->nobjs];
+			slab = SLAB_OF(obj);
+
+			/* Slab is no longer full. */
+			if (slab->free == NULL)
+				slab_link(class, slab);
+
+			*((void **) obj) = slab->free;
+			slab->free = obj;
+			slab->inuse--;
+
+			/* Slab is empty. */
+			if ((slab->inuse == 0) && (class->nslabs > 1))
+			{
+				slab_unlink(class, slab);
+				class->nslabs--;
+				slab->magic = 0;
+				slab_page_put(slab);
+			}
+		}
+
+	section_guard_exit(&guard);
+}
+
+/**
+ * @brief Enters the per-core cache of the calling core.
+ *
+ * @param level Store location for the previous interrupt level.
+ *
+ * @returns The per-core caches of the calling core.
+ *
+ * Interrupts are masked, so that an interrupt handler that allocates
+ * objects does not find the cache in an inconsistent state. No lock
+ * is needed, as no other core touches these caches.
+ */
+PRIVATE struct slab_cache *slab_cache_enter(int *level)
+{
+	*level = -1;
+	if (INTERRUPT_LEVEL_NONE > interrupts_get_level())
+		*level = interrupts_set_level(INTERRUPT_LEVEL_NONE);
+
+	return (slab_caches[core_get_id()]);
+}
+
+/**
+ * @brief Leaves the per-core cache of the calling core.
+ *
+ * @param level Interrupt level to restore.
+ */
+PRIVATE void slab_cache_leave(int level)
+{
+	if (level >= 0)
+		interrupts_set_level(level);
+}
+
+/*============================================================================*
+ * slab_alloc()                                                               *
+ *============================================================================*/
+
+/**
+ * The slab_alloc() function allocates an object of @p size bytes from
+ * the kernel page pool. Objects are at least @ref SLAB_OBJECT_MIN
+ * bytes aligned.
+ */
+PUBLIC void *slab_alloc(size_t size)
+{
+	int cls;
+	int level;
+	void *obj;
+	struct slab_cache *cache;
+
+	/* Invalid size. */
+	if ((cls = slab_class_lookup(size)) < 0)
+		return (NULL);
+
+	cache = &slab_cache_enter(&level)[cls];
+
+		if (cache->loaded.nobjs == 0)
+		{
+			if (cache->previous.nobjs > 0)
+				slab_cache_swap(cache);
+			else
+			{
+				cache->misses++;
+				slab_magazine_fill(cls, &cache->loaded);
+			}
+		}
+
+		obj = NULL;
+		if (cache->loaded.nobjs > 0)
+		{
+			obj = cache->loaded.objs[--cache->loaded.nobjs];
+			cache->allocs++;
+		}
+		else
+			cache->failures++;
+
+	slab_cache_leave(level);
+
+	return (obj);
+}
+
+/*============================================================================*
+ * slab_free()                                                                *
+ *============================================================================*/
+
+/**
+ * The slab_free() function releases the object pointed to by @p obj,
+ * which should have been allocated by slab_alloc().
+ */
+PUBLIC int slab_free(void *obj)
+{
+	int level;
+	struct slab *slab;
+	struct slab_cache *cache;
+
+	/* Not in the kernel page pool. */
+	if (!WITHIN((vaddr_t) obj, slab_pages.base, slab_pages.next))
+		return (-EINVAL);
+
+	/* Not in a slab. */
+	slab = SLAB_OF(obj);
+	if (slab->magic != SLAB_MAGIC)
+		return (-EINVAL);
+
+	/* Misaligned object. */
+	if ((((uintptr_t) obj - (uintptr_t) slab) < SLAB_OBJECTS_OFFSET) ||
+		((((uintptr_t) obj - (uintptr_t) slab) - SLAB_OBJECTS_OFFSET) & (slab_class_size(slab->cls) - 1)))
+		return (-EINVAL);
+
+	cache = &slab_cache_enter(&level)[slab->cls];
+
+		if (cache->loaded.nobjs == SLAB_MAGAZINE_SIZE)
+		{
+			if (cache->previous.nobjs == SLAB_MAGAZINE_SIZE)
+			{
+				cache->misses++;
+				slab_magazine_empty(slab->cls, &cache->previous);
+			}
+
+			slab_cache_swap(cache);
+		}
+
+		cache->loaded.objs[cache->loaded.nobjs++] = obj;
+		cache->frees++;
+
+	slab_cache_leave(level);
+
+	return (0);
+}
+
+/*============================================================================*
+ * slab_stats_get()                                                           *
+ *============================================================================*/
+
+/**
+ * The slab_stats_get() function stores the statistics of the size
+ * class @p cls in the location pointed to by @p stats. Per-core
+ * counters are read without synchronization, so they are only
+ * accurate when the cluster is quiescent.
+ */
+PUBLIC int slab_stats_get(int cls, struct slab_stats *stats)
+{
+	/* Invalid size class. */
+	if (!WITHIN(cls, 0, SLAB_CLASSES))
+		return (-EINVAL);
+
+	/* Invalid store location. */
+	if (stats == NULL)
+		return (-EINVAL);
+
+	kmemset(stats, 0, sizeof(struct slab_stats));
+	stats->size = slab_class_size(cls);
+	stats->objects = slab_class_objects(cls);
+
+	for (int i = 0; i < CORES_NUM_MAX; i++)
+	{
+		stats->allocs += slab_caches[i][cls].allocs;
+		stats->frees += slab_caches[i][cls].frees;
+		stats->misses += slab_caches[i][cls].misses;
+		stats->failures += slab_caches[i][cls].failures;
+	}
+
+	spinlock_lock(&slab_classes[cls].lock);
+		stats->slabs = slab_classes[cls].nslabs;
+	spinlock_unlock(&slab_classes[cls].lock);
+
+	return (0);
+}
+
+/*============================================================================*
+ * slab_setup()                                                               *
+ *============================================================================*/
+
+/**
+ * The slab_setup() function initializes the slab allocator over the
+ * kernel page pool. Pages are taken from the pool only as size
+ * classes grow.
+ */
+PUBLIC void slab_setup(void)
+{
+	kprintf("[hal][cluster] initializing slab allocator...");
+
+	spinlock_init(&slab_pages.lock);
+	slab_pages.base = TRUNCATE(KPOOL_VIRT, SLAB_SIZE);
+	slab_pages.next = slab_pages.base;
+	slab_pages.end = KPOOL_VIRT + kpool_size;
+	slab_pages.free = NULL;
+
+	for (int i = 0; i < SLAB_CLASSES; i++)
+	{
+		spinlock_init(&slab_classes[i].lock);
+		slab_classes[i].partial = NULL;
+		slab_classes[i].nslabs = 0;
+	}
+
+	kmemset(slab_caches, 0, sizeof(slab_caches));
+}
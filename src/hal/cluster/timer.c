@@ -22,13 +22,30 @@
  * SOFTWARE.
  */
 
-#include <nanvix/hal/cluster/timer.h>
+/* Must come first. */
+#define __NEED_HAL_CLUSTER
+
+#include <nanvix/hal/cluster.h>
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
 
 /*
  * @brief Global clock error
  */
 PRIVATE uint64_t clock_error = 0ULL;
 
+/**
+ * @brief Tickless state of the cores.
+ */
+PRIVATE struct
+{
+	unsigned freq;   /**< Frequency of ticks.       */
+	bool stopped;    /**< Are ticks stopped?        */
+	uint64_t since;  /**< Clock when ticks stopped. */
+	uint64_t nticks; /**< Ticks avoided.            */
+} ALIGN(CACHE_LINE_SIZE) tickless[CORES_NUM_MAX];
+
 /*
  * @brief Returns the clock error
  */
@@ -46,8 +63,75 @@ PUBLIC void timer_init(unsigned freq)
 {
 	uint64_t t1;
 	uint64_t t2;
+
+	tickless[core_get_id()].freq = freq;
+
 	__timer_init(freq);
 	t1 = clock_read();
 	t2 = clock_read();
 	clock_error = t2 - t1;
 }
+
+/**
+ * The timer_tickless_enter() function stops the timer of the
+ * underlying core, so that an idle core does not take ticks that it
+ * has no use for. The number of ticks that were avoided is accounted
+ * in timer_tickless_exit().
+ */
+PUBLIC void timer_tickless_enter(void)
+{
+#ifdef __timer_stop_fn
+	int coreid = core_get_id();
+
+	/* Nothing to stop. */
+	if ((tickless[coreid].freq == 0) || (tickless[coreid].stopped))
+		return;
+
+	__timer_stop();
+	tickless[coreid].since = clock_read();
+	tickless[coreid].stopped = true;
+#endif
+}
+
+/**
+ * The timer_tickless_exit() function restores periodic ticks in the
+ * underlying core, if they were stopped by timer_tickless_enter().
+ */
+PUBLIC void timer_tickless_exit(void)
+{
+#ifdef __timer_stop_fn
+	uint64_t period;
+	int coreid = core_get_id();
+
+	if (!tickless[coreid].stopped)
+		return;
+
+	__timer_restart();
+	tickless[coreid].stopped = false;
+
+	/* Account ticks that would have happened. */
+	period = CLUSTER_FREQ/tickless[coreid].freq;
+	if (period == 0)
+		period = 1;
+	tickless[coreid].nticks += (clock_read() - tickless[coreid].since)/period;
+#endif
+}
+
+/**
+ * The timer_ticks_avoided() function stores in @p nticks the number
+ * of timer ticks that the core @p coreid skipped while idle.
+ */
+PUBLIC int timer_ticks_avoided(int coreid, uint64_t *nticks)
+{
+	/* Invalid core. */
+	if (!WITHIN(coreid, 0, CORES_NUM))
+		return (-EINVAL);
+
+	/* Invalid store location. */
+	if (nticks == NULL)
+		return (-EINVAL);
+
+	*nticks = tickless[coreid].nticks;
+
+	return (0);
+}
@@ -22,13 +22,737 @@
  * SOFTWARE.
  */
 
+/* Must come first. */
+#define __NEED_HAL_CLUSTER
+
+#include <nanvix/hal/cluster.h>
 #include <nanvix/const.h>
 #include <nanvix/hlib.h>
-#include <nanvix/hal/core/_core.h>
-#include <nanvix/hal/core/mmu.h>
+#include <posix/errno.h>
+
+/*============================================================================*
+ * Reverse Map                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Number of entries in the reverse map. Targets that map many
+ * pages export a larger value.
+ */
+#ifndef MMU_RMAP_LENGTH
+#define MMU_RMAP_LENGTH 256
+#endif
+
+/**
+ * @brief Number of buckets in the reverse map (power of two).
+ */
+#define MMU_RMAP_NBUCKETS (MMU_RMAP_LENGTH/4)
+
+/**
+ * @brief Hashes a frame number into a bucket of the reverse map.
+ */
+#define MMU_RMAP_HASH(frame) ((frame) & (MMU_RMAP_NBUCKETS - 1))
+
+/**
+ * @brief Number of page frames in a huge page frame.
+ */
+#define MMU_HUGE_NFRAMES ((frame_t) (PGTAB_SIZE >> PAGE_SHIFT))
+
+/**
+ * @brief Gets the first page frame of the huge page frame of a frame.
+ */
+#define MMU_HUGE_FRAME(frame) ((frame) & ~(MMU_HUGE_NFRAMES - 1))
+
+/**
+ * @brief Asserts whether a page directory entry maps a huge page.
+ */
+#if (CORE_HAS_HUGE_PAGES)
+#define MMU_PDE_IS_HUGE(pde) pde_is_huge(pde)
+#else
+#define MMU_PDE_IS_HUGE(pde) 0
+#endif
+
+/**
+ * @brief Reverse map: page frames to the virtual addresses that map
+ * them. Entries are chained by frame number and linked by index. A
+ * huge page is recorded once, under its first page frame. Each entry
+ * also records the table that holds the mapping, that is, the page
+ * table of a page or the page directory of a huge page, so that the
+ * same page in different address spaces is told apart.
+ */
+PRIVATE struct
+{
+	spinlock_t lock;                /**< Lock.                         */
+	int untracked;                  /**< Mappings left untracked.      */
+	int nused;                      /**< Entries ever handed out.      */
+	int free;                       /**< List of free entries.         */
+	int buckets[MMU_RMAP_NBUCKETS]; /**< Chains of entries.            */
+	struct
+	{
+		frame_t frame;              /**< Page frame.                   */
+		vaddr_t vaddr;              /**< Virtual address of the page.  */
+		void *table;                /**< Table that holds the mapping. */
+		bool huge;                  /**< Huge page?                    */
+		int next;                   /**< Next entry in the chain.      */
+	} entries[MMU_RMAP_LENGTH];     /**< Entries.                      */
+} rmap = {
+	.lock      = SPINLOCK_UNLOCKED,
+	.untracked = 0,
+	.nused     = 0,
+	.free      = -1,
+	.buckets   = { [0 ... (MMU_RMAP_NBUCKETS - 1)] = -1 },
+};
+
+/**
+ * @brief Asserts whether an entry of the reverse map is still live.
+ *
+ * @param i Target entry.
+ *
+ * @returns Non-zero if the table recorded in the entry @p i still
+ * maps its page to its frame, and zero otherwise.
+ *
+ * @note The reverse map should be locked.
+ */
+PRIVATE int mmu_rmap_is_live(int i)
+{
+	struct pte *pte;
+	frame_t frame = rmap.entries[i].frame;
+	vaddr_t vaddr = rmap.entries[i].vaddr;
+
+	/* Huge pages have no page table. */
+	if (rmap.entries[i].huge)
+	{
+#if (CORE_HAS_HUGE_PAGES)
+		struct pde *pde = pde_get(rmap.entries[i].table, vaddr);
+
+		return (pde_is_huge(pde) && (pde_frame_get(pde) == frame));
+#else
+		return (0);
+#endif
+	}
+
+	pte = pte_get(rmap.entries[i].table, vaddr);
+
+	return (pte_is_present(pte) && (pte_frame_get(pte) == frame));
+}
+
+/**
+ * @brief Asserts whether an entry of the reverse map records a page.
+ *
+ * @param i     Target entry.
+ * @param table Table that holds the mapping.
+ * @param frame Page frame.
+ * @param vaddr Virtual address of the page.
+ * @param huge  Huge page?
+ */
+#define MMU_RMAP_MATCH(i, table, frame, vaddr, huge) \
+	(                                                \
+		(rmap.entries[i].frame == (frame)) &&        \
+		(rmap.entries[i].vaddr == (vaddr)) &&        \
+		(rmap.entries[i].table == (table)) &&        \
+		(rmap.entries[i].huge == (huge))             \
+	)
+
+/**
+ * @brief Records that a page maps a frame.
+ *
+ * @param table Table that holds the mapping.
+ * @param frame Page frame.
+ * @param vaddr Virtual address of the page.
+ * @param huge  Huge page?
+ *
+ * @note The reverse map should be locked.
+ */
+PRIVATE void mmu_rmap_insert(void *table, frame_t frame, vaddr_t vaddr, bool huge)
+{
+	int i;
+	int bucket = MMU_RMAP_HASH(frame);
+
+	/* Already recorded. */
+	for (i = rmap.buckets[bucket]; i >= 0; i = rmap.entries[i].next)
+	{
+		if (MMU_RMAP_MATCH(i, table, frame, vaddr, huge))
+			return;
+	}
+
+	/* Allocate entry. */
+	if (rmap.free >= 0)
+	{
+		i = rmap.free;
+		rmap.free = rmap.entries[i].next;
+	}
+	else if (rmap.nused < MMU_RMAP_LENGTH)
+		i = rmap.nused++;
+
+	/* Out of entries. */
+	else
+	{
+		rmap.untracked++;
+		return;
+	}
+
+	rmap.entries[i].frame = frame;
+	rmap.entries[i].vaddr = vaddr;
+	rmap.entries[i].table = table;
+	rmap.entries[i].huge = huge;
+	rmap.entries[i].next = rmap.buckets[bucket];
+	rmap.buckets[bucket] = i;
+}
+
+/**
+ * @brief Forgets that a page maps a frame.
+ *
+ * @param table Table that holds the mapping.
+ * @param frame Page frame.
+ * @param vaddr Virtual address of the page.
+ * @param huge  Huge page?
+ *
+ * @note A mapping that is not found is taken to be one that was left
+ * untracked.
+ *
+ * @note The reverse map should be locked.
+ */
+PRIVATE void mmu_rmap_remove(void *table, frame_t frame, vaddr_t vaddr, bool huge)
+{
+	int *link = &rmap.buckets[MMU_RMAP_HASH(frame)];
+
+	for (int i = *link; i >= 0; i = *link)
+	{
+		if (MMU_RMAP_MATCH(i, table, frame, vaddr, huge))
+		{
+			*link = rmap.entries[i].next;
+			rmap.entries[i].next = rmap.free;
+			rmap.free = i;
+			return;
+		}
+
+		link = &rmap.entries[i].next;
+	}
+
+	if (rmap.untracked > 0)
+		rmap.untracked--;
+}
+
+/*============================================================================*
+ * mmu_page_map()                                                             *
+ *============================================================================*/
+
+/**
+ * The mmu_page_map() function maps the page frame that starts at
+ * @p paddr to the page at @p vaddr, and records this mapping in the
+ * reverse map.
+ */
+PUBLIC int mmu_page_map(struct pte *pgtab, paddr_t paddr, vaddr_t vaddr, int w, int x)
+{
+	int ret;
+
+	if ((ret = __mmu_page_map(pgtab, paddr, vaddr, w, x)) < 0)
+		return (ret);
+
+	spinlock_lock(&rmap.lock);
+		mmu_rmap_insert(pgtab, paddr >> PAGE_SHIFT, vaddr & PAGE_MASK, false);
+	spinlock_unlock(&rmap.lock);
+
+	return (0);
+}
+
+/*============================================================================*
+ * mmu_page_unmap()                                                           *
+ *============================================================================*/
+
+/**
+ * The mmu_page_unmap() function unmaps the page at @p vaddr from the
+ * page table @p pgtab, and drops this mapping from the reverse map.
+ */
+PUBLIC int mmu_page_unmap(struct pte *pgtab, vaddr_t vaddr)
+{
+	frame_t frame;
+	struct pte *pte;
+
+	/* Invalid page table. */
+	if ((pte = pte_get(pgtab, vaddr)) == NULL)
+		return (-EINVAL);
+
+	/* Page not mapped. */
+	if (!pte_is_present(pte))
+		return (-EINVAL);
+
+	frame = pte_frame_get(pte);
+	pte_present_set(pte, 0);
+	pte_frame_set(pte, 0);
+
+	spinlock_lock(&rmap.lock);
+		mmu_rmap_remove(pgtab, frame, vaddr & PAGE_MASK, false);
+	spinlock_unlock(&rmap.lock);
+
+	return (0);
+}
+
+#if (CORE_HAS_HUGE_PAGES)
+
+/*============================================================================*
+ * mmu_huge_page_map()                                                        *
+ *============================================================================*/
+
+/**
+ * The mmu_huge_page_map() function maps the huge page frame that
+ * starts at @p paddr to the huge page at @p vaddr, and records this
+ * mapping in the reverse map. A huge page spans as much memory as a
+ * page table, and both addresses should be aligned to that size.
+ */
+PUBLIC int mmu_huge_page_map(struct pte *pgdir, paddr_t paddr, vaddr_t vaddr, int w, int x)
+{
+	int ret;
+
+	/* Misaligned huge page. */
+	if ((paddr | vaddr) & ~PGTAB_MASK)
+		return (-EINVAL);
+
+	if ((ret = __mmu_huge_page_map(pgdir, paddr, vaddr, w, x)) < 0)
+		return (ret);
+
+	spinlock_lock(&rmap.lock);
+		mmu_rmap_insert(pgdir, paddr >> PAGE_SHIFT, vaddr, true);
+	spinlock_unlock(&rmap.lock);
+
+	return (0);
+}
+
+/*============================================================================*
+ * mmu_huge_page_unmap()                                                      *
+ *============================================================================*/
+
+/**
+ * The mmu_huge_page_unmap() function unmaps the huge page at @p vaddr
+ * from the page directory @p pgdir, and drops this mapping from the
+ * reverse map.
+ */
+PUBLIC int mmu_huge_page_unmap(struct pte *pgdir, vaddr_t vaddr)
+{
+	frame_t frame;
+	struct pde *pde;
+
+	/* Invalid page directory. */
+	if ((pde = pde_get((struct pde *) pgdir, vaddr)) == NULL)
+		return (-EINVAL);
+
+	/* Huge page not mapped. */
+	if (!pde_is_huge(pde))
+		return (-EINVAL);
+
+	frame = pde_frame_get(pde);
+	pde_clear(pde);
+
+	spinlock_lock(&rmap.lock);
+		mmu_rmap_remove(pgdir, frame, vaddr & PGTAB_MASK, true);
+	spinlock_unlock(&rmap.lock);
+
+	return (0);
+}
+
+#endif
+
+/*============================================================================*
+ * mmu_map_range()                                                            *
+ *============================================================================*/
+
+/**
+ * @brief Gets the page table that covers a virtual address.
+ *
+ * @param pgdir Target page directory.
+ * @param vaddr Target virtual address.
+ *
+ * @returns The page table that covers @p vaddr in @p pgdir, or NULL
+ * if there is no such page table.
+ */
+PRIVATE struct pte *mmu_pgtab_get(struct pde *pgdir, vaddr_t vaddr)
+{
+	struct pde *pde;
+
+	if ((pde = pde_get(pgdir, vaddr)) == NULL)
+		return (NULL);
+
+	if (!pde_is_present(pde) || MMU_PDE_IS_HUGE(pde))
+		return (NULL);
+
+	return ((struct pte *)(pde_frame_get(pde) << PAGE_SHIFT));
+}
+
+/**
+ * @brief Gets the number of pages of a range that fall into the
+ * page table of its first page.
+ *
+ * @param vaddr  Virtual address of the first page.
+ * @param npages Number of pages in the range.
+ */
+PRIVATE size_t mmu_range_chunk(vaddr_t vaddr, size_t npages)
+{
+	size_t n = (PGTAB_SIZE - (vaddr & (PGTAB_SIZE - 1))) >> PAGE_SHIFT;
+
+	return ((npages < n) ? npages : n);
+}
+
+/**
+ * @brief Asserts whether a chunk of a range is (un)mapped with a
+ * single huge page.
+ *
+ * @param pgdir Target page directory.
+ * @param paddr Physical address of the first page frame.
+ * @param vaddr Virtual address of the first page.
+ * @param n     Number of pages in the chunk.
+ * @param map   Map the chunk? Otherwise, unmap it.
+ *
+ * @returns Non-zero if the chunk spans a whole page table and either
+ * can be mapped with a huge page or is mapped by one, and zero
+ * otherwise. A page table that is already in place is kept.
+ */
+PRIVATE int mmu_range_is_huge(struct pde *pgdir, paddr_t paddr, vaddr_t vaddr, size_t n, bool map)
+{
+#if (CORE_HAS_HUGE_PAGES)
+	struct pde *pde;
+
+	/* Huge pages span whole page tables. */
+	if (n != MMU_HUGE_NFRAMES)
+		return (0);
+
+	pde = pde_get(pgdir, vaddr);
+
+	if (!map)
+		return (pde_is_huge(pde));
+
+	/* Misaligned huge page frame. */
+	if (paddr & ~PGTAB_MASK)
+		return (0);
+
+	return (!pde_is_present(pde) || pde_is_huge(pde));
+#else
+	UNUSED(pgdir);
+	UNUSED(paddr);
+	UNUSED(vaddr);
+	UNUSED(n);
+	UNUSED(map);
+
+	return (0);
+#endif
+}
+
+/**
+ * @brief Asserts whether a range of pages can be (un)mapped.
+ *
+ * @param pgdir  Target page directory.
+ * @param paddr  Physical address of the first page frame.
+ * @param vaddr  Virtual address of the first page.
+ * @param npages Number of pages.
+ * @param map    Map the range? Otherwise, unmap it.
+ *
+ * @returns Zero if every page table that covers the range is
+ * present, or if the chunk of the range that it would cover is
+ * handled by a huge page instead, and a negative error code
+ * otherwise.
+ */
+PRIVATE int mmu_range_check(struct pde *pgdir, paddr_t paddr, vaddr_t vaddr, size_t npages, bool map)
+{
+	size_t n;
+
+	/* Invalid page directory. */
+	if (pgdir == NULL)
+		return (-EINVAL);
+
+	/* Empty range. */
+	if (npages == 0)
+		return (-EINVAL);
+
+	/* Misaligned range. */
+	if (vaddr & ~PAGE_MASK)
+		return (-EINVAL);
+
+	/* Range wraps around. */
+	if ((npages - 1) > ((~((vaddr_t) 0) - vaddr) >> PAGE_SHIFT))
+		return (-EINVAL);
+
+	/* Page tables must be in place. */
+	for ( ; npages > 0; paddr += n << PAGE_SHIFT, vaddr += n << PAGE_SHIFT, npages -= n)
+	{
+		n = mmu_range_chunk(vaddr, npages);
+
+		if (mmu_range_is_huge(pgdir, paddr, vaddr, n, map))
+			continue;
+
+		if (mmu_pgtab_get(pgdir, vaddr) == NULL)
+			return (-EFAULT);
+	}
+
+	return (0);
+}
+
+/**
+ * @brief Unmaps a range of pages.
+ *
+ * @param pgdir  Target page directory.
+ * @param vaddr  Virtual address of the first page.
+ * @param npages Number of pages.
+ *
+ * @note The reverse map should be locked.
+ * @note The range should have been checked with mmu_range_check().
+ */
+PRIVATE void mmu_range_unmap(struct pde *pgdir, vaddr_t vaddr, size_t npages)
+{
+	size_t n;
+	struct pte *pte;
+	struct pte *pgtab;
+
+	for ( ; npages > 0; npages -= n)
+	{
+		n = mmu_range_chunk(vaddr, npages);
+
+		/* Whole huge page. */
+		if (mmu_range_is_huge(pgdir, 0, vaddr, n, false))
+		{
+			struct pde *pde = pde_get(pgdir, vaddr);
+
+			mmu_rmap_remove(pgdir, pde_frame_get(pde), vaddr, true);
+			pde_clear(pde);
+			vaddr += PGTAB_SIZE;
+			continue;
+		}
+
+		pgtab = mmu_pgtab_get(pgdir, vaddr);
+		pte = pte_get(pgtab, vaddr);
+
+		for (size_t i = 0; i < n; i++, vaddr += PAGE_SIZE)
+		{
+			if (!pte_is_present(&pte[i]))
+				continue;
+
+			mmu_rmap_remove(pgtab, pte_frame_get(&pte[i]), vaddr, false);
+			pte_present_set(&pte[i], 0);
+			pte_frame_set(&pte[i], 0);
+		}
+	}
+}
+
+/**
+ * The mmu_map_range() function maps @p npages contiguous page frames
+ * starting at @p paddr to contiguous pages starting at @p vaddr in
+ * the page directory @p pgdir. Each page table is looked up once,
+ * and the TLB is flushed once, after all pages are mapped. Where the
+ * range spans a whole page table that is not in place, and the core
+ * supports it, a huge page is mapped instead, so that part of the
+ * range can later be unmapped only as a whole. If mapping a page
+ * fails, the pages mapped so far are unmapped.
+ */
+PUBLIC int mmu_map_range(struct pde *pgdir, paddr_t paddr, vaddr_t vaddr, size_t npages, int w, int x)
+{
+	int ret;
+	size_t n;
+	vaddr_t start;
+	struct pte *pgtab;
+
+	/* Misaligned frame. */
+	if (paddr & ~PAGE_MASK)
+		return (-EINVAL);
+
+	if ((ret = mmu_range_check(pgdir, paddr, vaddr, npages, true)) < 0)
+		return (ret);
+
+	start = vaddr;
+
+	spinlock_lock(&rmap.lock);
+
+		for ( ; npages > 0; npages -= n)
+		{
+			n = mmu_range_chunk(vaddr, npages);
+
+#if (CORE_HAS_HUGE_PAGES)
+			/* Whole page table. */
+			if (mmu_range_is_huge(pgdir, paddr, vaddr, n, true))
+			{
+				struct pde *pde = pde_get(pgdir, vaddr);
+				bool replace = pde_is_huge(pde);
+				frame_t frame = pde_frame_get(pde);
+
+				if ((ret = __mmu_huge_page_map((struct pte *) pgdir, paddr, vaddr, w, x)) < 0)
+					goto out;
+
+				if (replace)
+					mmu_rmap_remove(pgdir, frame, vaddr, true);
+				mmu_rmap_insert(pgdir, paddr >> PAGE_SHIFT, vaddr, true);
+				paddr += PGTAB_SIZE;
+				vaddr += PGTAB_SIZE;
+				continue;
+			}
+#endif
+
+			pgtab = mmu_pgtab_get(pgdir, vaddr);
+
+			for (size_t i = 0; i < n; i++, paddr += PAGE_SIZE, vaddr += PAGE_SIZE)
+			{
+				if ((ret = __mmu_page_map(pgtab, paddr, vaddr, w, x)) < 0)
+					goto out;
+
+				mmu_rmap_insert(pgtab, paddr >> PAGE_SHIFT, vaddr, false);
+			}
+		}
+
+out:
+		/* Roll back. */
+		if ((ret < 0) && (vaddr > start))
+			mmu_range_unmap(pgdir, start, (vaddr - start) >> PAGE_SHIFT);
+
+	spinlock_unlock(&rmap.lock);
+
+	tlb_flush();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * mmu_unmap_range()                                                          *
+ *============================================================================*/
+
+/**
+ * The mmu_unmap_range() function unmaps @p npages contiguous pages
+ * starting at @p vaddr from the page directory @p pgdir. Pages that
+ * are not mapped are skipped. Huge pages are unmapped only as a
+ * whole. The TLB is flushed once, after all pages are unmapped.
+ */
+PUBLIC int mmu_unmap_range(struct pde *pgdir, vaddr_t vaddr, size_t npages)
+{
+	int ret;
+
+	if ((ret = mmu_range_check(pgdir, 0, vaddr, npages, false)) < 0)
+		return (ret);
+
+	spinlock_lock(&rmap.lock);
+		mmu_range_unmap(pgdir, vaddr, npages);
+	spinlock_unlock(&rmap.lock);
+
+	tlb_flush();
+
+	return (0);
+}
+
+/*============================================================================*
+ * mmu_page_mappings()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Asserts whether an entry of the reverse map records a page
+ * of an address space.
+ *
+ * @param i     Target entry.
+ * @param pgdir Target page directory (NULL for any).
+ *
+ * @returns Non-zero if the table recorded in the entry @p i is
+ * @p pgdir or one of its page tables, and zero otherwise.
+ */
+PRIVATE int mmu_rmap_is_in(int i, struct pde *pgdir)
+{
+	if (pgdir == NULL)
+		return (1);
+
+	if (rmap.entries[i].huge)
+		return (rmap.entries[i].table == (void *) pgdir);
+
+	return (rmap.entries[i].table == mmu_pgtab_get(pgdir, rmap.entries[i].vaddr));
+}
+
+/**
+ * @brief Enumerates the pages of one chain of the reverse map that
+ * map a page frame.
+ *
+ * @param pgdir     Target page directory (NULL for any).
+ * @param key       First page frame of the target mappings.
+ * @param huge      Huge page mappings?
+ * @param frame     Target page frame.
+ * @param vaddrs    Store location for virtual addresses.
+ * @param n         Capacity of @p vaddrs.
+ * @param nmappings Number of pages enumerated so far.
+ *
+ * @returns The number of pages enumerated so far, including the
+ * ones of this chain.
+ *
+ * @note The reverse map should be locked.
+ */
+PRIVATE int mmu_rmap_lookup(struct pde *pgdir, frame_t key, bool huge, frame_t frame, vaddr_t *vaddrs, int n, int nmappings)
+{
+	int *link = &rmap.buckets[MMU_RMAP_HASH(key)];
+
+	for (int i = *link; i >= 0; i = *link)
+	{
+		if ((rmap.entries[i].frame == key) && (rmap.entries[i].huge == huge))
+		{
+			/* Stale mapping. */
+			if (!mmu_rmap_is_live(i))
+			{
+				*link = rmap.entries[i].next;
+				rmap.entries[i].next = rmap.free;
+				rmap.free = i;
+				continue;
+			}
+
+			if (mmu_rmap_is_in(i, pgdir))
+			{
+				if (nmappings < n)
+					vaddrs[nmappings] = rmap.entries[i].vaddr + ((vaddr_t)(frame - key) << PAGE_SHIFT);
+				nmappings++;
+			}
+		}
+
+		link = &rmap.entries[i].next;
+	}
+
+	return (nmappings);
+}
+
+/**
+ * @brief Enumerates the pages that map a page frame.
+ *
+ * @param pgdir  Target page directory (NULL for any).
+ * @param frame  Target page frame.
+ * @param vaddrs Store location for virtual addresses.
+ * @param n      Capacity of @p vaddrs.
+ *
+ * @returns The number of pages that map @p frame.
+ */
+PRIVATE int mmu_rmap_mappings(struct pde *pgdir, frame_t frame, vaddr_t *vaddrs, int n)
+{
+	int nmappings;
+
+	spinlock_lock(&rmap.lock);
+
+		nmappings = mmu_rmap_lookup(pgdir, frame, false, frame, vaddrs, n, 0);
+#if (CORE_HAS_HUGE_PAGES)
+		nmappings = mmu_rmap_lookup(pgdir, MMU_HUGE_FRAME(frame), true, frame, vaddrs, n, nmappings);
+#endif
+
+	spinlock_unlock(&rmap.lock);
+
+	return (nmappings);
+}
+
+/**
+ * The mmu_page_mappings() function stores in @p vaddrs the virtual
+ * addresses of up to @p n pages that map the page frame of @p paddr,
+ * either on their own or as part of a huge page, in any address
+ * space. Mappings that were dropped without mmu_page_unmap() are
+ * pruned from the reverse map along the way.
+ */
+PUBLIC int mmu_page_mappings(paddr_t paddr, vaddr_t *vaddrs, int n)
+{
+	/* Invalid store location. */
+	if ((vaddrs == NULL) || (n < 0))
+		return (-EINVAL);
+
+	return (mmu_rmap_mappings(NULL, paddr >> PAGE_SHIFT, vaddrs, n));
+}
 
 #ifndef __unix64__
 
+/*============================================================================*
+ * mmu_page_walk()                                                            *
+ *============================================================================*/
+
+
 /**
  * @brief Megabyte shift
  */
@@ -59,7 +783,7 @@
  * @brief Searches for a page belonging to a given physical
  * address.
  *
- * The mmu_page_walk function does a page walk in the system
+ * The mmu_page_walk_slow function does a page walk in the system
  * and returns the virtual address of the page belonging the
  * given physical address.
  *
@@ -69,7 +793,7 @@
  *
  * @author Davidson Francis
  */
-PUBLIC void* mmu_page_walk(paddr_t paddr)
+PRIVATE void* mmu_page_walk_slow(paddr_t paddr)
 {
 	paddr_t paddr_aligned; /* Physical address aligned.       */
 	vaddr_t vaddr_pgdir;   /* Page dir loop index.            */
@@ -90,6 +814,18 @@ PUBLIC void* mmu_page_walk(paddr_t paddr)
 		if (!pde_is_present(pde))
 			continue;
 
+		/* Huge page. */
+		if (MMU_PDE_IS_HUGE(pde))
+		{
+			if ((pde_frame_get(pde) << PAGE_SHIFT) == (paddr & PGTAB_MASK))
+			{
+				vaddr = vaddr_pgdir + (paddr_aligned & ~PGTAB_MASK);
+				goto out;
+			}
+
+			continue;
+		}
+
 		pgtab = (struct pte *)(pde_frame_get(pde) << PAGE_SHIFT);
 
 		for (vaddr_pgtab = 0; vaddr_pgtab < PGTAB_ADDR_END;
@@ -114,4 +850,23 @@ out:
 		return (void*)(vaddr + (paddr - paddr_aligned));
 }
 
+/**
+ * The mmu_page_walk() function looks up the virtual address of the
+ * physical address @p paddr in the root page directory, using the
+ * reverse map. The page tables are walked only if the reverse map
+ * ran out of entries and some mappings may be missing from it.
+ */
+PUBLIC void* mmu_page_walk(paddr_t paddr)
+{
+	vaddr_t vaddr;
+
+	if (mmu_rmap_mappings(root_pgdir, paddr >> PAGE_SHIFT, &vaddr, 1) > 0)
+		return ((void *)(vaddr + (paddr & ~PAGE_MASK)));
+
+	if (rmap.untracked > 0)
+		return (mmu_page_walk_slow(paddr));
+
+	return (NULL);
+}
+
 #endif
@@ -0,0 +1,459 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __NEED_RESOURCE
+
+#include <nanvix/hal/target/barrier.h>
+#include <nanvix/hal/target/sync.h>
+#include <nanvix/hal/resource.h>
+#include <posix/errno.h>
+#include <posix/stddef.h>
+#include <posix/stdint.h>
+
+/**
+ * @brief Can this barrier span multiple clusters?
+ */
+#define BARRIER_HAS_SYNC (__TARGET_HAS_SYNC && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+/**
+ * @brief Table of hierarchical barriers.
+ */
+PRIVATE struct barrier
+{
+	/*
+	 * XXX: Don't Touch! This Must Come First!
+	 */
+	struct resource resource; /**< Generic resource information.    */
+
+	spinlock_t lock;          /**< Local lock.                      */
+	int ncores;               /**< Number of local participants.    */
+	volatile int nreached;    /**< Local participants that arrived. */
+	volatile unsigned round;  /**< Number of completed rounds.      */
+	volatile int status[2];   /**< Status of the last two rounds.   */
+
+	int nnodes;               /**< Number of NoC nodes.             */
+	bool leader;              /**< Is the local node the leader?    */
+	int gather;               /**< Gather synchronization point.    */
+	int release;              /**< Release synchronization point.   */
+} barriers[HAL_BARRIER_MAX];
+
+/**
+ * @brief Pool of hierarchical barriers.
+ */
+PRIVATE const struct resource_pool pool = {
+	barriers, HAL_BARRIER_MAX, sizeof(struct barrier)
+};
+
+/**
+ * @brief Barrier module lock.
+ */
+PRIVATE spinlock_t barrier_lock = SPINLOCK_UNLOCKED;
+
+/*============================================================================*
+ * barrier_is_valid()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Asserts whether or not a barrier is valid.
+ *
+ * @param barrierid ID of the target barrier.
+ *
+ * @returns One if the target barrier is valid, and zero otherwise.
+ */
+PRIVATE int barrier_is_valid(int barrierid)
+{
+	return (WITHIN(barrierid, 0, HAL_BARRIER_MAX));
+}
+
+/*============================================================================*
+ * barrier_sync_create()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Allocates the synchronization points of a barrier.
+ *
+ * The leader node gathers signals from all other nodes in an
+ * all-to-one synchronization point, and then releases them through
+ * an one-to-all synchronization point.
+ *
+ * @param b      Target barrier.
+ * @param nodes  IDs of target NoC nodes.
+ * @param nnodes Number of target NoC nodes.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int barrier_sync_create(struct barrier *b, const int *nodes, int nnodes)
+{
+#if (BARRIER_HAS_SYNC)
+	b->leader = (nodes[0] == processor_node_get_num());
+
+	/* Leader. */
+	if (b->leader)
+	{
+		if ((b->gather = sync_create(nodes, nnodes, SYNC_ALL_TO_ONE)) < 0)
+			return (b->gather);
+
+		if ((b->release = sync_open(nodes, nnodes, SYNC_ONE_TO_ALL)) < 0)
+		{
+			KASSERT(sync_unlink(b->gather) == 0);
+			return (b->release);
+		}
+	}
+
+	/* Follower. */
+	else
+	{
+		if ((b->gather = sync_open(nodes, nnodes, SYNC_ALL_TO_ONE)) < 0)
+			return (b->gather);
+
+		if ((b->release = sync_create(nodes, nnodes, SYNC_ONE_TO_ALL)) < 0)
+		{
+			KASSERT(sync_close(b->gather) == 0);
+			return (b->release);
+		}
+	}
+
+	return (0);
+#else
+	UNUSED(b);
+	UNUSED(nodes);
+	UNUSED(nnodes);
+
+	return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * barrier_sync_destroy()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Releases the synchronization points of a barrier.
+ *
+ * @param b Target barrier.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int barrier_sync_destroy(struct barrier *b)
+{
+#if (BARRIER_HAS_SYNC)
+	int ret;
+
+	if (b->leader)
+	{
+		if ((ret = sync_unlink(b->gather)) < 0)
+			return (ret);
+
+		return (sync_close(b->release));
+	}
+
+	if ((ret = sync_close(b->gather)) < 0)
+		return (ret);
+
+	return (sync_unlink(b->release));
+#else
+	UNUSED(b);
+
+	return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * barrier_sync_signal()                                                      *
+ *============================================================================*/
+
+#if (BARRIER_HAS_SYNC)
+
+/**
+ * @brief Signals a synchronization point, retrying while busy.
+ *
+ * @param syncid ID of the target synchronization point.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int barrier_sync_signal(int syncid)
+{
+	int ret;
+
+	do
+		ret = sync_signal(syncid);
+	while (ret == (-EAGAIN));
+
+	return (ret);
+}
+
+#endif
+
+/*============================================================================*
+ * barrier_sync_wait()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Synchronizes the local node with the other nodes of a barrier.
+ *
+ * @param b Target barrier.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ *
+ * @note Only the representative core of the local node calls this
+ * function.
+ */
+PRIVATE int barrier_sync_wait(struct barrier *b)
+{
+#if (BARRIER_HAS_SYNC)
+	int ret;
+
+	/* Local barrier. */
+	if (b->nnodes == 1)
+		return (0);
+
+	/* Leader: gather everyone and then release them. */
+	if (b->leader)
+	{
+		if ((ret = sync_wait(b->gather)) < 0)
+			return (ret);
+
+		return (barrier_sync_signal(b->release));
+	}
+
+	/* Follower: notify the leader and wait for release. */
+	if ((ret = barrier_sync_signal(b->gather)) < 0)
+		return (ret);
+
+	return (sync_wait(b->release));
+#else
+	UNUSED(b);
+
+	return (0);
+#endif
+}
+
+/*============================================================================*
+ * barrier_create()                                                           *
+ *============================================================================*/
+
+/**
+ * The barrier_create() function creates a hierarchical barrier that
+ * spans @p ncores cores in each one of the NoC nodes listed in @p
+ * nodes. The first node in the list is the leader of the barrier. If
+ * @p nnodes equals to one, the barrier is local to the underlying
+ * cluster and no synchronization points are allocated.
+ *
+ * @note This function should be called once in each node of the
+ * barrier, before any core waits on it.
+ */
+PUBLIC int barrier_create(const int *nodes, int nnodes, int ncores)
+{
+	int ret;
+	int barrierid;
+	struct barrier *b;
+
+	/* Invalid nodes list. */
+	if (nodes == NULL)
+		return (-EINVAL);
+
+	/* Bad nodes list. */
+	if (!WITHIN(nnodes, 1, PROCESSOR_NOC_NODES_NUM + 1))
+		return (-EINVAL);
+
+	/* Bad number of cores. */
+	if (!WITHIN(ncores, 1, CORES_NUM + 1))
+		return (-EINVAL);
+
+	/* Local barrier on a remote node. */
+	if ((nnodes == 1) && (nodes[0] != processor_node_get_num()))
+		return (-EINVAL);
+
+	spinlock_lock(&barrier_lock);
+
+		/* Allocate a barrier. */
+		if ((barrierid = resource_alloc(&pool)) < 0)
+		{
+			spinlock_unlock(&barrier_lock);
+			return (-EAGAIN);
+		}
+
+		b = &barriers[barrierid];
+
+		/* Allocate synchronization points. */
+		if ((nnodes > 1) && ((ret = barrier_sync_create(b, nodes, nnodes)) < 0))
+		{
+			resource_free(&pool, barrierid);
+			spinlock_unlock(&barrier_lock);
+			return (ret);
+		}
+
+		/* Initialize barrier. */
+		spinlock_init(&b->lock);
+		b->ncores   = ncores;
+		b->nreached = 0;
+		b->round     = 0;
+		b->status[0] = 0;
+		b->status[1] = 0;
+		b->nnodes   = nnodes;
+
+		dcache_invalidate();
+
+	spinlock_unlock(&barrier_lock);
+
+	return (barrierid);
+}
+
+/*============================================================================*
+ * barrier_destroy()                                                          *
+ *============================================================================*/
+
+/**
+ * The barrier_destroy() function destroys the hierarchical barrier
+ * whose ID equals to @p barrierid.
+ *
+ * @note No core should be waiting on the target barrier.
+ */
+PUBLIC int barrier_destroy(int barrierid)
+{
+	int ret;
+	struct barrier *b;
+
+	/* Invalid barrier. */
+	if (!barrier_is_valid(barrierid))
+		return (-EBADF);
+
+	b = &barriers[barrierid];
+
+	spinlock_lock(&barrier_lock);
+
+		/* Bad barrier. */
+		if (!resource_is_used(&b->resource))
+		{
+			spinlock_unlock(&barrier_lock);
+			return (-EBADF);
+		}
+
+		/* Busy barrier. */
+		spinlock_lock(&b->lock);
+		dcache_invalidate();
+		if (b->nreached != 0)
+		{
+			spinlock_unlock(&b->lock);
+			spinlock_unlock(&barrier_lock);
+			return (-EBUSY);
+		}
+		spinlock_unlock(&b->lock);
+
+		/* Release synchronization points. */
+		if ((b->nnodes > 1) && ((ret = barrier_sync_destroy(b)) < 0))
+		{
+			spinlock_unlock(&barrier_lock);
+			return (ret);
+		}
+
+		resource_free(&pool, barrierid);
+
+		dcache_invalidate();
+
+	spinlock_unlock(&barrier_lock);
+
+	return (0);
+}
+
+/*============================================================================*
+ * barrier_wait()                                                             *
+ *============================================================================*/
+
+/**
+ * The barrier_wait() function waits on the hierarchical barrier
+ * whose ID equals to @p barrierid. The calling core blocks until
+ * all local participants have reached the barrier and, in case of a
+ * multi-cluster barrier, until all remote nodes have done so too.
+ *
+ * The last core to arrive in the local cluster is the
+ * representative of the cluster: it alone exchanges signals with
+ * the remote nodes and then releases the local cores by advancing
+ * the round counter of the barrier. The status of the round is
+ * recorded in a slot selected by the parity of the round, so that a
+ * released core reads the status of its own round even if a later
+ * round has already started.
+ */
+PUBLIC int barrier_wait(int barrierid)
+{
+	int ret;
+	unsigned round;
+	struct barrier *b;
+
+	/* Invalid barrier. */
+	if (!barrier_is_valid(barrierid))
+		return (-EBADF);
+
+	b = &barriers[barrierid];
+
+	spinlock_lock(&b->lock);
+	dcache_invalidate();
+
+		/* Bad barrier. */
+		if (!resource_is_used(&b->resource))
+		{
+			spinlock_unlock(&b->lock);
+			return (-EBADF);
+		}
+
+		round = b->round;
+
+		/* Not the last local core: wait for release. */
+		if (++b->nreached < b->ncores)
+		{
+			dcache_invalidate();
+			spinlock_unlock(&b->lock);
+
+			do
+				dcache_invalidate();
+			while (b->round == round);
+
+			/*
+			 * Statuses are kept per round parity, so this one
+			 * stays put until the next round also completes.
+			 */
+			return (b->status[round & 1]);
+		}
+
+		b->nreached = 0;
+
+	spinlock_unlock(&b->lock);
+
+	/* Representative core: synchronize with remote nodes. */
+	ret = barrier_sync_wait(b);
+
+	/* Release local cores. */
+	spinlock_lock(&b->lock);
+		b->status[round & 1] = ret;
+		b->round++;
+	dcache_invalidate();
+	spinlock_unlock(&b->lock);
+
+	return (ret);
+}
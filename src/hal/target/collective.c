@@ -0,0 +1,1085 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __NEED_RESOURCE
+
+#include <nanvix/hal/target/collective.h>
+#include <nanvix/hal/target/portal.h>
+#include <nanvix/hal/resource.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+#include <posix/stddef.h>
+#include <posix/stdint.h>
+
+/**
+ * @brief Are collectives supported?
+ */
+#define COLLECTIVE_HAS_PORTAL (__TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+#if (COLLECTIVE_HAS_PORTAL)
+
+/**
+ * @brief Table of collectives.
+ */
+PRIVATE struct collective
+{
+	/*
+	 * XXX: Don't Touch! This Must Come First!
+	 */
+	struct resource resource;                  /**< Generic resource information. */
+
+	int rank;                                  /**< Rank of the local node.       */
+	int nnodes;                                /**< Number of NoC nodes.          */
+	int nodes[PROCESSOR_NOC_NODES_NUM];        /**< IDs of NoC nodes.             */
+	char scratch[HAL_COLLECTIVE_SEGMENT_SIZE]; /**< Scratch segment.              */
+} collectives[HAL_COLLECTIVE_MAX];
+
+/**
+ * @brief Pool of collectives.
+ */
+PRIVATE const struct resource_pool pool = {
+	collectives, HAL_COLLECTIVE_MAX, sizeof(struct collective)
+};
+
+/**
+ * @brief Portals shared by all collectives.
+ *
+ * A NoC node has a single input portal, and a single output portal
+ * to each remote. Thus, these are opened once and shared.
+ */
+PRIVATE struct
+{
+	int nusers;                              /**< Number of live collectives. */
+	int inportal;                            /**< Input portal.               */
+	int outportals[PROCESSOR_NOC_NODES_NUM]; /**< Output portals.             */
+} portals = {
+	.nusers     = 0,
+	.inportal   = -1,
+	.outportals = { [0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = -1 },
+};
+
+/**
+ * @brief Collective module lock.
+ */
+PRIVATE spinlock_t collective_lock = SPINLOCK_UNLOCKED;
+
+/**
+ * @brief Collective operation lock.
+ *
+ * All collectives share the input portal of the local node, thus
+ * operations are serialized. The lock also guards the scratch
+ * segments of collectives.
+ */
+PRIVATE spinlock_t collective_op_lock = SPINLOCK_UNLOCKED;
+
+/*============================================================================*
+ * collective_get()                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Gets a collective.
+ *
+ * @param collid ID of the target collective.
+ *
+ * @returns Upon successful completion, a pointer to the target
+ * collective is returned. Upon failure, NULL is returned instead.
+ */
+PRIVATE struct collective *collective_get(int collid)
+{
+	/* Invalid collective. */
+	if (!WITHIN(collid, 0, HAL_COLLECTIVE_MAX))
+		return (NULL);
+
+	/* Bad collective. */
+	if (!resource_is_used(&collectives[collid].resource))
+		return (NULL);
+
+	return (&collectives[collid]);
+}
+
+/*============================================================================*
+ * collective_enter()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Starts an operation on a collective.
+ *
+ * @param collid ID of the target collective.
+ *
+ * @returns Upon successful completion, a pointer to the target
+ * collective is returned, and the operation lock is held. Upon
+ * failure, NULL is returned instead.
+ */
+PRIVATE struct collective *collective_enter(int collid)
+{
+	struct collective *coll;
+
+	spinlock_lock(&collective_op_lock);
+
+	if ((coll = collective_get(collid)) == NULL)
+		spinlock_unlock(&collective_op_lock);
+
+	return (coll);
+}
+
+/*============================================================================*
+ * collective_leave()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Ends an operation on a collective.
+ */
+PRIVATE void collective_leave(void)
+{
+	spinlock_unlock(&collective_op_lock);
+}
+
+/*============================================================================*
+ * collective_node()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Gets the NoC node of a rank, relative to a root.
+ *
+ * @param coll  Target collective.
+ * @param root  Rank of the root.
+ * @param vrank Rank relative to @p root.
+ *
+ * @returns The ID of the NoC node of @p vrank.
+ */
+PRIVATE inline int collective_node(const struct collective *coll, int root, int vrank)
+{
+	return (coll->nodes[(vrank + root) % coll->nnodes]);
+}
+
+/*============================================================================*
+ * collective_outportal()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Gets the output portal to a remote, opening it if needed.
+ *
+ * @param nodenum ID of the target NoC node.
+ *
+ * @returns Upon successful completion, the ID of the output portal
+ * is returned. Upon failure, a negative error code is returned
+ * instead.
+ */
+PRIVATE int collective_outportal(int nodenum)
+{
+	int portalid;
+
+	spinlock_lock(&collective_lock);
+
+		if ((portalid = portals.outportals[nodenum]) < 0)
+		{
+			portalid = portal_open(processor_node_get_num(), nodenum);
+
+			if (portalid >= 0)
+				portals.outportals[nodenum] = portalid;
+		}
+
+	spinlock_unlock(&collective_lock);
+
+	return (portalid);
+}
+
+/*============================================================================*
+ * collective_send()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Sends a buffer to a remote, one segment at a time.
+ *
+ * @param nodenum ID of the target NoC node.
+ * @param buffer  Target buffer.
+ * @param size    Size of the buffer.
+ * @param segsize Size of a segment.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int collective_send(int nodenum, const void *buffer, size_t size, size_t segsize)
+{
+	int portalid;
+	ssize_t ret;
+
+	if ((portalid = collective_outportal(nodenum)) < 0)
+		return (portalid);
+
+	for (size_t off = 0; off < size; off += segsize)
+	{
+		size_t n = ((size - off) < segsize) ? (size - off) : segsize;
+
+		/* Wait for the remote to allow us. */
+		do
+			ret = portal_awrite(portalid, (const char *) buffer + off, n);
+		while ((ret == -EACCES) || (ret == -EBUSY));
+
+		if (ret < 0)
+			return (ret);
+
+		if ((ret = portal_wait(portalid)) < 0)
+			return (ret);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * collective_recv()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Receives a segment from a remote.
+ *
+ * @param nodenum ID of the target NoC node.
+ * @param buffer  Target buffer.
+ * @param size    Size of the segment.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int do_collective_recv(int nodenum, void *buffer, size_t size)
+{
+	ssize_t ret;
+
+	if ((ret = portal_allow(portals.inportal, nodenum)) < 0)
+		return (ret);
+
+	do
+		ret = portal_aread(portals.inportal, buffer, size);
+	while ((ret == -EBUSY) || (ret == -ENOMSG));
+
+	if (ret < 0)
+		return (ret);
+
+	return (portal_wait(portals.inportal));
+}
+
+/**
+ * @brief Receives a buffer from a remote, one segment at a time.
+ *
+ * @param nodenum ID of the target NoC node.
+ * @param buffer  Target buffer.
+ * @param size    Size of the buffer.
+ * @param segsize Size of a segment.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int collective_recv(int nodenum, void *buffer, size_t size, size_t segsize)
+{
+	int ret;
+
+	for (size_t off = 0; off < size; off += segsize)
+	{
+		size_t n = ((size - off) < segsize) ? (size - off) : segsize;
+
+		if ((ret = do_collective_recv(nodenum, (char *) buffer + off, n)) < 0)
+			return (ret);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * collective_recv_combine()                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Receives elements from a remote and combines them.
+ *
+ * @param coll    Target collective.
+ * @param nodenum ID of the target NoC node.
+ * @param acc     Accumulated elements.
+ * @param nelems  Number of elements.
+ * @param elsize  Size of an element.
+ * @param combine Combine function.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int collective_recv_combine(
+	struct collective *coll,
+	int nodenum,
+	void *acc,
+	size_t nelems,
+	size_t elsize,
+	collective_combine_fn combine
+)
+{
+	int ret;
+	size_t chunk;
+
+	/* Segments hold whole elements. */
+	chunk = HAL_COLLECTIVE_SEGMENT_SIZE/elsize;
+
+	for (size_t i = 0; i < nelems; i += chunk)
+	{
+		size_t n = ((nelems - i) < chunk) ? (nelems - i) : chunk;
+
+		if ((ret = do_collective_recv(nodenum, coll->scratch, n*elsize)) < 0)
+			return (ret);
+
+		combine((char *) acc + i*elsize, coll->scratch, n);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * do_collective_broadcast()                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Broadcasts a buffer along a binomial tree.
+ *
+ * @param coll   Target collective.
+ * @param root   Rank of the root.
+ * @param buffer Target buffer.
+ * @param size   Size of the buffer.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int do_collective_broadcast(struct collective *coll, int root, void *buffer, size_t size)
+{
+	int ret;
+	int mask;
+	int vrank;
+
+	vrank = (coll->rank - root + coll->nnodes) % coll->nnodes;
+
+	/* Receive from parent. */
+	for (mask = 1; mask < coll->nnodes; mask <<= 1)
+	{
+		if (vrank & mask)
+		{
+			ret = collective_recv(
+				collective_node(coll, root, vrank - mask),
+				buffer,
+				size,
+				HAL_COLLECTIVE_SEGMENT_SIZE
+			);
+
+			if (ret < 0)
+				return (ret);
+
+			break;
+		}
+	}
+
+	/* Send to children. */
+	for (mask >>= 1; mask > 0; mask >>= 1)
+	{
+		if ((vrank + mask) >= coll->nnodes)
+			continue;
+
+		ret = collective_send(
+			collective_node(coll, root, vrank + mask),
+			buffer,
+			size,
+			HAL_COLLECTIVE_SEGMENT_SIZE
+		);
+
+		if (ret < 0)
+			return (ret);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * do_collective_reduce()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Reduces a buffer along a binomial tree.
+ *
+ * @param coll    Target collective.
+ * @param root    Rank of the root.
+ * @param sendbuf Elements of the local rank.
+ * @param recvbuf Accumulated elements.
+ * @param nelems  Number of elements.
+ * @param elsize  Size of an element.
+ * @param combine Combine function.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int do_collective_reduce(
+	struct collective *coll,
+	int root,
+	const void *sendbuf,
+	void *recvbuf,
+	size_t nelems,
+	size_t elsize,
+	collective_combine_fn combine
+)
+{
+	int ret;
+	int vrank;
+	size_t segsize;
+
+	vrank   = (coll->rank - root + coll->nnodes) % coll->nnodes;
+	segsize = (HAL_COLLECTIVE_SEGMENT_SIZE/elsize)*elsize;
+
+	if (recvbuf != sendbuf)
+		kmemcpy(recvbuf, sendbuf, nelems*elsize);
+
+	for (int mask = 1; mask < coll->nnodes; mask <<= 1)
+	{
+		/* Send partial result to parent. */
+		if (vrank & mask)
+		{
+			return (
+				collective_send(
+					collective_node(coll, root, vrank - mask),
+					recvbuf,
+					nelems*elsize,
+					segsize
+				)
+			);
+		}
+
+		/* Combine partial result of child. */
+		if ((vrank + mask) < coll->nnodes)
+		{
+			ret = collective_recv_combine(
+				coll,
+				collective_node(coll, root, vrank + mask),
+				recvbuf,
+				nelems,
+				elsize,
+				combine
+			);
+
+			if (ret < 0)
+				return (ret);
+		}
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * do_collective_scatter()                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Scatters a buffer.
+ *
+ * @param coll    Target collective.
+ * @param root    Rank of the root.
+ * @param sendbuf Buffer with one block per rank (root only).
+ * @param recvbuf Buffer where the local block should be stored.
+ * @param size    Size of a block.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int do_collective_scatter(
+	struct collective *coll,
+	int root,
+	const void *sendbuf,
+	void *recvbuf,
+	size_t size
+)
+{
+	int ret;
+
+	/* Receive local block. */
+	if (coll->rank != root)
+		return (collective_recv(coll->nodes[root], recvbuf, size, HAL_COLLECTIVE_SEGMENT_SIZE));
+
+	for (int i = 0; i < coll->nnodes; i++)
+	{
+		const char *block = (const char *) sendbuf + i*size;
+
+		if (i == root)
+		{
+			kmemmove(recvbuf, block, size);
+			continue;
+		}
+
+		if ((ret = collective_send(coll->nodes[i], block, size, HAL_COLLECTIVE_SEGMENT_SIZE)) < 0)
+			return (ret);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * do_collective_gather()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Gathers a buffer.
+ *
+ * @param coll    Target collective.
+ * @param root    Rank of the root.
+ * @param sendbuf Block of the local rank.
+ * @param recvbuf Buffer where one block per rank should be stored (root only).
+ * @param size    Size of a block.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int do_collective_gather(
+	struct collective *coll,
+	int root,
+	const void *sendbuf,
+	void *recvbuf,
+	size_t size
+)
+{
+	int ret;
+
+	/* Send local block. */
+	if (coll->rank != root)
+		return (collective_send(coll->nodes[root], sendbuf, size, HAL_COLLECTIVE_SEGMENT_SIZE));
+
+	for (int i = 0; i < coll->nnodes; i++)
+	{
+		char *block = (char *) recvbuf + i*size;
+
+		if (i == root)
+		{
+			kmemmove(block, sendbuf, size);
+			continue;
+		}
+
+		if ((ret = collective_recv(coll->nodes[i], block, size, HAL_COLLECTIVE_SEGMENT_SIZE)) < 0)
+			return (ret);
+	}
+
+	return (0);
+}
+
+#endif /* COLLECTIVE_HAS_PORTAL */
+
+/*============================================================================*
+ * collective_create()                                                        *
+ *============================================================================*/
+
+/**
+ * The collective_create() function creates a collective that spans
+ * the NoC nodes listed in @p nodes. The local input portal is
+ * created when the first collective is.
+ *
+ * @note This function is thread-safe.
+ */
+PUBLIC int collective_create(const int *nodes, int nnodes)
+{
+#if (COLLECTIVE_HAS_PORTAL)
+	int rank;
+	int collid;
+	int local;
+	uint64_t checks;
+
+	/* Invalid nodes list. */
+	if (nodes == NULL)
+		return (-EINVAL);
+
+	/* Bad nodes list. */
+	if (!WITHIN(nnodes, 1, PROCESSOR_NOC_NODES_NUM + 1))
+		return (-EINVAL);
+
+	rank   = -1;
+	checks = 0ULL;
+	local  = processor_node_get_num();
+
+	for (int i = 0; i < nnodes; i++)
+	{
+		/* Invalid node. */
+		if (!WITHIN(nodes[i], 0, PROCESSOR_NOC_NODES_NUM))
+			return (-EINVAL);
+
+		/* Does a node appear twice? */
+		if (checks & (1ULL << nodes[i]))
+			return (-EINVAL);
+
+		checks |= (1ULL << nodes[i]);
+
+		if (nodes[i] == local)
+			rank = i;
+	}
+
+	/* Local node not found. */
+	if (rank < 0)
+		return (-EINVAL);
+
+	spinlock_lock(&collective_lock);
+
+		if ((collid = resource_alloc(&pool)) < 0)
+		{
+			spinlock_unlock(&collective_lock);
+			return (-EAGAIN);
+		}
+
+		/* Create input portal. */
+		if (portals.nusers == 0)
+		{
+			if ((portals.inportal = portal_create(local)) < 0)
+			{
+				int err = portals.inportal;
+
+				resource_free(&pool, collid);
+				spinlock_unlock(&collective_lock);
+				return (err);
+			}
+		}
+
+		portals.nusers++;
+
+		collectives[collid].rank   = rank;
+		collectives[collid].nnodes = nnodes;
+		kmemcpy(collectives[collid].nodes, nodes, nnodes*sizeof(int));
+
+	spinlock_unlock(&collective_lock);
+
+	return (collid);
+
+#else
+	UNUSED(nodes);
+	UNUSED(nnodes);
+
+	return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * collective_destroy()                                                       *
+ *============================================================================*/
+
+/**
+ * The collective_destroy() function destroys the collective @p
+ * collid. Portals are released when the last collective is
+ * destroyed.
+ *
+ * @note This function is thread-safe.
+ */
+PUBLIC int collective_destroy(int collid)
+{
+#if (COLLECTIVE_HAS_PORTAL)
+	int ret = 0;
+
+	/* Wait for ongoing operations. */
+	spinlock_lock(&collective_op_lock);
+	spinlock_lock(&collective_lock);
+
+		/* Bad collective. */
+		if (collective_get(collid) == NULL)
+		{
+			spinlock_unlock(&collective_lock);
+			spinlock_unlock(&collective_op_lock);
+			return (-EBADF);
+		}
+
+		/* Release portals. */
+		if (--portals.nusers == 0)
+		{
+			for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++)
+			{
+				if (portals.outportals[i] < 0)
+					continue;
+
+				if (portal_close(portals.outportals[i]) < 0)
+					ret = (-EAGAIN);
+
+				portals.outportals[i] = -1;
+			}
+
+			if (portal_unlink(portals.inportal) < 0)
+				ret = (-EAGAIN);
+
+			portals.inportal = -1;
+		}
+
+		resource_free(&pool, collid);
+
+	spinlock_unlock(&collective_lock);
+	spinlock_unlock(&collective_op_lock);
+
+	return (ret);
+
+#else
+	UNUSED(collid);
+
+	return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * collective_broadcast()                                                     *
+ *============================================================================*/
+
+/**
+ * The collective_broadcast() function broadcasts @p size bytes of
+ * @p buffer from the rank @p root to all ranks of the collective @p
+ * collid. Data flows along a binomial tree, thus the root sends out
+ * log2(n) copies of the buffer.
+ */
+PUBLIC int collective_broadcast(int collid, int root, void *buffer, size_t size)
+{
+#if (COLLECTIVE_HAS_PORTAL)
+	int ret;
+	struct collective *coll;
+
+	/* Bad buffer. */
+	if ((buffer == NULL) && (size > 0))
+		return (-EINVAL);
+
+	/* Bad collective. */
+	if ((coll = collective_enter(collid)) == NULL)
+		return (-EBADF);
+
+	/* Bad root. */
+	if (!WITHIN(root, 0, coll->nnodes))
+		ret = (-EINVAL);
+	else
+		ret = do_collective_broadcast(coll, root, buffer, size);
+
+	collective_leave();
+
+	return (ret);
+
+#else
+	UNUSED(collid);
+	UNUSED(root);
+	UNUSED(buffer);
+	UNUSED(size);
+
+	return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * collective_broadcast_pipelined()                                           *
+ *============================================================================*/
+
+/**
+ * The collective_broadcast_pipelined() function broadcasts @p size
+ * bytes of @p buffer from the rank @p root to all ranks of the
+ * collective @p collid. Each rank forwards a segment to its successor
+ * on the ring right after receiving it, so that the transfer of a
+ * large buffer costs about one buffer plus one segment per hop.
+ */
+PUBLIC int collective_broadcast_pipelined(int collid, int root, void *buffer, size_t size)
+{
+#if (COLLECTIVE_HAS_PORTAL)
+	int ret;
+	int vrank;
+	struct collective *coll;
+
+	/* Bad buffer. */
+	if ((buffer == NULL) && (size > 0))
+		return (-EINVAL);
+
+	/* Bad collective. */
+	if ((coll = collective_enter(collid)) == NULL)
+		return (-EBADF);
+
+	/* Bad root. */
+	if (!WITHIN(root, 0, coll->nnodes))
+	{
+	collective_leave();
+	return (-EINVAL);
+	}
+
+	vrank = (coll->rank - root + coll->nnodes) % coll->nnodes;
+	ret   = 0;
+
+	for (size_t off = 0; off < size; off += HAL_COLLECTIVE_SEGMENT_SIZE)
+	{
+	size_t n = ((size - off) < HAL_COLLECTIVE_SEGMENT_SIZE) ?
+		(size - off) : HAL_COLLECTIVE_SEGMENT_SIZE;
+
+	/* Receive segment from predecessor. */
+	if (vrank > 0)
+	{
+		ret = do_collective_recv(
+			collective_node(coll, root, vrank - 1),
+			(char *) buffer + off,
+			n
+		);
+
+		if (ret < 0)
+			break;
+	}
+
+	/* Forward segment to successor. */
+	if ((vrank + 1) < coll->nnodes)
+	{
+		ret = collective_send(
+			collective_node(coll, root, vrank + 1),
+			(char *) buffer + off,
+			n,
+			n
+		);
+
+		if (ret < 0)
+			break;
+	}
+	}
+
+	collective_leave();
+
+	return (ret);
+
+#else
+	UNUSED(collid);
+	UNUSED(root);
+	UNUSED(buffer);
+	UNUSED(size);
+
+	return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * collective_scatter()                                                       *
+ *============================================================================*/
+
+/**
+ * The collective_scatter() function sends the i-th block of @p size
+ * bytes of @p sendbuf, at the rank @p root, to the i-th rank of the
+ * collective @p collid.
+ *
+ * @note The root talks to every rank directly, since each rank has
+ * a single input portal and blocks are distinct anyway.
+ */
+PUBLIC int collective_scatter(int collid, int root, const void *sendbuf, void *recvbuf, size_t size)
+{
+#if (COLLECTIVE_HAS_PORTAL)
+	int ret;
+	struct collective *coll;
+
+	/* Bad buffer. */
+	if (recvbuf == NULL)
+		return (-EINVAL);
+
+	/* Bad collective. */
+	if ((coll = collective_enter(collid)) == NULL)
+		return (-EBADF);
+
+	/* Bad root. */
+	if (!WITHIN(root, 0, coll->nnodes))
+		ret = (-EINVAL);
+
+	/* Bad buffer. */
+	else if ((coll->rank == root) && (sendbuf == NULL))
+		ret = (-EINVAL);
+
+	else
+		ret = do_collective_scatter(coll, root, sendbuf, recvbuf, size);
+
+	collective_leave();
+
+	return (ret);
+
+#else
+	UNUSED(collid);
+	UNUSED(root);
+	UNUSED(sendbuf);
+	UNUSED(recvbuf);
+	UNUSED(size);
+
+	return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * collective_gather()                                                        *
+ *============================================================================*/
+
+/**
+ * The collective_gather() function stores the block of @p size bytes
+ * of @p sendbuf, from the i-th rank of the collective @p collid, in
+ * the i-th block of @p recvbuf at the rank @p root.
+ */
+PUBLIC int collective_gather(int collid, int root, const void *sendbuf, void *recvbuf, size_t size)
+{
+#if (COLLECTIVE_HAS_PORTAL)
+	int ret;
+	struct collective *coll;
+
+	/* Bad buffer. */
+	if (sendbuf == NULL)
+		return (-EINVAL);
+
+	/* Bad collective. */
+	if ((coll = collective_enter(collid)) == NULL)
+		return (-EBADF);
+
+	/* Bad root. */
+	if (!WITHIN(root, 0, coll->nnodes))
+		ret = (-EINVAL);
+
+	/* Bad buffer. */
+	else if ((coll->rank == root) && (recvbuf == NULL))
+		ret = (-EINVAL);
+
+	else
+		ret = do_collective_gather(coll, root, sendbuf, recvbuf, size);
+
+	collective_leave();
+
+	return (ret);
+
+#else
+	UNUSED(collid);
+	UNUSED(root);
+	UNUSED(sendbuf);
+	UNUSED(recvbuf);
+	UNUSED(size);
+
+	return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * collective_reduce()                                                        *
+ *============================================================================*/
+
+/**
+ * The collective_reduce() function combines @p nelems elements of @p
+ * elsize bytes from all ranks of the collective @p collid, and stores
+ * the result in @p recvbuf at the rank @p root. Partial results are
+ * combined along a binomial tree, one segment of whole elements at a
+ * time.
+ */
+PUBLIC int collective_reduce(
+	int collid,
+	int root,
+	const void *sendbuf,
+	void *recvbuf,
+	size_t nelems,
+	size_t elsize,
+	collective_combine_fn combine
+)
+{
+#if (COLLECTIVE_HAS_PORTAL)
+	int ret;
+	struct collective *coll;
+
+	/* Bad buffers. */
+	if ((sendbuf == NULL) || (recvbuf == NULL))
+		return (-EINVAL);
+
+	/* Bad element size. */
+	if (!WITHIN(elsize, 1, HAL_COLLECTIVE_SEGMENT_SIZE + 1))
+		return (-EINVAL);
+
+	/* Bad combine function. */
+	if (combine == NULL)
+		return (-EINVAL);
+
+	/* Bad collective. */
+	if ((coll = collective_enter(collid)) == NULL)
+		return (-EBADF);
+
+	/* Bad root. */
+	if (!WITHIN(root, 0, coll->nnodes))
+		ret = (-EINVAL);
+	else
+		ret = do_collective_reduce(coll, root, sendbuf, recvbuf, nelems, elsize, combine);
+
+	collective_leave();
+
+	return (ret);
+
+#else
+	UNUSED(collid);
+	UNUSED(root);
+	UNUSED(sendbuf);
+	UNUSED(recvbuf);
+	UNUSED(nelems);
+	UNUSED(elsize);
+	UNUSED(combine);
+
+	return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * collective_allreduce()                                                     *
+ *============================================================================*/
+
+/**
+ * The collective_allreduce() function combines @p nelems elements
+ * of @p elsize bytes from all ranks of the collective @p collid, and
+ * stores the result in @p recvbuf at every rank. It reduces towards
+ * the first rank and broadcasts the result back along the same tree.
+ */
+PUBLIC int collective_allreduce(
+	int collid,
+	const void *sendbuf,
+	void *recvbuf,
+	size_t nelems,
+	size_t elsize,
+	collective_combine_fn combine
+)
+{
+#if (COLLECTIVE_HAS_PORTAL)
+	int ret;
+	struct collective *coll;
+
+	/* Bad buffers. */
+	if ((sendbuf == NULL) || (recvbuf == NULL))
+		return (-EINVAL);
+
+	/* Bad element size. */
+	if (!WITHIN(elsize, 1, HAL_COLLECTIVE_SEGMENT_SIZE + 1))
+		return (-EINVAL);
+
+	/* Bad combine function. */
+	if (combine == NULL)
+		return (-EINVAL);
+
+	/* Bad collective. */
+	if ((coll = collective_enter(collid)) == NULL)
+		return (-EBADF);
+
+	/* Both phases go in a single operation. */
+	if ((ret = do_collective_reduce(coll, 0, sendbuf, recvbuf, nelems, elsize, combine)) == 0)
+		ret = do_collective_broadcast(coll, 0, recvbuf, nelems*elsize);
+
+	collective_leave();
+
+	return (ret);
+
+#else
+	UNUSED(collid);
+	UNUSED(sendbuf);
+	UNUSED(recvbuf);
+	UNUSED(nelems);
+	UNUSED(elsize);
+	UNUSED(combine);
+
+	return (-ENOSYS);
+#endif
+}
@@ -0,0 +1,877 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/hal/target/rpc.h>
+#include <nanvix/hal/target/mailbox.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+#include <posix/stddef.h>
+#include <posix/stdint.h>
+
+#if (__TARGET_HAS_MAILBOX)
+
+/**
+ * @name Types of messages.
+ */
+/**@{*/
+#define RPC_REQUEST 0 /**< Request. */
+#define RPC_REPLY   1 /**< Reply.   */
+/**@}*/
+
+/**
+ * @brief Message header.
+ *
+ * The header lives in the reserved area of a mailbox message.
+ */
+struct rpc_header
+{
+	uint32_t reqid;  /**< ID of the request.                */
+	uint16_t source; /**< NoC node of the sender.           */
+	uint16_t type;   /**< Type of message.                  */
+	int32_t opcode;  /**< Operation code (or reply status). */
+	uint32_t size;   /**< Size of the payload.              */
+};
+
+/**
+ * @brief Mailbox message.
+ */
+struct rpc_message
+{
+	union
+	{
+		struct rpc_header header;                 /**< Header.   */
+		char reserved[HAL_MAILBOX_RESERVED_SIZE]; /**< Reserved. */
+	} u;
+	char data[HAL_MAILBOX_DATA_SIZE];             /**< Payload.  */
+};
+
+/**
+ * @brief Table of outstanding requests.
+ *
+ * The ID of a request encodes its slot in the low bits, and a
+ * sequence number in the remaining ones, so that stale replies are
+ * told apart from current ones.
+ */
+PRIVATE struct rpc_slot
+{
+	bool used;                    /**< Is the slot used?         */
+	volatile bool done;           /**< Has the reply arrived?    */
+	int remote;                   /**< NoC node of the server.   */
+	uint32_t reqid;               /**< ID of the request.        */
+	int status;                   /**< Status of the reply.      */
+	size_t size;                  /**< Size of the return value. */
+	char data[HAL_RPC_DATA_SIZE]; /**< Return value.             */
+} slots[HAL_RPC_OUTSTANDING_MAX];
+
+/**
+ * @brief Queue of pending requests.
+ */
+PRIVATE struct
+{
+	int head;                                     /**< First request.      */
+	int count;                                    /**< Number of requests. */
+	struct rpc_message msgs[HAL_RPC_PENDING_MAX]; /**< Requests.           */
+} pending;
+
+/**
+ * @brief Queue of rejected requests.
+ *
+ * Rejections are replied to once the input mailbox is released, since
+ * sending them may drain the input mailbox in turn.
+ */
+PRIVATE struct
+{
+	int head;  /**< First rejection.      */
+	int count; /**< Number of rejections. */
+	struct
+	{
+		int remote;     /**< NoC node of the client. */
+		uint32_t reqid; /**< ID of the request.      */
+	} reqs[HAL_RPC_PENDING_MAX];
+} rejected;
+
+/**
+ * @brief RPC state.
+ */
+PRIVATE struct
+{
+	bool active;                           /**< Is the facility set up? */
+	int inbox;                             /**< Input mailbox.           */
+	int outboxes[PROCESSOR_NOC_NODES_NUM]; /**< Output mailboxes.        */
+	uint32_t seq;                          /**< Next sequence number.    */
+} rpc = {
+	.active   = false,
+	.inbox    = -1,
+	.outboxes = { [0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = -1 },
+	.seq      = 0,
+};
+
+/**
+ * @brief Lock of RPC tables.
+ */
+PRIVATE spinlock_t rpc_lock = SPINLOCK_UNLOCKED;
+
+/**
+ * @brief Lock of the input mailbox.
+ */
+PRIVATE spinlock_t rpc_rx_lock = SPINLOCK_UNLOCKED;
+
+/**
+ * @brief Lock of rejection replies.
+ */
+PRIVATE spinlock_t rpc_reject_lock = SPINLOCK_UNLOCKED;
+
+/**
+ * @brief Asserts whether or not a mailbox operation should be retried.
+ */
+#define RPC_SHOULD_RETRY(ret)  \
+	(((ret) == -EAGAIN)    ||  \
+	 ((ret) == -EBUSY)     ||  \
+	 ((ret) == -ENOMSG)    ||  \
+	 ((ret) == -ETIMEDOUT))
+
+PRIVATE int rpc_progress(void);
+
+/*============================================================================*
+ * rpc_send()                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Sends a message.
+ *
+ * @param remote NoC node of the target.
+ * @param msg    Target message.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int rpc_send(int remote, const struct rpc_message *msg)
+{
+	int mbxid;
+	ssize_t ret;
+
+	spinlock_lock(&rpc_lock);
+
+		if ((mbxid = rpc.outboxes[remote]) < 0)
+		{
+			if ((mbxid = mailbox_open(remote)) >= 0)
+				rpc.outboxes[remote] = mbxid;
+		}
+
+	spinlock_unlock(&rpc_lock);
+
+	if (mbxid < 0)
+		return (mbxid);
+
+	/*
+	 * Drain the local input mailbox while retrying, otherwise two
+	 * nodes that send to each other could wait forever.
+	 */
+	while (1)
+	{
+		/* The retry check evaluates its argument more than once. */
+		ret = mailbox_awrite(mbxid, msg, HAL_MAILBOX_MSG_SIZE);
+
+		if (!RPC_SHOULD_RETRY(ret))
+			break;
+
+		rpc_progress();
+	}
+
+	if (ret < 0)
+		return (ret);
+
+	return (mailbox_wait(mbxid));
+}
+
+/*============================================================================*
+ * rpc_dispatch()                                                             *
+ *============================================================================*/
+
+/**
+ * @brief Dispatches a received message.
+ *
+ * @param msg Target message.
+ *
+ * @returns Zero if the message was dispatched, and one if it is a
+ * request that was queued for rejection.
+ */
+PRIVATE int rpc_dispatch(const struct rpc_message *msg)
+{
+	struct rpc_slot *slot;
+	const struct rpc_header *header = &msg->u.header;
+
+	spinlock_lock(&rpc_lock);
+
+		/* Request. */
+		if (header->type == RPC_REQUEST)
+		{
+			/* Queue is full. */
+			if (pending.count == HAL_RPC_PENDING_MAX)
+			{
+				rejected.reqs[(rejected.head + rejected.count) % HAL_RPC_PENDING_MAX].remote = header->source;
+				rejected.reqs[(rejected.head + rejected.count) % HAL_RPC_PENDING_MAX].reqid  = header->reqid;
+				rejected.count++;
+
+				spinlock_unlock(&rpc_lock);
+				return (1);
+			}
+
+			kmemcpy(
+				&pending.msgs[(pending.head + pending.count) % HAL_RPC_PENDING_MAX],
+				msg,
+				sizeof(struct rpc_message)
+			);
+			pending.count++;
+
+			spinlock_unlock(&rpc_lock);
+			return (0);
+		}
+
+		/* Reply. */
+		slot = &slots[header->reqid % HAL_RPC_OUTSTANDING_MAX];
+
+		if (!slot->used || slot->done || (slot->reqid != header->reqid))
+		{
+			kprintf("[hal][rpc] dropping stale reply (reqid=%d)", header->reqid);
+			spinlock_unlock(&rpc_lock);
+			return (0);
+		}
+
+		slot->status = header->opcode;
+		slot->size   = (header->size < HAL_RPC_DATA_SIZE) ? header->size : HAL_RPC_DATA_SIZE;
+		kmemcpy(slot->data, msg->data, slot->size);
+		slot->done = true;
+
+	spinlock_unlock(&rpc_lock);
+
+	return (0);
+}
+
+/*============================================================================*
+ * rpc_reject()                                                               *
+ *============================================================================*/
+
+/**
+ * @brief Replies to rejected requests.
+ *
+ * @note Only one core replies at a time, and replies issued while
+ * retrying a send are left for the outermost call.
+ */
+PRIVATE void rpc_reject(void)
+{
+	struct rpc_message msg;
+
+	if (!spinlock_trylock(&rpc_reject_lock))
+		return;
+
+	while (true)
+	{
+		int remote;
+
+		spinlock_lock(&rpc_lock);
+
+			if (rejected.count == 0)
+			{
+				spinlock_unlock(&rpc_lock);
+				break;
+			}
+
+			remote             = rejected.reqs[rejected.head].remote;
+			msg.u.header.reqid = rejected.reqs[rejected.head].reqid;
+
+			rejected.head = (rejected.head + 1) % HAL_RPC_PENDING_MAX;
+			rejected.count--;
+
+		spinlock_unlock(&rpc_lock);
+
+		msg.u.header.type   = RPC_REPLY;
+		msg.u.header.source = processor_node_get_num();
+		msg.u.header.opcode = -EBUSY;
+		msg.u.header.size   = 0;
+
+		if (rpc_send(remote, &msg) < 0)
+			kprintf("[hal][rpc] failed to reject request (reqid=%d)", msg.u.header.reqid);
+	}
+
+	spinlock_unlock(&rpc_reject_lock);
+}
+
+/*============================================================================*
+ * rpc_progress()                                                             *
+ *============================================================================*/
+
+/**
+ * @brief Drains the input mailbox.
+ *
+ * @returns Upon successful completion, the number of messages that
+ * were received is returned. Upon failure, a negative error code is
+ * returned instead.
+ *
+ * @note This function is non-blocking.
+ * @note Requests that do not fit in the pending queue are rejected
+ * after the input mailbox is released, otherwise two nodes that
+ * reject each other would wait forever on each other's mailbox.
+ */
+PRIVATE int rpc_progress(void)
+{
+	ssize_t ret;
+	int nreceived;
+	int nrejected;
+	struct rpc_message msg;
+
+	/* Some other core is draining the mailbox. */
+	if (!spinlock_trylock(&rpc_rx_lock))
+		return (0);
+
+	for (nreceived = 0; /* noop */; nreceived++)
+	{
+		spinlock_lock(&rpc_lock);
+			nrejected = rejected.count;
+		spinlock_unlock(&rpc_lock);
+
+		/* No room to reject further requests. */
+		if (nrejected == HAL_RPC_PENDING_MAX)
+		{
+			ret = (-EAGAIN);
+			break;
+		}
+
+		ret = mailbox_aread(rpc.inbox, &msg, HAL_MAILBOX_MSG_SIZE);
+
+		if (ret < 0)
+			break;
+
+		if ((ret = mailbox_wait(rpc.inbox)) < 0)
+			break;
+
+		rpc_dispatch(&msg);
+	}
+
+	spinlock_unlock(&rpc_rx_lock);
+
+	rpc_reject();
+
+	return (RPC_SHOULD_RETRY(ret) ? nreceived : ret);
+}
+
+/*============================================================================*
+ * rpc_slot_get()                                                             *
+ *============================================================================*/
+
+/**
+ * @brief Gets the slot of an outstanding request.
+ *
+ * @param handle Handle to the target request.
+ *
+ * @returns Upon successful completion, the target slot is returned.
+ * Upon failure, NULL is returned instead.
+ */
+PRIVATE struct rpc_slot *rpc_slot_get(int handle)
+{
+	if (!rpc.active)
+		return (NULL);
+
+	if (!WITHIN(handle, 0, HAL_RPC_OUTSTANDING_MAX))
+		return (NULL);
+
+	if (!slots[handle].used)
+		return (NULL);
+
+	return (&slots[handle]);
+}
+
+#endif /* __TARGET_HAS_MAILBOX */
+
+/*============================================================================*
+ * rpc_setup()                                                                *
+ *============================================================================*/
+
+/**
+ * The rpc_setup() function creates the input mailbox of the local
+ * node, which is then drained by the RPC facility.
+ */
+PUBLIC int rpc_setup(void)
+{
+#if (__TARGET_HAS_MAILBOX)
+	int mbxid;
+
+	KASSERT_SIZE(sizeof(struct rpc_message), HAL_MAILBOX_MSG_SIZE);
+
+	spinlock_lock(&rpc_lock);
+
+		/* Already set up. */
+		if (rpc.active)
+		{
+			spinlock_unlock(&rpc_lock);
+			return (-EBUSY);
+		}
+
+		if ((mbxid = mailbox_create(processor_node_get_num())) < 0)
+		{
+			spinlock_unlock(&rpc_lock);
+			return (mbxid);
+		}
+
+		for (int i = 0; i < HAL_RPC_OUTSTANDING_MAX; i++)
+		{
+			slots[i].used = false;
+			slots[i].done = false;
+		}
+
+		pending.head   = 0;
+		pending.count  = 0;
+		rejected.head  = 0;
+		rejected.count = 0;
+		rpc.inbox      = mbxid;
+		rpc.active     = true;
+
+	spinlock_unlock(&rpc_lock);
+
+	return (0);
+
+#else
+	return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * rpc_shutdown()                                                             *
+ *============================================================================*/
+
+/**
+ * The rpc_shutdown() function releases the mailboxes used by the RPC
+ * facility. It fails if some request is still outstanding.
+ */
+PUBLIC int rpc_shutdown(void)
+{
+#if (__TARGET_HAS_MAILBOX)
+	int ret = 0;
+
+	spinlock_lock(&rpc_lock);
+
+		/* Not set up. */
+		if (!rpc.active)
+		{
+			spinlock_unlock(&rpc_lock);
+			return (-EINVAL);
+		}
+
+		/* Outstanding requests. */
+		for (int i = 0; i < HAL_RPC_OUTSTANDING_MAX; i++)
+		{
+			if (slots[i].used)
+			{
+				spinlock_unlock(&rpc_lock);
+				return (-EBUSY);
+			}
+		}
+
+		for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++)
+		{
+			if (rpc.outboxes[i] < 0)
+				continue;
+
+			if (mailbox_close(rpc.outboxes[i]) < 0)
+				ret = (-EAGAIN);
+
+			rpc.outboxes[i] = -1;
+		}
+
+		if (mailbox_unlink(rpc.inbox) < 0)
+			ret = (-EAGAIN);
+
+		rpc.inbox  = -1;
+		rpc.active = false;
+
+	spinlock_unlock(&rpc_lock);
+
+	return (ret);
+
+#else
+	return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * rpc_call()                                                                 *
+ *============================================================================*/
+
+/**
+ * The rpc_call() function sends a request with operation code @p
+ * opcode and @p size bytes of arguments in @p args to the server at
+ * the NoC node @p remote. It returns as soon as the request is sent,
+ * so that several requests may be in flight.
+ */
+PUBLIC int rpc_call(int remote, int opcode, const void *args, size_t size)
+{
+#if (__TARGET_HAS_MAILBOX)
+	int ret;
+	int handle;
+	struct rpc_message msg;
+
+	/* Not set up. */
+	if (!rpc.active)
+		return (-EINVAL);
+
+	/* Invalid remote. */
+	if (!node_is_valid(remote) || node_is_local(remote))
+		return (-EINVAL);
+
+	/* Bad arguments. */
+	if ((size > HAL_RPC_DATA_SIZE) || ((args == NULL) && (size > 0)))
+		return (-EINVAL);
+
+	spinlock_lock(&rpc_lock);
+
+		for (handle = 0; handle < HAL_RPC_OUTSTANDING_MAX; handle++)
+		{
+			if (!slots[handle].used)
+				break;
+		}
+
+		/* Too many outstanding requests. */
+		if (handle == HAL_RPC_OUTSTANDING_MAX)
+		{
+			spinlock_unlock(&rpc_lock);
+			return (-EAGAIN);
+		}
+
+		slots[handle].used   = true;
+		slots[handle].done   = false;
+		slots[handle].remote = remote;
+		slots[handle].reqid  = (rpc.seq++)*HAL_RPC_OUTSTANDING_MAX + handle;
+
+		msg.u.header.reqid  = slots[handle].reqid;
+
+	spinlock_unlock(&rpc_lock);
+
+	msg.u.header.source = processor_node_get_num();
+	msg.u.header.type   = RPC_REQUEST;
+	msg.u.header.opcode = opcode;
+	msg.u.header.size   = size;
+	if (size > 0)
+		kmemcpy(msg.data, args, size);
+
+	if ((ret = rpc_send(remote, &msg)) < 0)
+	{
+		spinlock_lock(&rpc_lock);
+			slots[handle].used = false;
+		spinlock_unlock(&rpc_lock);
+
+		return (ret);
+	}
+
+	return (handle);
+
+#else
+	UNUSED(remote);
+	UNUSED(opcode);
+	UNUSED(args);
+	UNUSED(size);
+
+	return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * rpc_test()                                                                 *
+ *============================================================================*/
+
+/**
+ * The rpc_test() function drains the input mailbox and asserts
+ * whether or not the reply of the request @p handle has arrived.
+ */
+PUBLIC int rpc_test(int handle)
+{
+#if (__TARGET_HAS_MAILBOX)
+	int ret;
+	struct rpc_slot *slot;
+
+	/* Bad request. */
+	if ((slot = rpc_slot_get(handle)) == NULL)
+		return (-EINVAL);
+
+	if ((ret = rpc_progress()) < 0)
+		return (ret);
+
+	dcache_invalidate();
+
+	return (slot->done ? 1 : 0);
+
+#else
+	UNUSED(handle);
+
+	return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * rpc_wait()                                                                 *
+ *============================================================================*/
+
+/**
+ * The rpc_wait() function waits for the reply of the request @p
+ * handle, copies at most @p size bytes of the return value to @p ret
+ * and releases the request.
+ */
+PUBLIC ssize_t rpc_wait(int handle, void *ret, size_t size)
+{
+#if (__TARGET_HAS_MAILBOX)
+	int err;
+	ssize_t nbytes;
+	struct rpc_slot *slot;
+
+	/* Bad request. */
+	if ((slot = rpc_slot_get(handle)) == NULL)
+		return (-EINVAL);
+
+	/* Bad buffer. */
+	if ((ret == NULL) && (size > 0))
+		return (-EINVAL);
+
+	while ((err = rpc_test(handle)) == 0)
+		/* noop */;
+
+	if (err < 0)
+		return (err);
+
+	spinlock_lock(&rpc_lock);
+
+		if ((nbytes = slot->status) >= 0)
+		{
+			nbytes = (slot->size < size) ? slot->size : size;
+			kmemcpy(ret, slot->data, nbytes);
+		}
+
+		slot->used = false;
+
+	spinlock_unlock(&rpc_lock);
+
+	return (nbytes);
+
+#else
+	UNUSED(handle);
+	UNUSED(ret);
+	UNUSED(size);
+
+	return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * rpc_wait_any()                                                             *
+ *============================================================================*/
+
+/**
+ * The rpc_wait_any() function waits until the reply of any of the
+ * @p n requests in @p handles arrives, and returns its handle.
+ */
+PUBLIC int rpc_wait_any(const int *handles, int n)
+{
+#if (__TARGET_HAS_MAILBOX)
+	int ret;
+
+	/* Bad handles. */
+	if ((handles == NULL) || (n < 1))
+		return (-EINVAL);
+
+	for (int i = 0; i < n; i++)
+	{
+		if (rpc_slot_get(handles[i]) == NULL)
+			return (-EINVAL);
+	}
+
+	while (true)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			if ((ret = rpc_test(handles[i])) < 0)
+				return (ret);
+
+			if (ret)
+				return (handles[i]);
+		}
+	}
+
+#else
+	UNUSED(handles);
+	UNUSED(n);
+
+	return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * rpc_wait_all()                                                             *
+ *============================================================================*/
+
+/**
+ * The rpc_wait_all() function waits until the replies of all the @p
+ * n requests in @p handles arrive.
+ */
+PUBLIC int rpc_wait_all(const int *handles, int n)
+{
+#if (__TARGET_HAS_MAILBOX)
+	int ret;
+
+	/* Bad handles. */
+	if ((handles == NULL) || (n < 1))
+		return (-EINVAL);
+
+	for (int i = 0; i < n; i++)
+	{
+		if (rpc_slot_get(handles[i]) == NULL)
+			return (-EINVAL);
+	}
+
+	for (int i = 0; i < n; i++)
+	{
+		while ((ret = rpc_test(handles[i])) == 0)
+			/* noop */;
+
+		if (ret < 0)
+			return (ret);
+	}
+
+	return (0);
+
+#else
+	UNUSED(handles);
+	UNUSED(n);
+
+	return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * rpc_serve()                                                                *
+ *============================================================================*/
+
+/**
+ * The rpc_serve() function waits for a request, stores its
+ * description in @p req and copies at most @p size bytes of its
+ * arguments to @p args. Requests are served in arrival order.
+ */
+PUBLIC int rpc_serve(struct rpc_request *req, void *args, size_t size)
+{
+#if (__TARGET_HAS_MAILBOX)
+	int ret;
+	struct rpc_message *msg;
+
+	/* Not set up. */
+	if (!rpc.active)
+		return (-EINVAL);
+
+	/* Bad request. */
+	if (req == NULL)
+		return (-EINVAL);
+
+	/* Bad buffer. */
+	if ((args == NULL) && (size > 0))
+		return (-EINVAL);
+
+	while (true)
+	{
+		spinlock_lock(&rpc_lock);
+
+			if (pending.count > 0)
+				break;
+
+		spinlock_unlock(&rpc_lock);
+
+		if ((ret = rpc_progress()) < 0)
+			return (ret);
+	}
+
+		msg = &pending.msgs[pending.head];
+
+		req->source = msg->u.header.source;
+		req->reqid  = msg->u.header.reqid;
+		req->opcode = msg->u.header.opcode;
+		req->size   = msg->u.header.size;
+
+		kmemcpy(args, msg->data, (req->size < size) ? req->size : size);
+
+		pending.head = (pending.head + 1) % HAL_RPC_PENDING_MAX;
+		pending.count--;
+
+	spinlock_unlock(&rpc_lock);
+
+	return (0);
+
+#else
+	UNUSED(req);
+	UNUSED(args);
+	UNUSED(size);
+
+	return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * rpc_reply()                                                                *
+ *============================================================================*/
+
+/**
+ * The rpc_reply() function sends the status @p status and @p size
+ * bytes of the return value in @p ret back to the client of the
+ * request @p req.
+ */
+PUBLIC int rpc_reply(const struct rpc_request *req, int status, const void *ret, size_t size)
+{
+#if (__TARGET_HAS_MAILBOX)
+	struct rpc_message msg;
+
+	/* Not set up. */
+	if (!rpc.active)
+		return (-EINVAL);
+
+	/* Bad request. */
+	if ((req == NULL) || !node_is_valid(req->source) || node_is_local(req->source))
+		return (-EINVAL);
+
+	/* Bad return value. */
+	if ((size > HAL_RPC_DATA_SIZE) || ((ret == NULL) && (size > 0)))
+		return (-EINVAL);
+
+	msg.u.header.reqid  = req->reqid;
+	msg.u.header.source = processor_node_get_num();
+	msg.u.header.type   = RPC_REPLY;
+	msg.u.header.opcode = status;
+	msg.u.header.size   = size;
+	if (size > 0)
+		kmemcpy(msg.data, ret, size);
+
+	return (rpc_send(req->source, &msg));
+
+#else
+	UNUSED(req);
+	UNUSED(status);
+	UNUSED(ret);
+	UNUSED(size);
+
+	return (-ENOSYS);
+#endif
+}
@@ -318,6 +318,76 @@ PUBLIC int sync_wait(int syncid)
 #endif /* __TARGET_HAS_SYNC */
 }
 
+/*============================================================================*
+ * sync_wait_n()                                                              *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int sync_wait_n(int syncid, int nsignals)
+{
+#if (__TARGET_HAS_SYNC && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+	/* Invalid sync. */
+	if (!sync_rx_is_valid(syncid))
+		return (-EBADF);
+
+	/* Invalid number of signals. */
+	if (nsignals < 1)
+		return (-EINVAL);
+
+#ifdef __sync_wait_n_fn
+
+	return (__sync_wait_n(syncid, nsignals));
+
+#else
+
+	/* Fallback: consume signals one at a time. */
+	for (int i = 0; i < nsignals; i++)
+	{
+		int ret;
+
+		if ((ret = __sync_wait(syncid)) < 0)
+			return (ret);
+	}
+
+	return (0);
+
+#endif /* __sync_wait_n_fn */
+
+#else /* __TARGET_HAS_SYNC */
+	UNUSED(syncid);
+	UNUSED(nsignals);
+
+	return (-ENOSYS);
+#endif /* __TARGET_HAS_SYNC */
+}
+
+/*============================================================================*
+ * sync_npending()                                                            *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int sync_npending(int syncid)
+{
+#if (__TARGET_HAS_SYNC && !__NANVIX_IKC_USES_ONLY_MAILBOX) && defined(__sync_npending_fn)
+
+	/* Invalid sync. */
+	if (!sync_rx_is_valid(syncid))
+		return (-EBADF);
+
+	return (__sync_npending(syncid));
+
+#else /* __TARGET_HAS_SYNC */
+	UNUSED(syncid);
+
+	return (-ENOSYS);
+#endif /* __TARGET_HAS_SYNC */
+}
+
 /*============================================================================*
  * sync_ioctl()                                                               *
  *============================================================================*/
@@ -791,6 +791,183 @@ PRIVATE void test_cluster_cores_stress_spinlocks(void)
 		while (true);
 }
 
+/*----------------------------------------------------------------------------*
+ * Spinlock Contention                                                        *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Number of acquisitions per core.
+ */
+#define CONTENTION_NACQUIRES 1000
+
+PRIVATE spinlock_t contention_lock = SPINLOCK_UNLOCKED;         /* Contended lock.       */
+PRIVATE volatile int contention_counter ALIGN(CACHE_LINE_SIZE); /* Protected counter.    */
+PRIVATE uint64_t contention_cycles[CORES_NUM_MAX];              /* Cycles spent by core. */
+
+/**
+ * @brief Hammers the contended lock.
+ */
+PRIVATE void contention_acquire(void)
+{
+	uint64_t t0;
+
+	t0 = clock_read();
+
+		for (int i = 0; i < CONTENTION_NACQUIRES; i++)
+		{
+			spinlock_lock(&contention_lock);
+				contention_counter++;
+			spinlock_unlock(&contention_lock);
+		}
+
+	contention_cycles[core_get_id()] = clock_read() - t0;
+}
+
+/**
+ * @brief Contending slave.
+ */
+PRIVATE void contention_slave(void)
+{
+	contention_acquire();
+
+	fence_join(&slave_fence);
+
+	KASSERT(core_release() == 0);
+	core_reset();
+}
+
+/**
+ * @brief Stress Test: Spinlock Contention
+ *
+ * All cores acquire the same lock. The time that the fastest and
+ * the slowest core took to get through tells both the cost of an
+ * acquisition and how fair the lock is.
+ */
+PRIVATE void test_cluster_cores_stress_spinlock_contention(void)
+{
+	uint64_t min;
+	uint64_t max;
+
+	contention_counter = 0;
+	fence_init(&slave_fence, CORES_NUM - 1);
+
+		/* Start execution in all cores. */
+		for (int i = 0; i < CORES_NUM; i++)
+		{
+			if (i != COREID_MASTER)
+			{
+				int ret;
+
+				do
+				{
+					ret = core_start(i, contention_slave);
+					KASSERT((ret == 0) || (ret == -EBUSY));
+				} while (ret != 0);
+			}
+		}
+
+		contention_acquire();
+
+	fence_wait(&slave_fence);
+
+	dcache_invalidate();
+	KASSERT(contention_counter == CORES_NUM*CONTENTION_NACQUIRES);
+
+	min = max = contention_cycles[0];
+	for (int i = 1; i < CORES_NUM; i++)
+	{
+		if (contention_cycles[i] < min)
+			min = contention_cycles[i];
+		if (contention_cycles[i] > max)
+			max = contention_cycles[i];
+	}
+
+	CLUSTER_KPRINTF("[test][cluster][cores][stress] contention: fastest %d, slowest %d cycles/acquire",
+		(int) (min/CONTENTION_NACQUIRES),
+		(int) (max/CONTENTION_NACQUIRES)
+	);
+}
+
+/*----------------------------------------------------------------------------*
+ * Start Latency                                                              *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Number of starts for the start latency test.
+ */
+#define START_LATENCY_NSTARTS 100
+
+PRIVATE volatile bool start_latency_running; /* Slave running?               */
+PRIVATE volatile uint64_t start_latency_t1;   /* Time when slave got running. */
+
+/**
+ * @brief Records when the slave got running.
+ */
+PRIVATE void start_latency_slave(void)
+{
+	start_latency_t1 = clock_read();
+	start_latency_running = true;
+	dcache_invalidate();
+
+	KASSERT(core_release() == 0);
+	core_reset();
+}
+
+/**
+ * @brief Stress Test: Start Latency
+ *
+ * The master core repeatedly starts a slave core and waits for it
+ * to get running. Each start also covers the reset of the previous
+ * run, as the master core waits for the slave to get idle.
+ */
+PRIVATE void test_cluster_cores_stress_start_latency(void)
+{
+	uint64_t t0;
+	uint64_t latency;
+	uint64_t min = UINT64_MAX;
+	uint64_t max = 0;
+	uint64_t total = 0;
+	int coreid = (COREID_MASTER + 1)%CORES_NUM;
+
+	/* Test not applicable. */
+	if (CORES_NUM < 2)
+		return;
+
+	for (int k = 0; k < START_LATENCY_NSTARTS; k++)
+	{
+		int ret;
+
+		start_latency_running = false;
+		dcache_invalidate();
+
+		/* The slave may not have released itself yet. */
+		do
+		{
+			t0 = clock_read();
+			ret = core_start(coreid, start_latency_slave);
+			KASSERT((ret == 0) || (ret == -EBUSY));
+		} while (ret != 0);
+
+		/* Wait for slave core. */
+		do
+			dcache_invalidate();
+		while (!start_latency_running);
+
+		latency = start_latency_t1 - t0;
+		total += latency;
+		if (latency < min)
+			min = latency;
+		if (latency > max)
+			max = latency;
+	}
+
+	CLUSTER_KPRINTF("[test][cluster][cores][stress] start latency: min %d, avg %d, max %d cycles",
+		(int) min,
+		(int) (total/START_LATENCY_NSTARTS),
+		(int) max
+	);
+}
+
 #if CORE_SUPPORTS_MULTITHREADING
 
 /*----------------------------------------------------------------------------*
@@ -1049,6 +1226,67 @@ PRIVATE void test_cluster_core_api_inter_core_interrupt(void)
 
 #endif /* CLUSTER_HAS_IPI */
 
+/*----------------------------------------------------------------------------*
+ * Notify from Distant Cores                                                  *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Distance between the IDs of the notifying cores.
+ */
+#define TEST_CORES_EVENTS_DISTANCE (8*sizeof(unsigned))
+
+/**
+ * @brief Join fence for notifying cores.
+ */
+PRIVATE struct fence notifier_fence;
+
+/**
+ * @brief Notifies the master core.
+ */
+PRIVATE void notifier(void)
+{
+	KASSERT(event_notify(COREID_MASTER) == 0);
+
+	fence_join(&notifier_fence);
+
+	KASSERT(core_release() == 0);
+	core_reset();
+}
+
+/**
+ * @brief API Test: Notify from Distant Cores
+ *
+ * Two cores whose IDs lie a word apart notify the master core, which
+ * should take both events apart.
+ */
+PRIVATE void test_cluster_core_api_notify_distant(void)
+{
+	int coreid0;
+	int coreid1;
+
+	/* Test not applicable. */
+	if (CORES_NUM <= (int) (TEST_CORES_EVENTS_DISTANCE + 1))
+		return;
+
+	coreid1 = CORES_NUM - 1;
+	coreid0 = coreid1 - TEST_CORES_EVENTS_DISTANCE;
+
+	fence_init(&notifier_fence, 2);
+
+	KASSERT(core_start(coreid0, notifier) == 0);
+	KASSERT(core_start(coreid1, notifier) == 0);
+
+	fence_wait(&notifier_fence);
+
+	/*
+	 * Both events should be pending. Note that, if
+	 * they were merged, the master core will hang
+	 * forever.
+	 */
+	event_wait();
+	event_wait();
+}
+
 /*============================================================================*
  * Test Driver                                                                *
  *============================================================================*/
@@ -1070,6 +1308,7 @@ PRIVATE struct test core_tests_api[] = {
 #if CLUSTER_HAS_IPI
 	{ test_cluster_core_api_inter_core_interrupt, "interrupt others cores             " },
 #endif
+	{ test_cluster_core_api_notify_distant,       "notify from distant cores          " },
 	{ NULL,                                       NULL                                  },
 };
 
@@ -1091,10 +1330,12 @@ PRIVATE struct test fault_tests_api[] = {
  */
 #if defined(__ENABLE_STRESS_TESTS)
 PRIVATE struct test stress_tests_api[] = {
-	{ test_cluster_cores_stress_master_start, "start from master core" },
-	{ test_cluster_cores_stress_leader_start, "start from leader core" },
-	{ test_cluster_cores_stress_spinlocks,    "spinlock test         " },
-	{ NULL,                                    NULL                    },
+	{ test_cluster_cores_stress_master_start,        "start from master core" },
+	{ test_cluster_cores_stress_leader_start,        "start from leader core" },
+	{ test_cluster_cores_stress_spinlocks,           "spinlock test         " },
+	{ test_cluster_cores_stress_spinlock_contention, "spinlock contention   " },
+	{ test_cluster_cores_stress_start_latency,       "start latency         " },
+	{ NULL,                                           NULL                    },
 };
 #endif
 
@@ -0,0 +1,276 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/hal/hal.h>
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+#include "../test.h"
+
+/**
+ * @brief Number of page frames allocated at once.
+ */
+#define NFRAMES (2*FRAME_CACHE_SIZE)
+
+/**
+ * @brief Number of iterations for stress tests.
+ */
+#define NITERATIONS 1024
+
+/**
+ * @brief Page frames.
+ */
+PRIVATE paddr_t frames[NFRAMES];
+
+/*============================================================================*
+ * API Tests                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Allocate and Release a Page Frame
+ */
+PRIVATE void test_cluster_frame_api_alloc_free(void)
+{
+	paddr_t paddr;
+
+	KASSERT(frame_alloc(0, &paddr) == 0);
+	KASSERT(ALIGNED(paddr, PAGE_SIZE));
+	KASSERT(frame_free(paddr, 0) == 0);
+}
+
+/**
+ * @brief API Test: Allocate and Release Contiguous Page Frames
+ */
+PRIVATE void test_cluster_frame_api_alloc_free_order(void)
+{
+	for (int i = 0; i <= FRAME_ORDER_MAX; i++)
+	{
+		paddr_t paddr;
+
+		/* Memory may be too small for large orders. */
+		if (frame_alloc(i, &paddr) < 0)
+			continue;
+
+		KASSERT(ALIGNED(paddr - UBASE_PHYS, PAGE_SIZE << i));
+		KASSERT(frame_free(paddr, i) == 0);
+	}
+}
+
+/**
+ * @brief API Test: Allocate and Release Many Page Frames
+ */
+PRIVATE void test_cluster_frame_api_alloc_free_many(void)
+{
+	for (int i = 0; i < NFRAMES; i++)
+	{
+		KASSERT(frame_alloc(0, &frames[i]) == 0);
+
+		/* Page frames must be distinct. */
+		for (int j = 0; j < i; j++)
+			KASSERT(frames[i] != frames[j]);
+	}
+
+	for (int i = 0; i < NFRAMES; i++)
+		KASSERT(frame_free(frames[i], 0) == 0);
+}
+
+/**
+ * @brief API Test: Query Statistics
+ */
+PRIVATE void test_cluster_frame_api_stats(void)
+{
+	paddr_t paddr;
+	struct frame_stats before;
+	struct frame_stats after;
+
+	KASSERT(frame_stats_get(&before) == 0);
+	KASSERT(before.nframes > 0);
+	KASSERT(before.nfree <= before.nframes);
+
+		KASSERT(frame_alloc(1, &paddr) == 0);
+
+	KASSERT(frame_stats_get(&after) == 0);
+	KASSERT(before.nfree - after.nfree == 2);
+
+	KASSERT(frame_free(paddr, 1) == 0);
+}
+
+/*============================================================================*
+ * Fault Tests                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Fault Test: Allocate with an Invalid Order
+ */
+PRIVATE void test_cluster_frame_fault_alloc_inval(void)
+{
+	paddr_t paddr;
+
+	KASSERT(frame_alloc(-1, &paddr) == -EINVAL);
+	KASSERT(frame_alloc(FRAME_ORDER_MAX + 1, &paddr) == -EINVAL);
+	KASSERT(frame_alloc(0, NULL) == -EINVAL);
+}
+
+/**
+ * @brief Fault Test: Release Invalid Page Frames
+ */
+PRIVATE void test_cluster_frame_fault_free_inval(void)
+{
+	KASSERT(frame_free(UBASE_PHYS - PAGE_SIZE, 0) == -EINVAL);
+	KASSERT(frame_free(UBASE_PHYS, -1) == -EINVAL);
+	KASSERT(frame_free(UBASE_PHYS, FRAME_ORDER_MAX + 1) == -EINVAL);
+	KASSERT(frame_stats_get(NULL) == -EINVAL);
+}
+
+/**
+ * @brief Fault Test: Release Bad Page Frames
+ */
+PRIVATE void test_cluster_frame_fault_free_bad(void)
+{
+	paddr_t paddr;
+
+	KASSERT(frame_alloc(1, &paddr) == 0);
+
+		/* Misaligned and wrong order. */
+		KASSERT(frame_free(paddr + 1, 1) == -EINVAL);
+		KASSERT(frame_free(paddr + PAGE_SIZE, 1) == -EINVAL);
+		KASSERT(frame_free(paddr, 0) == -EINVAL);
+
+	KASSERT(frame_free(paddr, 1) == 0);
+
+	/* Double release. */
+	KASSERT(frame_free(paddr, 1) == -EINVAL);
+}
+
+/*============================================================================*
+ * Stress Tests                                                               *
+ *============================================================================*/
+
+#if defined(__ENABLE_STRESS_TESTS)
+
+/**
+ * @brief Stress Test: Allocation Cost
+ *
+ * Single page frames mostly hit the per-core cache, while larger
+ * blocks go through the buddy allocator each time.
+ */
+PRIVATE void test_cluster_frame_stress_alloc_free(void)
+{
+	uint64_t t0;
+	uint64_t cycles;
+
+	for (int i = 0; i <= FRAME_ORDER_MAX; i += 2)
+	{
+		t0 = clock_read();
+
+			for (int k = 0; k < NITERATIONS/NFRAMES; k++)
+			{
+				int n;
+
+				for (n = 0; n < NFRAMES; n++)
+				{
+					if (frame_alloc(i, &frames[n]) < 0)
+						break;
+				}
+				for (int j = 0; j < n; j++)
+					KASSERT(frame_free(frames[j], i) == 0);
+			}
+
+		cycles = clock_read() - t0;
+
+		CLUSTER_KPRINTF("[test][cluster][frame][stress] order %d: %d cycles/alloc+free",
+			i,
+			(int) (cycles/((NITERATIONS/NFRAMES)*NFRAMES))
+		);
+	}
+}
+
+#endif /* __ENABLE_STRESS_TESTS */
+
+/*============================================================================*
+ * Test Driver                                                                *
+ *============================================================================*/
+
+/**
+ * @brief API Tests.
+ */
+PRIVATE struct test frame_tests_api[] = {
+	{ test_cluster_frame_api_alloc_free,       "allocate and release a frame   " },
+	{ test_cluster_frame_api_alloc_free_order, "allocate and release contiguous" },
+	{ test_cluster_frame_api_alloc_free_many,  "allocate and release many      " },
+	{ test_cluster_frame_api_stats,            "query statistics               " },
+	{ NULL,                                     NULL                             },
+};
+
+/**
+ * @brief Fault Injection Tests.
+ */
+PRIVATE struct test frame_tests_fault[] = {
+	{ test_cluster_frame_fault_alloc_inval, "allocate with an invalid order " },
+	{ test_cluster_frame_fault_free_inval,  "release invalid frames         " },
+	{ test_cluster_frame_fault_free_bad,    "release bad frames             " },
+	{ NULL,                                  NULL                             },
+};
+
+/**
+ * @brief Stress Tests.
+ */
+#if defined(__ENABLE_STRESS_TESTS)
+PRIVATE struct test frame_tests_stress[] = {
+	{ test_cluster_frame_stress_alloc_free, "allocation cost" },
+	{ NULL,                                  NULL             },
+};
+#endif
+
+/**
+ * The test_cluster_frames() function launches testing units on the
+ * page frame allocator of the Cluster AL.
+ */
+PUBLIC void test_cluster_frames(void)
+{
+	/* API Tests */
+	CLUSTER_KPRINTF(HLINE);
+	for (int i = 0; frame_tests_api[i].test_fn != NULL; i++)
+	{
+		frame_tests_api[i].test_fn();
+		CLUSTER_KPRINTF("[test][cluster][frame][api] %s [passed]", frame_tests_api[i].name);
+	}
+
+	/* Fault Tests */
+	CLUSTER_KPRINTF(HLINE);
+	for (int i = 0; frame_tests_fault[i].test_fn != NULL; i++)
+	{
+		frame_tests_fault[i].test_fn();
+		CLUSTER_KPRINTF("[test][cluster][frame][fault] %s [passed]", frame_tests_fault[i].name);
+	}
+
+	/* Stress Tests */
+#if defined(__ENABLE_STRESS_TESTS)
+	CLUSTER_KPRINTF(HLINE);
+	for (int i = 0; frame_tests_stress[i].test_fn != NULL; i++)
+	{
+		frame_tests_stress[i].test_fn();
+		CLUSTER_KPRINTF("[test][cluster][frame][stress] %s [passed]", frame_tests_stress[i].name);
+	}
+#endif
+}
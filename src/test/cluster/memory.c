@@ -0,0 +1,158 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/hal/hal.h>
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+#include "../test.h"
+
+/*============================================================================*
+ * API Tests                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Memory Sizes
+ */
+PRIVATE void test_cluster_memory_api_sizes(void)
+{
+	KASSERT((kmem_size > 0) && (kmem_size <= KMEM_SIZE));
+	KASSERT((kpool_size > 0) && (kpool_size <= KPOOL_SIZE));
+	KASSERT((umem_size > 0) && (umem_size <= UMEM_SIZE));
+	KASSERT(ALIGNED(kmem_size, PAGE_SIZE));
+	KASSERT(ALIGNED(kpool_size, PAGE_SIZE));
+	KASSERT(ALIGNED(umem_size, PAGE_SIZE));
+}
+
+#ifdef __unix64__
+
+/**
+ * @brief API Test: Memory Layout Matches Boot Options
+ */
+PRIVATE void test_cluster_memory_api_layout(void)
+{
+	KASSERT(mem_layout[0].size == kmem_size);
+	KASSERT(mem_layout[1].size == kpool_size);
+	KASSERT((mem_layout[0].vend - mem_layout[0].vbase) == kmem_size);
+	KASSERT((mem_layout[1].vend - mem_layout[1].vbase) == kpool_size);
+	KASSERT((UEND_VIRT - UBASE_VIRT) == umem_size);
+
+	/* Kernel regions are backed up to their last byte. */
+	for (int i = 0; i < MEM_REGIONS; i++)
+		UNUSED(*((volatile char *)(mem_layout[i].vend - 1)));
+}
+
+#endif /* __unix64__ */
+
+/*============================================================================*
+ * Fault Tests                                                                *
+ *============================================================================*/
+
+#ifdef __unix64__
+
+/**
+ * @brief Fault Test: Configure Memory With Invalid Sizes
+ */
+PRIVATE void test_cluster_memory_fault_configure_inval(void)
+{
+	int hugepages = LINUX64_CLUSTER_HUGEPAGES_NONE;
+
+	KASSERT(linux64_cluster_memory_configure(0, kpool_size, umem_size, hugepages) == -EINVAL);
+	KASSERT(linux64_cluster_memory_configure(PAGE_SIZE + 1, kpool_size, umem_size, hugepages) == -EINVAL);
+	KASSERT(linux64_cluster_memory_configure(KMEM_SIZE + PAGE_SIZE, kpool_size, umem_size, hugepages) == -EINVAL);
+	KASSERT(linux64_cluster_memory_configure(kmem_size, 0, umem_size, hugepages) == -EINVAL);
+	KASSERT(linux64_cluster_memory_configure(kmem_size, KPOOL_SIZE + PAGE_SIZE, umem_size, hugepages) == -EINVAL);
+	KASSERT(linux64_cluster_memory_configure(kmem_size, kpool_size, PGTAB_SIZE - PAGE_SIZE, hugepages) == -EINVAL);
+	KASSERT(linux64_cluster_memory_configure(kmem_size, kpool_size, PGTAB_SIZE + PAGE_SIZE, hugepages) == -EINVAL);
+	KASSERT(linux64_cluster_memory_configure(kmem_size, kpool_size, UMEM_SIZE + PGTAB_SIZE, hugepages) == -EINVAL);
+}
+
+/**
+ * @brief Fault Test: Configure Memory With Invalid Huge Page Backing
+ */
+PRIVATE void test_cluster_memory_fault_configure_hugepages(void)
+{
+	KASSERT(linux64_cluster_memory_configure(kmem_size, kpool_size, umem_size, -1) == -EINVAL);
+	KASSERT(linux64_cluster_memory_configure(kmem_size, kpool_size, umem_size, LINUX64_CLUSTER_HUGEPAGES_EXPLICIT + 1) == -EINVAL);
+}
+
+/**
+ * @brief Fault Test: Configure Memory After Boot
+ */
+PRIVATE void test_cluster_memory_fault_configure_busy(void)
+{
+	KASSERT(linux64_cluster_memory_configure(kmem_size, kpool_size, umem_size, LINUX64_CLUSTER_HUGEPAGES_NONE) == -EBUSY);
+}
+
+#endif /* __unix64__ */
+
+/*============================================================================*
+ * Test Driver                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test memory_tests_api[] = {
+	{ test_cluster_memory_api_sizes,  "memory sizes                  " },
+#ifdef __unix64__
+	{ test_cluster_memory_api_layout, "memory layout                 " },
+#endif
+	{ NULL,                            NULL                             },
+};
+
+/**
+ * @brief Fault injection tests.
+ */
+PRIVATE struct test memory_tests_fault[] = {
+#ifdef __unix64__
+	{ test_cluster_memory_fault_configure_inval,     "configure invalid sizes       " },
+	{ test_cluster_memory_fault_configure_hugepages, "configure invalid huge pages  " },
+	{ test_cluster_memory_fault_configure_busy,      "configure after boot          " },
+#endif
+	{ NULL,                                           NULL                             },
+};
+
+/**
+ * The test_cluster_memory() function launches testing units on the
+ * memory interface of the Cluster AL.
+ */
+PUBLIC void test_cluster_memory(void)
+{
+	/* API Tests */
+	CLUSTER_KPRINTF(HLINE);
+	for (int i = 0; memory_tests_api[i].test_fn != NULL; i++)
+	{
+		memory_tests_api[i].test_fn();
+		CLUSTER_KPRINTF("[test][cluster][memory][api] %s [passed]", memory_tests_api[i].name);
+	}
+
+	/* Fault Tests */
+	CLUSTER_KPRINTF(HLINE);
+	for (int i = 0; memory_tests_fault[i].test_fn != NULL; i++)
+	{
+		memory_tests_fault[i].test_fn();
+		CLUSTER_KPRINTF("[test][cluster][memory][fault] %s [passed]", memory_tests_fault[i].name);
+	}
+}
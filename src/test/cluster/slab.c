@@ -0,0 +1,377 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/hal/hal.h>
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+#include "../test.h"
+
+/**
+ * @brief Number of objects allocated at once.
+ */
+#define NOBJECTS (4*SLAB_MAGAZINE_SIZE)
+
+/**
+ * @brief Number of iterations for stress tests.
+ */
+#define NITERATIONS 1000
+
+/**
+ * @brief Objects.
+ */
+PRIVATE void *objs[NOBJECTS];
+
+/*============================================================================*
+ * API Tests                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Allocate and Release an Object
+ */
+PRIVATE void test_cluster_slab_api_alloc_free(void)
+{
+	for (int i = 0; i < SLAB_CLASSES; i++)
+	{
+		char *obj;
+		size_t size = SLAB_OBJECT_MIN << i;
+
+		KASSERT((obj = slab_alloc(size)) != NULL);
+		KASSERT(((uintptr_t) obj & (SLAB_OBJECT_MIN - 1)) == 0);
+
+		/* Object must be writable all along. */
+		kmemset(obj, i, size);
+		KASSERT(obj[0] == i);
+		KASSERT(obj[size - 1] == i);
+
+		KASSERT(slab_free(obj) == 0);
+	}
+}
+
+/**
+ * @brief API Test: Allocate and Release Many Objects
+ */
+PRIVATE void test_cluster_slab_api_alloc_free_many(void)
+{
+	for (int i = 0; i < SLAB_CLASSES; i++)
+	{
+		size_t size = SLAB_OBJECT_MIN << i;
+
+		for (int j = 0; j < NOBJECTS; j++)
+		{
+			KASSERT((objs[j] = slab_alloc(size)) != NULL);
+			*((int *) objs[j]) = j;
+		}
+
+		/* Objects must not overlap. */
+		for (int j = 0; j < NOBJECTS; j++)
+			KASSERT(*((int *) objs[j]) == j);
+
+		for (int j = 0; j < NOBJECTS; j++)
+			KASSERT(slab_free(objs[j]) == 0);
+	}
+}
+
+/**
+ * @brief API Test: Query Statistics
+ */
+PRIVATE void test_cluster_slab_api_stats(void)
+{
+	struct slab_stats before;
+	struct slab_stats after;
+
+	KASSERT(slab_stats_get(0, &before) == 0);
+	KASSERT(before.size == SLAB_OBJECT_MIN);
+	KASSERT(before.objects > 0);
+
+		for (int j = 0; j < NOBJECTS; j++)
+			KASSERT((objs[j] = slab_alloc(1)) != NULL);
+		for (int j = 0; j < NOBJECTS; j++)
+			KASSERT(slab_free(objs[j]) == 0);
+
+	KASSERT(slab_stats_get(0, &after) == 0);
+	KASSERT(after.allocs - before.allocs == NOBJECTS);
+	KASSERT(after.frees - before.frees == NOBJECTS);
+	KASSERT(after.slabs > 0);
+}
+
+/*============================================================================*
+ * Fault Tests                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Fault Test: Allocate an Invalid Object
+ */
+PRIVATE void test_cluster_slab_fault_alloc_inval(void)
+{
+	KASSERT(slab_alloc(0) == NULL);
+	KASSERT(slab_alloc(SLAB_OBJECT_MAX + 1) == NULL);
+}
+
+/**
+ * @brief Fault Test: Release an Invalid Object
+ */
+PRIVATE void test_cluster_slab_fault_free_inval(void)
+{
+	KASSERT(slab_free(NULL) == -EINVAL);
+	KASSERT(slab_free(&objs[0]) == -EINVAL);
+}
+
+/**
+ * @brief Fault Test: Release a Bad Object
+ */
+PRIVATE void test_cluster_slab_fault_free_bad(void)
+{
+	char *obj;
+
+	KASSERT((obj = slab_alloc(SLAB_OBJECT_MIN)) != NULL);
+
+		KASSERT(slab_free(obj + 1) == -EINVAL);
+
+	KASSERT(slab_free(obj) == 0);
+}
+
+/**
+ * @brief Fault Test: Query Statistics of an Invalid Class
+ */
+PRIVATE void test_cluster_slab_fault_stats_inval(void)
+{
+	struct slab_stats stats;
+
+	KASSERT(slab_stats_get(-1, &stats) == -EINVAL);
+	KASSERT(slab_stats_get(SLAB_CLASSES, &stats) == -EINVAL);
+	KASSERT(slab_stats_get(0, NULL) == -EINVAL);
+}
+
+/*============================================================================*
+ * Stress Tests                                                               *
+ *============================================================================*/
+
+#if defined(__ENABLE_STRESS_TESTS)
+
+/**
+ * @brief Stress Test: Allocation Cost
+ *
+ * Objects are allocated and released in bursts larger than a
+ * magazine, so that both the per-core caches and the shared slabs
+ * get exercised.
+ */
+PRIVATE void test_cluster_slab_stress_alloc_free(void)
+{
+	uint64_t t0;
+	uint64_t cycles;
+
+	for (int i = 0; i < SLAB_CLASSES; i++)
+	{
+		size_t size = SLAB_OBJECT_MIN << i;
+
+		t0 = clock_read();
+
+			for (int k = 0; k < NITERATIONS/NOBJECTS; k++)
+			{
+				for (int j = 0; j < NOBJECTS; j++)
+					KASSERT((objs[j] = slab_alloc(size)) != NULL);
+				for (int j = 0; j < NOBJECTS; j++)
+					KASSERT(slab_free(objs[j]) == 0);
+			}
+
+		cycles = clock_read() - t0;
+
+		CLUSTER_KPRINTF("[test][cluster][slab][stress] %d bytes: %d cycles/alloc+free",
+			(int) size,
+			(int) (cycles/((NITERATIONS/NOBJECTS)*NOBJECTS))
+		);
+	}
+}
+
+#if (CLUSTER_IS_MULTICORE)
+
+/**
+ * @brief Slave fence.
+ */
+PRIVATE struct fence slab_fence;
+
+/**
+ * @brief Cycles spent by each core.
+ */
+PRIVATE uint64_t slab_cycles[CORES_NUM_MAX];
+
+/**
+ * @brief Allocates and releases objects.
+ */
+PRIVATE void slab_hammer(void)
+{
+	uint64_t t0;
+	void *mine[SLAB_MAGAZINE_SIZE];
+
+	t0 = clock_read();
+
+		for (int k = 0; k < NITERATIONS/SLAB_MAGAZINE_SIZE; k++)
+		{
+			for (int j = 0; j < SLAB_MAGAZINE_SIZE; j++)
+			{
+				KASSERT((mine[j] = slab_alloc(SLAB_OBJECT_MIN)) != NULL);
+				*((int *) mine[j]) = core_get_id();
+			}
+			for (int j = 0; j < SLAB_MAGAZINE_SIZE; j++)
+			{
+				KASSERT(*((int *) mine[j]) == core_get_id());
+				KASSERT(slab_free(mine[j]) == 0);
+			}
+		}
+
+	slab_cycles[core_get_id()] = clock_read() - t0;
+}
+
+/**
+ * @brief Hammering slave.
+ */
+PRIVATE void slab_slave(void)
+{
+	slab_hammer();
+
+	fence_join(&slab_fence);
+
+	KASSERT(core_release() == 0);
+	core_reset();
+}
+
+/**
+ * @brief Stress Test: Concurrent Allocations
+ *
+ * All cores allocate and release objects of the same class. As long
+ * as each core works within its magazines, it should go as fast as
+ * a single core does.
+ */
+PRIVATE void test_cluster_slab_stress_concurrent(void)
+{
+	uint64_t max = 0;
+
+	fence_init(&slab_fence, CORES_NUM - 1);
+
+		/* Start execution in all cores. */
+		for (int i = 0; i < CORES_NUM; i++)
+		{
+			if (i != COREID_MASTER)
+			{
+				int ret;
+
+				do
+				{
+					ret = core_start(i, slab_slave);
+					KASSERT((ret == 0) || (ret == -EBUSY));
+				} while (ret != 0);
+			}
+		}
+
+		slab_hammer();
+
+	fence_wait(&slab_fence);
+
+	dcache_invalidate();
+
+	for (int i = 0; i < CORES_NUM; i++)
+	{
+		if (slab_cycles[i] > max)
+			max = slab_cycles[i];
+	}
+
+	CLUSTER_KPRINTF("[test][cluster][slab][stress] concurrent: slowest %d cycles/alloc+free",
+		(int) (max/((NITERATIONS/SLAB_MAGAZINE_SIZE)*SLAB_MAGAZINE_SIZE))
+	);
+}
+
+#endif /* CLUSTER_IS_MULTICORE */
+
+#endif /* __ENABLE_STRESS_TESTS */
+
+/*============================================================================*
+ * Test Driver                                                                *
+ *============================================================================*/
+
+/**
+ * @brief API Tests.
+ */
+PRIVATE struct test slab_tests_api[] = {
+	{ test_cluster_slab_api_alloc_free,      "allocate and release an object " },
+	{ test_cluster_slab_api_alloc_free_many, "allocate and release many      " },
+	{ test_cluster_slab_api_stats,           "query statistics               " },
+	{ NULL,                                   NULL                             },
+};
+
+/**
+ * @brief Fault Injection Tests.
+ */
+PRIVATE struct test slab_tests_fault[] = {
+	{ test_cluster_slab_fault_alloc_inval, "allocate an invalid object     " },
+	{ test_cluster_slab_fault_free_inval,  "release an invalid object      " },
+	{ test_cluster_slab_fault_free_bad,    "release a bad object           " },
+	{ test_cluster_slab_fault_stats_inval, "query statistics of bad class  " },
+	{ NULL,                                 NULL                             },
+};
+
+/**
+ * @brief Stress Tests.
+ */
+#if defined(__ENABLE_STRESS_TESTS)
+PRIVATE struct test slab_tests_stress[] = {
+	{ test_cluster_slab_stress_alloc_free, "allocation cost       " },
+#if (CLUSTER_IS_MULTICORE)
+	{ test_cluster_slab_stress_concurrent, "concurrent allocations" },
+#endif
+	{ NULL,                                 NULL                    },
+};
+#endif
+
+/**
+ * The test_cluster_slab() function launches testing units on the
+ * slab allocator of the Cluster AL.
+ */
+PUBLIC void test_cluster_slab(void)
+{
+	/* API Tests */
+	CLUSTER_KPRINTF(HLINE);
+	for (int i = 0; slab_tests_api[i].test_fn != NULL; i++)
+	{
+		slab_tests_api[i].test_fn();
+		CLUSTER_KPRINTF("[test][cluster][slab][api] %s [passed]", slab_tests_api[i].name);
+	}
+
+	/* Fault Tests */
+	CLUSTER_KPRINTF(HLINE);
+	for (int i = 0; slab_tests_fault[i].test_fn != NULL; i++)
+	{
+		slab_tests_fault[i].test_fn();
+		CLUSTER_KPRINTF("[test][cluster][slab][fault] %s [passed]", slab_tests_fault[i].name);
+	}
+
+	/* Stress Tests */
+#if defined(__ENABLE_STRESS_TESTS)
+	CLUSTER_KPRINTF(HLINE);
+	for (int i = 0; slab_tests_stress[i].test_fn != NULL; i++)
+	{
+		slab_tests_stress[i].test_fn();
+		CLUSTER_KPRINTF("[test][cluster][slab][stress] %s [passed]", slab_tests_stress[i].name);
+	}
+#endif
+}
@@ -32,12 +32,404 @@
  */
 #define TEST_TIMER_VERBOSE 0
 
+#ifdef __unix64__
+
+/**
+ * @brief Frequency of timer interrupts in tests (in Hz).
+ */
+#define TEST_TIMER_FREQ 1000
+
+/**
+ * @brief How long to wait for a timer interrupt (in clock cycles).
+ */
+#define TEST_TIMER_TIMEOUT CLUSTER_FREQ
+
+/**
+ * @brief Number of timer interrupts handled.
+ */
+PRIVATE volatile int timer_ncalls = 0;
+
+/**
+ * @brief Timer interrupt handler.
+ */
+PRIVATE void timer_handler(int num)
+{
+	UNUSED(num);
+
+	timer_ncalls++;
+	dcache_invalidate();
+}
+
+/**
+ * @name States of the Slave Core
+ */
+/**@{*/
+#define TEST_TIMER_RUNNING 0xDEAD /**< Slave core is taking ticks. */
+#define TEST_TIMER_AWAKEN  0xC0DE /**< Slave core is awaken.       */
+/**@}*/
+
+/**
+ * @brief State of the slave core.
+ */
+PRIVATE volatile int timer_slave_state = 0;
+
+/**
+ * @brief Busy waits.
+ *
+ * @param ncycles Number of clock cycles to wait.
+ */
+PRIVATE void timer_delay(uint64_t ncycles)
+{
+	uint64_t t0;
+
+	t0 = clock_read();
+	while ((clock_read() - t0) < ncycles)
+		noop();
+}
+
+/**
+ * @brief Waits for a timer interrupt.
+ */
+PRIVATE void timer_wait_tick(void)
+{
+	int ncalls;
+	uint64_t t0;
+
+	ncalls = timer_ncalls;
+
+	t0 = clock_read();
+	do
+		dcache_invalidate();
+	while ((timer_ncalls == ncalls) && ((clock_read() - t0) < TEST_TIMER_TIMEOUT));
+
+	KASSERT(timer_ncalls != ncalls);
+}
+
+/**
+ * @brief Asserts that no core takes timer interrupts for a while.
+ */
+PRIVATE void timer_assert_no_ticks(void)
+{
+	int ncalls;
+
+	ncalls = timer_ncalls;
+	timer_delay(TEST_TIMER_TIMEOUT/10);
+
+	/* A tick may have been in flight. */
+	KASSERT((timer_ncalls - ncalls) <= 1);
+}
+
+/**
+ * @brief Slave core that takes ticks and then sleeps.
+ */
+PRIVATE void timer_slave_sleep(void)
+{
+	interrupts_enable();
+
+		timer_init(TEST_TIMER_FREQ);
+		timer_wait_tick();
+
+		timer_slave_state = TEST_TIMER_RUNNING;
+		dcache_invalidate();
+
+		core_sleep();
+
+		timer_init(0);
+
+	interrupts_disable();
+
+	timer_slave_state = TEST_TIMER_AWAKEN;
+	dcache_invalidate();
+
+	KASSERT(core_release() == 0);
+	core_reset();
+}
+
+/**
+ * @brief Slave core that takes ticks and then gets idle.
+ */
+PRIVATE void timer_slave_idle(void)
+{
+	interrupts_enable();
+
+		timer_init(TEST_TIMER_FREQ);
+		timer_wait_tick();
+
+	timer_slave_state = TEST_TIMER_RUNNING;
+	dcache_invalidate();
+
+	KASSERT(core_release() == 0);
+	core_reset();
+}
+
+/**
+ * @brief Slave core that stops its ticks.
+ */
+PRIVATE void timer_slave_stop(void)
+{
+	timer_init(0);
+
+	timer_slave_state = TEST_TIMER_AWAKEN;
+	dcache_invalidate();
+
+	KASSERT(core_release() == 0);
+	core_reset();
+}
+
+/**
+ * @brief Returns the ID of some slave core.
+ */
+PRIVATE int timer_slave_get(void)
+{
+	for (int i = 0; i < CORES_NUM; i++)
+	{
+		if (i != COREID_MASTER)
+			return (i);
+	}
+
+	return (-1);
+}
+
+#endif /* __unix64__ */
+
+#ifndef __x86__
+
+/*============================================================================*
+ * API Tests                                                                  *
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*
+ * Read the Clock                                                             *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Read the Clock
+ */
+PRIVATE void test_timer_clock_read(void)
+{
+	uint64_t t1;
+	uint64_t t2;
+
+	/* Clock must not go backwards. */
+	t1 = clock_read();
+	t2 = clock_read();
+	KASSERT(t2 >= t1);
+
+#if (TEST_TIMER_VERBOSE)
+	kprintf("[test][cluster][timer] clock = %d", t2);
+#endif
+}
+
+/*----------------------------------------------------------------------------*
+ * Query Avoided Ticks                                                        *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Query Avoided Ticks
+ */
+PRIVATE void test_timer_ticks_avoided(void)
+{
+	uint64_t nticks;
+
+	KASSERT(timer_ticks_avoided(core_get_id(), &nticks) == 0);
+}
+
+#ifdef __unix64__
+
+/*----------------------------------------------------------------------------*
+ * Handle Timer Interrupts                                                    *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Handle Timer Interrupts
+ */
+PRIVATE void test_timer_interrupt(void)
+{
+	uint64_t t0;
+
+	timer_ncalls = 0;
+	dcache_invalidate();
+
+	KASSERT(interrupt_register(INTERRUPT_TIMER, timer_handler) == 0);
+
+	interrupts_enable();
+
+		timer_init(TEST_TIMER_FREQ);
+
+		/* Wait for at least one tick. */
+		t0 = clock_read();
+		do
+			dcache_invalidate();
+		while ((timer_ncalls == 0) && ((clock_read() - t0) < TEST_TIMER_TIMEOUT));
+
+		timer_init(0);
+
+	interrupts_disable();
+
+	KASSERT(interrupt_unregister(INTERRUPT_TIMER) == 0);
+
+	KASSERT(timer_ncalls > 0);
+}
+
+/*----------------------------------------------------------------------------*
+ * Stop Ticks of a Sleeping Core                                              *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Stop Ticks of a Sleeping Core
+ */
+PRIVATE void test_timer_tickless_sleep(void)
+{
+	int coreid;
+	uint64_t nticks0;
+	uint64_t nticks1;
+
+	timer_ncalls = 0;
+	timer_slave_state = 0;
+	dcache_invalidate();
+
+	KASSERT((coreid = timer_slave_get()) >= 0);
+	KASSERT(timer_ticks_avoided(coreid, &nticks0) == 0);
+
+	KASSERT(interrupt_register(INTERRUPT_TIMER, timer_handler) == 0);
+
+		KASSERT(core_start(coreid, timer_slave_sleep) == 0);
+
+		do
+			dcache_invalidate();
+		while (timer_slave_state != TEST_TIMER_RUNNING);
+
+		/* Let the slave core fall asleep. */
+		timer_delay(TEST_TIMER_TIMEOUT/20);
+
+		timer_assert_no_ticks();
+
+		KASSERT(core_wakeup(coreid) == 0);
+
+		do
+			dcache_invalidate();
+		while (timer_slave_state != TEST_TIMER_AWAKEN);
+
+	KASSERT(interrupt_unregister(INTERRUPT_TIMER) == 0);
+
+	KASSERT(timer_ticks_avoided(coreid, &nticks1) == 0);
+	KASSERT(nticks1 > nticks0);
+}
+
+/*----------------------------------------------------------------------------*
+ * Stop Ticks of an Idle Core                                                 *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Stop Ticks of an Idle Core
+ */
+PRIVATE void test_timer_tickless_idle(void)
+{
+	int ret;
+	int coreid;
+	uint64_t nticks0;
+	uint64_t nticks1;
+
+	timer_ncalls = 0;
+	timer_slave_state = 0;
+	dcache_invalidate();
+
+	KASSERT((coreid = timer_slave_get()) >= 0);
+	KASSERT(timer_ticks_avoided(coreid, &nticks0) == 0);
+
+	KASSERT(interrupt_register(INTERRUPT_TIMER, timer_handler) == 0);
+
+		KASSERT(core_start(coreid, timer_slave_idle) == 0);
+
+		do
+			dcache_invalidate();
+		while (timer_slave_state != TEST_TIMER_RUNNING);
+
+		/* Let the slave core get idle. */
+		timer_delay(TEST_TIMER_TIMEOUT/20);
+
+		timer_assert_no_ticks();
+
+		do
+		{
+			ret = core_start(coreid, timer_slave_stop);
+			KASSERT((ret == 0) || (ret == -EBUSY));
+		} while (ret != 0);
+
+		do
+			dcache_invalidate();
+		while (timer_slave_state != TEST_TIMER_AWAKEN);
+
+	KASSERT(interrupt_unregister(INTERRUPT_TIMER) == 0);
+
+	KASSERT(timer_ticks_avoided(coreid, &nticks1) == 0);
+	KASSERT(nticks1 > nticks0);
+}
+
+#endif /* __unix64__ */
+
+/*============================================================================*
+ * Fault Injection Tests                                                      *
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*
+ * Query Avoided Ticks of an Invalid Core                                     *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Fault Injection Test: Query Avoided Ticks of an Invalid Core
+ */
+PRIVATE void test_timer_ticks_avoided_inval(void)
+{
+	uint64_t nticks;
+
+	KASSERT(timer_ticks_avoided(-1, &nticks) == -EINVAL);
+	KASSERT(timer_ticks_avoided(CORES_NUM, &nticks) == -EINVAL);
+}
+
+/*----------------------------------------------------------------------------*
+ * Query Avoided Ticks into a Bad Location                                    *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Fault Injection Test: Query Avoided Ticks into a Bad Location
+ */
+PRIVATE void test_timer_ticks_avoided_bad(void)
+{
+	KASSERT(timer_ticks_avoided(core_get_id(), NULL) == -EINVAL);
+}
+
 /*============================================================================*
  * Test Driver                                                                *
  *============================================================================*/
 
 /**
- * The test_spinlock() function launches testing units on the spinlock
+ * @brief API tests.
+ */
+PRIVATE struct test timer_tests_api[] = {
+	{ test_timer_clock_read,     "read the clock          " },
+	{ test_timer_ticks_avoided,  "query avoided ticks     " },
+#ifdef __unix64__
+	{ test_timer_interrupt,      "handle timer interrupts " },
+	{ test_timer_tickless_sleep, "stop ticks when asleep  " },
+	{ test_timer_tickless_idle,  "stop ticks when idle    " },
+#endif
+	{ NULL,                       NULL                       },
+};
+
+/**
+ * @brief Fault injection tests.
+ */
+PRIVATE struct test timer_tests_fault[] = {
+	{ test_timer_ticks_avoided_inval, "query ticks of invalid core " },
+	{ test_timer_ticks_avoided_bad,   "query ticks into bad buffer " },
+	{ NULL,                            NULL                           },
+};
+
+#endif /* !__x86__ */
+
+/**
+ * The test_timer() function launches testing units on the timer
  * interface of the HAL.
  *
  * @author Daniel Coscia
@@ -45,7 +437,20 @@
 PUBLIC void test_timer(void)
 {
 #ifndef __x86__
-    timer_init(0);
-    kprintf("clock = %d", clock_read());
+	/* API Tests */
+	CLUSTER_KPRINTF(HLINE);
+	for (int i = 0; timer_tests_api[i].test_fn != NULL; i++)
+	{
+		timer_tests_api[i].test_fn();
+		CLUSTER_KPRINTF("[test][cluster][timer][api] %s [passed]", timer_tests_api[i].name);
+	}
+
+	/* Fault Tests */
+	CLUSTER_KPRINTF(HLINE);
+	for (int i = 0; timer_tests_fault[i].test_fn != NULL; i++)
+	{
+		timer_tests_fault[i].test_fn();
+		CLUSTER_KPRINTF("[test][cluster][timer][fault] %s [passed]", timer_tests_fault[i].name);
+	}
 #endif
 }
@@ -447,6 +447,355 @@ PRIVATE void mmu_pde_get_inval(void)
 	KASSERT(pde_get(NULL, KBASE_VIRT) == NULL);
 }
 
+/*----------------------------------------------------------------------------*
+ * Map and Unmap a Page                                                       *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Scratch page table.
+ */
+PRIVATE struct pte mmu_scratch_pgtab[PGTAB_LENGTH] ALIGN(PAGE_SIZE);
+
+/**
+ * @brief API Test: Map and Unmap a Page
+ */
+PRIVATE void mmu_page_map_unmap(void)
+{
+	struct pte *pte;
+
+	kmemset(mmu_scratch_pgtab, 0, sizeof(mmu_scratch_pgtab));
+
+	KASSERT(mmu_page_map(mmu_scratch_pgtab, KBASE_PHYS, KBASE_VIRT, 1, 0) == 0);
+	KASSERT((pte = pte_get(mmu_scratch_pgtab, KBASE_VIRT)) != NULL);
+	KASSERT(pte_is_present(pte));
+
+	KASSERT(mmu_page_unmap(mmu_scratch_pgtab, KBASE_VIRT) == 0);
+	KASSERT(!pte_is_present(pte));
+	KASSERT(mmu_page_unmap(mmu_scratch_pgtab, KBASE_VIRT) == -EINVAL);
+}
+
+/*----------------------------------------------------------------------------*
+ * Map a Range of Pages                                                       *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Map a Range of Pages
+ *
+ * The first kernel pages are mapped again in place, with the same
+ * permissions, so this test is nondestructive.
+ */
+PRIVATE void mmu_page_map_range(void)
+{
+	struct pte *pte;
+
+	KASSERT(mmu_map_range(root_pgdir, KBASE_PHYS, KBASE_VIRT, 2, 1, 1) == 0);
+
+	for (int i = 0; i < 2; i++)
+	{
+		KASSERT((pte = pte_get(kernel_pgtab, KBASE_VIRT + i*PAGE_SIZE)) != NULL);
+		KASSERT(pte_is_present(pte));
+		KASSERT(pte_frame_get(pte) == ((KBASE_PHYS + i*PAGE_SIZE) >> PAGE_SHIFT));
+	}
+}
+
+/*----------------------------------------------------------------------------*
+ * Map and Unmap a Range Across Page Tables                                   *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Scratch page directory.
+ */
+PRIVATE struct pde mmu_scratch_pgdir[PGDIR_LENGTH] ALIGN(PAGE_SIZE);
+
+/**
+ * @brief Second scratch page table.
+ */
+PRIVATE struct pte mmu_scratch_pgtab2[PGTAB_LENGTH] ALIGN(PAGE_SIZE);
+
+/**
+ * @brief Virtual address where the scratch page tables meet.
+ */
+#define TEST_MMU_PGTAB_BOUNDARY ((UBASE_VIRT & PGTAB_MASK) + PGTAB_SIZE)
+
+/**
+ * @brief Builds a scratch address space out of the scratch page
+ * directory and the two scratch page tables, which cover adjacent
+ * virtual addresses.
+ */
+PRIVATE void mmu_scratch_setup(void)
+{
+	kmemset(mmu_scratch_pgdir, 0, sizeof(mmu_scratch_pgdir));
+	kmemset(mmu_scratch_pgtab, 0, sizeof(mmu_scratch_pgtab));
+	kmemset(mmu_scratch_pgtab2, 0, sizeof(mmu_scratch_pgtab2));
+
+	KASSERT(mmu_pgtab_map(mmu_scratch_pgdir, PADDR(mmu_scratch_pgtab), TEST_MMU_PGTAB_BOUNDARY - PGTAB_SIZE) == 0);
+	KASSERT(mmu_pgtab_map(mmu_scratch_pgdir, PADDR(mmu_scratch_pgtab2), TEST_MMU_PGTAB_BOUNDARY) == 0);
+}
+
+/**
+ * @brief API Test: Map and Unmap a Range Across Page Tables
+ *
+ * The range starts in the last two pages of the first scratch page
+ * table and ends in the first two pages of the second one.
+ */
+PRIVATE void mmu_range_cross(void)
+{
+	struct pte *pte;
+	vaddr_t vaddr = TEST_MMU_PGTAB_BOUNDARY - 2*PAGE_SIZE;
+
+	mmu_scratch_setup();
+
+	KASSERT(mmu_map_range(mmu_scratch_pgdir, UBASE_PHYS, vaddr, 4, 1, 0) == 0);
+
+	for (int i = 0; i < 4; i++)
+	{
+		struct pte *pgtab = (i < 2) ? mmu_scratch_pgtab : mmu_scratch_pgtab2;
+
+		KASSERT((pte = pte_get(pgtab, vaddr + i*PAGE_SIZE)) != NULL);
+		KASSERT(pte_is_present(pte));
+		KASSERT(pte_frame_get(pte) == ((UBASE_PHYS + i*PAGE_SIZE) >> PAGE_SHIFT));
+	}
+
+	KASSERT(mmu_unmap_range(mmu_scratch_pgdir, vaddr, 4) == 0);
+
+	for (int i = 0; i < 4; i++)
+	{
+		struct pte *pgtab = (i < 2) ? mmu_scratch_pgtab : mmu_scratch_pgtab2;
+
+		KASSERT(!pte_is_present(pte_get(pgtab, vaddr + i*PAGE_SIZE)));
+	}
+}
+
+/*----------------------------------------------------------------------------*
+ * Enumerate Mappings                                                         *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Maximum number of mappings enumerated at once.
+ */
+#define TEST_MMU_MAPPINGS_MAX 8
+
+/**
+ * @brief Asserts whether a page is among enumerated mappings.
+ *
+ * @param vaddrs    Enumerated mappings.
+ * @param nmappings Number of enumerated mappings.
+ * @param vaddr     Target page.
+ */
+PRIVATE bool mmu_mappings_has(const vaddr_t *vaddrs, int nmappings, vaddr_t vaddr)
+{
+	for (int i = 0; (i < nmappings) && (i < TEST_MMU_MAPPINGS_MAX); i++)
+	{
+		if (vaddrs[i] == vaddr)
+			return (true);
+	}
+
+	return (false);
+}
+
+/**
+ * @brief API Test: Enumerate Mappings
+ *
+ * The same page is mapped in two scratch page tables, which stand in
+ * for two address spaces, so each mapping is counted on its own.
+ */
+PRIVATE void mmu_page_enum(void)
+{
+	int nmappings;
+	vaddr_t vaddrs[TEST_MMU_MAPPINGS_MAX];
+
+	kmemset(mmu_scratch_pgtab, 0, sizeof(mmu_scratch_pgtab));
+	kmemset(mmu_scratch_pgtab2, 0, sizeof(mmu_scratch_pgtab2));
+
+	KASSERT((nmappings = mmu_page_mappings(UBASE_PHYS, vaddrs, TEST_MMU_MAPPINGS_MAX)) >= 0);
+	KASSERT(nmappings < (TEST_MMU_MAPPINGS_MAX - 2));
+
+	/* One address space. */
+	KASSERT(mmu_page_map(mmu_scratch_pgtab, UBASE_PHYS, UBASE_VIRT, 1, 0) == 0);
+	KASSERT(mmu_page_mappings(UBASE_PHYS, vaddrs, TEST_MMU_MAPPINGS_MAX) == (nmappings + 1));
+	KASSERT(mmu_mappings_has(vaddrs, nmappings + 1, UBASE_VIRT));
+
+	/* Two address spaces. */
+	KASSERT(mmu_page_map(mmu_scratch_pgtab2, UBASE_PHYS, UBASE_VIRT, 1, 0) == 0);
+	KASSERT(mmu_page_mappings(UBASE_PHYS, vaddrs, TEST_MMU_MAPPINGS_MAX) == (nmappings + 2));
+
+	KASSERT(mmu_page_unmap(mmu_scratch_pgtab, UBASE_VIRT) == 0);
+	KASSERT(mmu_page_mappings(UBASE_PHYS, vaddrs, TEST_MMU_MAPPINGS_MAX) == (nmappings + 1));
+	KASSERT(mmu_mappings_has(vaddrs, nmappings + 1, UBASE_VIRT));
+
+	/* Dropped without unmapping. */
+	kmemset(mmu_scratch_pgtab2, 0, sizeof(mmu_scratch_pgtab2));
+	KASSERT(mmu_page_mappings(UBASE_PHYS, vaddrs, TEST_MMU_MAPPINGS_MAX) == nmappings);
+}
+
+#ifndef __unix64__
+
+/*----------------------------------------------------------------------------*
+ * Page Walk                                                                  *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Page Walk
+ *
+ * Only mappings of the root page directory are looked up, so a
+ * mapping in a scratch page table is not found.
+ */
+PRIVATE void mmu_page_lookup(void)
+{
+	KASSERT(mmu_page_walk(KBASE_PHYS + 4) == (void *)(KBASE_VIRT + 4));
+
+	kmemset(mmu_scratch_pgtab, 0, sizeof(mmu_scratch_pgtab));
+	KASSERT(mmu_page_map(mmu_scratch_pgtab, KBASE_PHYS, UBASE_VIRT, 1, 0) == 0);
+	KASSERT(mmu_page_walk(KBASE_PHYS + 4) == (void *)(KBASE_VIRT + 4));
+	KASSERT(mmu_page_unmap(mmu_scratch_pgtab, UBASE_VIRT) == 0);
+}
+
+#endif
+
+#if (CORE_HAS_HUGE_PAGES)
+
+/*----------------------------------------------------------------------------*
+ * Map and Unmap a Huge Page                                                  *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Map and Unmap a Huge Page
+ *
+ * The scratch page table stands in for a page directory, and only
+ * its second entry is used.
+ */
+PRIVATE void mmu_huge_map_unmap(void)
+{
+	struct pde *pde;
+
+	kmemset(mmu_scratch_pgtab, 0, sizeof(mmu_scratch_pgtab));
+
+	KASSERT(mmu_huge_page_map(mmu_scratch_pgtab, PGTAB_SIZE, PGTAB_SIZE, 1, 0) == 0);
+	KASSERT((pde = pde_get((struct pde *) mmu_scratch_pgtab, PGTAB_SIZE)) != NULL);
+	KASSERT(pde_is_huge(pde));
+	KASSERT(pde_frame_get(pde) == (PGTAB_SIZE >> PAGE_SHIFT));
+
+	KASSERT(mmu_huge_page_unmap(mmu_scratch_pgtab, PGTAB_SIZE) == 0);
+	KASSERT(!pde_is_huge(pde));
+	KASSERT(mmu_huge_page_unmap(mmu_scratch_pgtab, PGTAB_SIZE) == -EINVAL);
+}
+
+/*----------------------------------------------------------------------------*
+ * Map and Unmap a Range With a Huge Page                                     *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Map and Unmap a Range With a Huge Page
+ *
+ * The range spans a whole page table that is not in place, so it is
+ * mapped with a huge page, which cannot be unmapped in part.
+ */
+PRIVATE void mmu_huge_range(void)
+{
+	struct pde *pde;
+	vaddr_t vaddr = TEST_MMU_PGTAB_BOUNDARY + PGTAB_SIZE;
+	paddr_t paddr = UBASE_PHYS & PGTAB_MASK;
+
+	mmu_scratch_setup();
+
+	KASSERT(mmu_map_range(mmu_scratch_pgdir, paddr, vaddr, PGTAB_SIZE >> PAGE_SHIFT, 1, 0) == 0);
+	KASSERT((pde = pde_get(mmu_scratch_pgdir, vaddr)) != NULL);
+	KASSERT(pde_is_huge(pde));
+	KASSERT(pde_frame_get(pde) == (paddr >> PAGE_SHIFT));
+
+	KASSERT(mmu_unmap_range(mmu_scratch_pgdir, vaddr, 1) == -EFAULT);
+	KASSERT(pde_is_huge(pde));
+
+	KASSERT(mmu_unmap_range(mmu_scratch_pgdir, vaddr, PGTAB_SIZE >> PAGE_SHIFT) == 0);
+	KASSERT(!pde_is_huge(pde));
+}
+
+/*----------------------------------------------------------------------------*
+ * Invalid Map Huge Page                                                      *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Invalid Map Huge Page
+ */
+PRIVATE void mmu_huge_page_map_inval(void)
+{
+	KASSERT(mmu_huge_page_map(NULL, PGTAB_SIZE, PGTAB_SIZE, 1, 0) == -EINVAL);
+	KASSERT(mmu_huge_page_map(mmu_scratch_pgtab, PAGE_SIZE, PGTAB_SIZE, 1, 0) == -EINVAL);
+	KASSERT(mmu_huge_page_map(mmu_scratch_pgtab, PGTAB_SIZE, PAGE_SIZE, 1, 0) == -EINVAL);
+	KASSERT(mmu_huge_page_unmap(NULL, PGTAB_SIZE) == -EINVAL);
+	KASSERT(!pde_is_huge(NULL));
+}
+
+#endif
+
+/*----------------------------------------------------------------------------*
+ * Invalid Map and Unmap Range                                                *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Invalid Map and Unmap Range
+ */
+PRIVATE void mmu_map_range_inval(void)
+{
+	KASSERT(mmu_map_range(NULL, KBASE_PHYS, KBASE_VIRT, 1, 1, 1) == -EINVAL);
+	KASSERT(mmu_map_range(root_pgdir, KBASE_PHYS, KBASE_VIRT, 0, 1, 1) == -EINVAL);
+	KASSERT(mmu_map_range(root_pgdir, KBASE_PHYS + 1, KBASE_VIRT, 1, 1, 1) == -EINVAL);
+	KASSERT(mmu_map_range(root_pgdir, KBASE_PHYS, KBASE_VIRT + 1, 1, 1, 1) == -EINVAL);
+	KASSERT(mmu_unmap_range(NULL, KBASE_VIRT, 1) == -EINVAL);
+	KASSERT(mmu_unmap_range(root_pgdir, KBASE_VIRT, 0) == -EINVAL);
+	KASSERT(mmu_unmap_range(root_pgdir, KBASE_VIRT + 1, 1) == -EINVAL);
+}
+
+/*----------------------------------------------------------------------------*
+ * Map and Unmap a Range Without Page Tables                                  *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Fault Test: Map and Unmap a Range Without Page Tables
+ *
+ * The second scratch page table is dropped, so the range runs into
+ * a page table that is not in place, and no page is mapped.
+ */
+PRIVATE void mmu_range_fault(void)
+{
+	vaddr_t vaddr = TEST_MMU_PGTAB_BOUNDARY - 2*PAGE_SIZE;
+
+	mmu_scratch_setup();
+	pde_clear(pde_get(mmu_scratch_pgdir, TEST_MMU_PGTAB_BOUNDARY));
+
+	KASSERT(mmu_map_range(mmu_scratch_pgdir, UBASE_PHYS, vaddr, 4, 1, 0) == -EFAULT);
+	KASSERT(!pte_is_present(pte_get(mmu_scratch_pgtab, vaddr)));
+	KASSERT(!pte_is_present(pte_get(mmu_scratch_pgtab, vaddr + PAGE_SIZE)));
+	KASSERT(mmu_unmap_range(mmu_scratch_pgdir, vaddr, 4) == -EFAULT);
+}
+
+/*----------------------------------------------------------------------------*
+ * Invalid Unmap Page                                                         *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Invalid Unmap Page
+ */
+PRIVATE void mmu_page_unmap_inval(void)
+{
+	KASSERT(mmu_page_unmap(NULL, KBASE_VIRT) == -EINVAL);
+}
+
+/*----------------------------------------------------------------------------*
+ * Invalid Enumerate Mappings                                                 *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Invalid Enumerate Mappings
+ */
+PRIVATE void mmu_page_mappings_inval(void)
+{
+	vaddr_t vaddr;
+
+	KASSERT(mmu_page_mappings(KBASE_PHYS, NULL, 1) == -EINVAL);
+	KASSERT(mmu_page_mappings(KBASE_PHYS, &vaddr, -1) == -EINVAL);
+}
+
 /*============================================================================*
  * Test Driver                                                                *
  *============================================================================*/
@@ -467,6 +816,17 @@ PRIVATE struct test mmu_api_tests[] = {
 	{ mmu_pde_write_set,   "pde write set  " },
 	{ mmu_pte_get,         "pte get        " },
 	{ mmu_pde_get,         "pde get        " },
+	{ mmu_page_map_unmap,  "map/unmap page " },
+	{ mmu_page_map_range,  "map page range " },
+	{ mmu_range_cross,     "map cross range" },
+	{ mmu_page_enum,       "enum mappings  " },
+#ifndef __unix64__
+	{ mmu_page_lookup,     "page walk      " },
+#endif
+#if (CORE_HAS_HUGE_PAGES)
+	{ mmu_huge_map_unmap,  "map huge page  " },
+	{ mmu_huge_range,      "map huge range " },
+#endif
 	{ NULL,                 NULL             },
 };
 
@@ -488,6 +848,13 @@ PRIVATE struct test mmu_fault_tests[] = {
 	{ mmu_pde_write_set_inval,   "set write bit in invalid pde  " },
 	{ mmu_pte_get_inval,         "get invalid pte               " },
 	{ mmu_pde_get_inval,         "get invalid pde               " },
+	{ mmu_page_unmap_inval,      "unmap page in invalid pgtab   " },
+	{ mmu_page_mappings_inval,   "enumerate into invalid buffer " },
+	{ mmu_map_range_inval,       "map/unmap invalid page range  " },
+	{ mmu_range_fault,           "map/unmap range without pgtab " },
+#if (CORE_HAS_HUGE_PAGES)
+	{ mmu_huge_page_map_inval,   "map/unmap invalid huge page   " },
+#endif
 	{ NULL, NULL },
 };
 
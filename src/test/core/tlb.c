@@ -139,6 +139,43 @@ PRIVATE void test_tlb_invalidate(void)
 	KASSERT(tlb_lookup_vaddr(TLB_DATA, vaddr) == NULL);
 }
 
+/*----------------------------------------------------------------------------*
+ * Invalidate a Range of the TLB                                              *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Invalidate a Range of the TLB
+ */
+PRIVATE void test_tlb_invalidate_range(void)
+{
+	vaddr_t vaddr;
+	paddr_t paddr;
+
+	vaddr = TRUNCATE(VADDR(UBASE_VIRT) + PAGE_SIZE, PAGE_SIZE);
+	paddr = TRUNCATE(PADDR(UBASE_PHYS) + PAGE_SIZE, PAGE_SIZE);
+
+#if (TEST_TLB_VERBOSE)
+	kprintf("tlb_inval_range() vaddr = %x", vaddr);
+#endif
+
+	/* Write TLB entries. */
+	for (int i = 0; i < 2; i++)
+	{
+		KASSERT(tlb_write(TLB_DATA, vaddr + i*PAGE_SIZE, paddr + i*PAGE_SIZE) == 0);
+		KASSERT(tlb_lookup_vaddr(TLB_DATA, vaddr + i*PAGE_SIZE) != NULL);
+		KASSERT(tlb_lookup_paddr(TLB_DATA, paddr + i*PAGE_SIZE) != NULL);
+	}
+	KASSERT(tlb_flush() == 0);
+
+	/* Invalidate TLB entries. */
+	KASSERT(tlb_inval_range(TLB_DATA, vaddr, 2*PAGE_SIZE) == 0);
+	KASSERT(tlb_flush() == 0);
+
+	/* These entries should no longer exist. */
+	for (int i = 0; i < 2; i++)
+		KASSERT(tlb_lookup_vaddr(TLB_DATA, vaddr + i*PAGE_SIZE) == NULL);
+}
+
 /*----------------------------------------------------------------------------*
  * Write an Entry to the TLB (destructive)                                    *
  *----------------------------------------------------------------------------*/
@@ -320,6 +357,324 @@ PRIVATE void test_tlb_invalidate_inval(void)
 	 */
 }
 
+/*----------------------------------------------------------------------------*
+ * Invalidate an Invalid Range of the TLB                                     *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Fault Injection Test: Invalidate an Invalid Range of the TLB
+ */
+PRIVATE void test_tlb_invalidate_range_inval(void)
+{
+	vaddr_t vaddr;
+
+	vaddr = TRUNCATE(VADDR(UBASE_VIRT) + PAGE_SIZE, PAGE_SIZE);
+
+	KASSERT(tlb_inval_range(-1, vaddr, PAGE_SIZE) == -EINVAL);
+	KASSERT(tlb_inval_range(TLB_DATA, vaddr, 0) == -EINVAL);
+	KASSERT(tlb_inval_range(TLB_DATA, vaddr, -vaddr + 1) == -EINVAL);
+}
+
+#ifdef __unix64__
+
+/*============================================================================*
+ * Emulated TLB Tests                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Asserts whether the MMU is emulated.
+ *
+ * @param tlb_length Store location for the number of entries in the
+ *                   TLB.
+ * @param tlb_policy Store location for the TLB replacement policy.
+ */
+PRIVATE bool test_tlb_emulated(int *tlb_length, int *tlb_policy)
+{
+	int mode;
+
+	KASSERT(linux64_cluster_mmu_get(&mode, tlb_length, tlb_policy) == 0);
+
+	return (mode == LINUX64_CLUSTER_MMU_EMULATED);
+}
+
+/**
+ * @brief Gets the TLB statistics of the underlying core.
+ *
+ * @param stats Store location for the statistics.
+ */
+PRIVATE void test_tlb_stats(struct linux64_cluster_tlb_stats *stats)
+{
+	KASSERT(linux64_cluster_tlb_stats_get(core_get_id(), stats) == 0);
+}
+
+/**
+ * @brief Reads a kernel page.
+ *
+ * @param i Number of the target page.
+ */
+PRIVATE void test_tlb_touch(int i)
+{
+	UNUSED(*((volatile char *)(KBASE_VIRT + i*PAGE_SIZE)));
+}
+
+/**
+ * @name Page Fault State
+ */
+/**@{*/
+PRIVATE volatile vaddr_t test_tlb_fault_addr = 0;  /**< Faulting address.       */
+PRIVATE volatile int test_tlb_fault_writable = 0;  /**< Map the page writable?  */
+/**@}*/
+
+/**
+ * @brief Page fault handler.
+ *
+ * The huge page that contains the faulting address is mapped in the
+ * root page directory. Otherwise, the faulting access would fault
+ * again when retried.
+ */
+PRIVATE void test_tlb_fault_handler(
+	const struct exception *excp,
+	const struct context *ctx
+)
+{
+	vaddr_t vaddr;
+
+	UNUSED(ctx);
+
+	test_tlb_fault_addr = exception_get_addr(excp);
+	vaddr = test_tlb_fault_addr & PGTAB_MASK;
+
+	KASSERT(mmu_map_range(root_pgdir, vaddr, vaddr, PGTAB_SIZE >> PAGE_SHIFT, test_tlb_fault_writable, 0) == 0);
+}
+
+/*----------------------------------------------------------------------------*
+ * Flush the Emulated TLB                                                     *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Flush the Emulated TLB
+ */
+PRIVATE void test_tlb_emulated_flush(void)
+{
+	int tlb_length;
+	int tlb_policy;
+	struct linux64_cluster_tlb_stats stats0;
+	struct linux64_cluster_tlb_stats stats1;
+
+	/* Test not applicable. */
+	if (!test_tlb_emulated(&tlb_length, &tlb_policy))
+		return;
+
+	KASSERT(tlb_flush() == 0);
+	test_tlb_stats(&stats0);
+
+	/* Miss once. */
+	test_tlb_touch(1);
+	test_tlb_touch(1);
+	test_tlb_stats(&stats1);
+	KASSERT(stats1.misses == (stats0.misses + 1));
+
+	/* Miss again. */
+	KASSERT(tlb_flush() == 0);
+	test_tlb_touch(1);
+	test_tlb_stats(&stats1);
+	KASSERT(stats1.flushes == (stats0.flushes + 1));
+	KASSERT(stats1.misses == (stats0.misses + 2));
+}
+
+/*----------------------------------------------------------------------------*
+ * Evict Entries of the Emulated TLB                                          *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Evict Entries of the Emulated TLB
+ *
+ * Two pages more than fit in the TLB are read, so two entries are
+ * evicted. With FIFO replacement, these are the entries of the first
+ * two pages.
+ */
+PRIVATE void test_tlb_emulated_evict(void)
+{
+	int tlb_length;
+	int tlb_policy;
+	struct linux64_cluster_tlb_stats stats0;
+	struct linux64_cluster_tlb_stats stats1;
+
+	/* Test not applicable. */
+	if (!test_tlb_emulated(&tlb_length, &tlb_policy))
+		return;
+	if ((size_t)(tlb_length + 2) > (kmem_size/PAGE_SIZE))
+		return;
+
+	KASSERT(tlb_flush() == 0);
+	test_tlb_stats(&stats0);
+
+	for (int i = 0; i < (tlb_length + 2); i++)
+		test_tlb_touch(i);
+
+	test_tlb_stats(&stats1);
+	KASSERT(stats1.misses == (stats0.misses + tlb_length + 2));
+	KASSERT(stats1.evictions == (stats0.evictions + 2));
+
+	if (tlb_policy == LINUX64_CLUSTER_TLB_FIFO)
+	{
+		test_tlb_touch(2);
+		test_tlb_stats(&stats0);
+		KASSERT(stats0.misses == stats1.misses);
+
+		test_tlb_touch(0);
+		test_tlb_stats(&stats0);
+		KASSERT(stats0.misses == (stats1.misses + 1));
+		KASSERT(stats0.evictions == (stats1.evictions + 1));
+	}
+}
+
+/*----------------------------------------------------------------------------*
+ * Handle Faults in the Emulated MMU                                          *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Handle Faults in the Emulated MMU
+ *
+ * A huge page of user memory, which is not mapped, is first read and
+ * then written. The read raises a page fault, and the handler maps
+ * the page read-only. The write then raises a protection fault, and
+ * the handler maps the page writable.
+ */
+PRIVATE void test_tlb_emulated_fault(void)
+{
+	int tlb_length;
+	int tlb_policy;
+	volatile char *p;
+	struct linux64_cluster_tlb_stats stats0;
+	struct linux64_cluster_tlb_stats stats1;
+
+	/* Test not applicable. */
+	if (!test_tlb_emulated(&tlb_length, &tlb_policy))
+		return;
+
+	p = (volatile char *)(((UBASE_VIRT + PGTAB_SIZE - 1) & PGTAB_MASK) + PAGE_SIZE + 1);
+	KASSERT((vaddr_t)(p + PGTAB_SIZE) < UEND_VIRT);
+
+	KASSERT(exception_register(EXCEPTION_PAGE_FAULT, test_tlb_fault_handler) == 0);
+	test_tlb_stats(&stats0);
+
+		/* Page fault. */
+		test_tlb_fault_addr = 0;
+		test_tlb_fault_writable = 0;
+		UNUSED(*p);
+		test_tlb_stats(&stats1);
+		KASSERT(test_tlb_fault_addr == (vaddr_t) p);
+		KASSERT(stats1.page_faults == (stats0.page_faults + 1));
+		KASSERT(stats1.protection_faults == stats0.protection_faults);
+
+		/* Protection fault. */
+		test_tlb_fault_addr = 0;
+		test_tlb_fault_writable = 1;
+		*p = 1;
+		test_tlb_stats(&stats1);
+		KASSERT(test_tlb_fault_addr == (vaddr_t) p);
+		KASSERT(stats1.page_faults == (stats0.page_faults + 1));
+		KASSERT(stats1.protection_faults == (stats0.protection_faults + 1));
+		KASSERT(*p == 1);
+
+	KASSERT(exception_unregister(EXCEPTION_PAGE_FAULT) == 0);
+	KASSERT(mmu_unmap_range(root_pgdir, ((vaddr_t) p) & PGTAB_MASK, PGTAB_SIZE >> PAGE_SHIFT) == 0);
+}
+
+/*----------------------------------------------------------------------------*
+ * Query TLB Statistics                                                       *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Query TLB Statistics
+ */
+PRIVATE void test_tlb_emulated_stats(void)
+{
+	struct linux64_cluster_tlb_stats stats0;
+	struct linux64_cluster_tlb_stats stats1;
+
+	test_tlb_stats(&stats0);
+	KASSERT(tlb_flush() == 0);
+	test_tlb_stats(&stats1);
+
+	KASSERT(stats1.flushes == (stats0.flushes + 1));
+}
+
+/*----------------------------------------------------------------------------*
+ * Query TLB Statistics of an Invalid Core                                    *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Fault Injection Test: Query TLB Statistics of an Invalid Core
+ */
+PRIVATE void test_tlb_emulated_stats_inval(void)
+{
+	struct linux64_cluster_tlb_stats stats;
+
+	KASSERT(linux64_cluster_tlb_stats_get(-1, &stats) == -EINVAL);
+	KASSERT(linux64_cluster_tlb_stats_get(LINUX64_CLUSTER_NUM_CORES_MAX, &stats) == -EINVAL);
+}
+
+/*----------------------------------------------------------------------------*
+ * Query TLB Statistics into a Bad Buffer                                     *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Fault Injection Test: Query TLB Statistics into a Bad Buffer
+ */
+PRIVATE void test_tlb_emulated_stats_bad(void)
+{
+	int mode;
+
+	KASSERT(linux64_cluster_tlb_stats_get(core_get_id(), NULL) == -EINVAL);
+	KASSERT(linux64_cluster_mmu_get(&mode, NULL, &mode) == -EINVAL);
+}
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test tlb_emulated_api_tests[] = {
+	{ test_tlb_emulated_stats, "query statistics " },
+	{ test_tlb_emulated_flush, "flush            " },
+	{ test_tlb_emulated_evict, "evict entries    " },
+	{ test_tlb_emulated_fault, "handle faults    " },
+	{ NULL,                     NULL               },
+};
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test tlb_emulated_fault_tests[] = {
+	{ test_tlb_emulated_stats_inval, "query statistics of invalid core" },
+	{ test_tlb_emulated_stats_bad,   "query statistics into bad buffer" },
+	{ NULL,                           NULL                              },
+};
+
+/**
+ * @brief Launches testing units on the emulated TLB.
+ */
+PRIVATE void test_unix64_tlb_emulated(void)
+{
+	/* API Tests */
+	CLUSTER_KPRINTF(HLINE);
+	for (int i = 0; tlb_emulated_api_tests[i].test_fn != NULL; i++)
+	{
+		tlb_emulated_api_tests[i].test_fn();
+		CLUSTER_KPRINTF("[test][api][tlb] %s [passed]", tlb_emulated_api_tests[i].name);
+	}
+
+	/* Fault Tests */
+	CLUSTER_KPRINTF(HLINE);
+	for (int i = 0; tlb_emulated_fault_tests[i].test_fn != NULL; i++)
+	{
+		tlb_emulated_fault_tests[i].test_fn();
+		CLUSTER_KPRINTF("[test][fault][tlb] %s [passed]", tlb_emulated_fault_tests[i].name);
+	}
+}
+
+#endif /* __unix64__ */
+
 /*============================================================================*
  * Test Driver                                                                *
  *============================================================================*/
@@ -332,6 +687,7 @@ PRIVATE struct test tlb_api_tests[] = {
 	{ test_tlb_lookup_paddr,      "lookup physical address" },
 	{ test_tlb_write,             "write                  " },
 	{ test_tlb_invalidate,        "invalidate             " },
+	{ test_tlb_invalidate_range,  "invalidate range       " },
 	{ test_tlb_write_destructive, "write destructive      " },
 	{ NULL,                        NULL                     },
 };
@@ -346,6 +702,7 @@ PRIVATE struct test tlb_fault_tests[] = {
 	{ test_tlb_lookup_paddr_bad,            "lookup bad physical address    " },
 	{ test_tlb_write_inval,                 "write invalid entry            " },
 	{ test_tlb_invalidate_inval,            "invalidate invalid entry       " },
+	{ test_tlb_invalidate_range_inval,      "invalidate invalid range       " },
 	{ NULL,                                  NULL                             },
 };
 
@@ -370,6 +727,10 @@ PRIVATE void test_unix64_tlb_init()
  */
 PUBLIC void test_tlb(void)
 {
+#ifdef __unix64__
+	test_unix64_tlb_emulated();
+#endif
+
 	/* Test not applicable. */
 #if (CORE_HAS_TLB_HW)
 		return;
@@ -76,6 +76,12 @@ PRIVATE void test_cluster_al(void)
 {
 #if (CLUSTER_IS_MULTICORE)
 	test_cluster_cores();
+#endif
+	test_cluster_slab();
+	test_cluster_frames();
+	test_cluster_memory();
+#ifdef __unix64__
+	test_timer();
 #endif
 }
 
@@ -108,11 +114,15 @@ PRIVATE void test_target_al(void)
 
 #if (__TARGET_HAS_MAILBOX)
 	test_mailbox();
+	test_rpc();
 #endif
 
 #if (__TARGET_HAS_PORTAL)
 	test_portal();
+	test_collective();
 #endif
+
+	test_barrier();
 }
 
 #ifndef __unix64__
@@ -49,6 +49,8 @@ PRIVATE void do_test_stress_al(void)
 
 	test_stress_cleanup();
 
+	test_stress_target();
+
 	vsys_exit();
 	fence_join(&stress_fence);
 
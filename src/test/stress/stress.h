@@ -53,4 +53,9 @@
 	 */
 	EXTERN void test_stress_combination(void);
 
+	/**
+	 * @brief Stress test driver for the target services
+	 */
+	EXTERN void test_stress_target(void);
+
 #endif /* _STRESS_H_ */
@@ -0,0 +1,680 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/hal/hal.h>
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+#include "../test.h"
+#include "stress.h"
+
+#if (__TARGET_HAS_SYNC && __TARGET_HAS_MAILBOX && __TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+/**
+ * @brief Number of rounds.
+ */
+#define NROUNDS 10
+
+/**
+ * @brief Rendezvous barrier.
+ *
+ * The slave node leads this barrier, thus its synchronization points
+ * never clash with the ones of barriers led by the master node.
+ */
+PRIVATE int rendezvous = -1;
+
+/*============================================================================*
+ * Auxiliar Function                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Synchronizes the master and slave nodes.
+ */
+PRIVATE void stress_target_rendezvous(void)
+{
+	KASSERT(barrier_wait(rendezvous) == 0);
+}
+
+/*============================================================================*
+ * Barrier                                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Stress Test: Barrier Create Destroy
+ */
+PRIVATE void stress_barrier_create_destroy(void)
+{
+	int barrierid;
+	int nodes[2];
+
+	nodes[0] = NODENUM_MASTER;
+	nodes[1] = NODENUM_SLAVE;
+
+	for (unsigned int i = 0; i < NROUNDS; ++i)
+	{
+		KASSERT((barrierid = barrier_create(nodes, 2, 1)) >= 0);
+		KASSERT(barrier_destroy(barrierid) == 0);
+	}
+}
+
+/**
+ * @brief Stress Test: Barrier Wait
+ */
+PRIVATE void stress_barrier_wait(void)
+{
+	int barrierid;
+	int nodes[2];
+
+	nodes[0] = NODENUM_MASTER;
+	nodes[1] = NODENUM_SLAVE;
+
+	KASSERT((barrierid = barrier_create(nodes, 2, 1)) >= 0);
+
+		for (unsigned int i = 0; i < NROUNDS; ++i)
+			KASSERT(barrier_wait(barrierid) == 0);
+
+	KASSERT(barrier_destroy(barrierid) == 0);
+}
+
+/*============================================================================*
+ * Sync                                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Stress Test: Sync Signal Wait
+ */
+PRIVATE void stress_sync_signal_wait(void)
+{
+	int ret;
+	int syncin;
+	int syncout;
+	int nodes[2];
+	bool master;
+
+	nodes[0] = NODENUM_MASTER;
+	nodes[1] = NODENUM_SLAVE;
+	master   = (processor_node_get_num() == NODENUM_MASTER);
+
+	/* Slave to master: all-to-one. Master to slave: one-to-all. */
+	if (master)
+	{
+		KASSERT((syncin = sync_create(nodes, 2, SYNC_ALL_TO_ONE)) >= 0);
+		KASSERT((syncout = sync_open(nodes, 2, SYNC_ONE_TO_ALL)) >= 0);
+	}
+	else
+	{
+		KASSERT((syncin = sync_create(nodes, 2, SYNC_ONE_TO_ALL)) >= 0);
+		KASSERT((syncout = sync_open(nodes, 2, SYNC_ALL_TO_ONE)) >= 0);
+	}
+
+	stress_target_rendezvous();
+
+		for (unsigned int i = 0; i < NROUNDS; ++i)
+		{
+			if (master)
+				KASSERT(sync_wait(syncin) == 0);
+
+			do
+				ret = sync_signal(syncout);
+			while (ret == (-EAGAIN));
+			KASSERT(ret == 0);
+
+			if (!master)
+				KASSERT(sync_wait(syncin) == 0);
+		}
+
+	stress_target_rendezvous();
+
+	KASSERT(sync_close(syncout) == 0);
+	KASSERT(sync_unlink(syncin) == 0);
+}
+
+/**
+ * @brief Stress Test: Sync Orphaned Signals
+ *
+ * The slave node signals more synchronization points than there
+ * are signal counters, none of which the master node creates.
+ * Afterwards, a regular synchronization point should still work.
+ */
+PRIVATE void stress_sync_orphans(void)
+{
+	int ret;
+	int syncid;
+	int nnodes;
+	int nodes[PROCESSOR_NOC_NODES_NUM];
+
+	nodes[0] = NODENUM_MASTER;
+	nodes[1] = NODENUM_SLAVE;
+
+	if (processor_node_get_num() == NODENUM_SLAVE)
+	{
+		/* Each subset of the other nodes gives a distinct sync. */
+		for (unsigned int i = 1; i <= (2*SYNC_CREATE_MAX + 1); ++i)
+		{
+			nnodes = 2;
+			for (int j = 2; j < PROCESSOR_NOC_NODES_NUM; ++j)
+			{
+				if (i & (1 << (j - 2)))
+					nodes[nnodes++] = j;
+			}
+
+			KASSERT((syncid = sync_open(nodes, nnodes, SYNC_ALL_TO_ONE)) >= 0);
+			KASSERT(sync_signal(syncid) == 0);
+			KASSERT(sync_close(syncid) == 0);
+		}
+	}
+
+	stress_target_rendezvous();
+
+	if (processor_node_get_num() == NODENUM_MASTER)
+	{
+		KASSERT((syncid = sync_create(nodes, 2, SYNC_ALL_TO_ONE)) >= 0);
+
+		stress_target_rendezvous();
+
+		KASSERT(sync_wait(syncid) == 0);
+		KASSERT(sync_unlink(syncid) == 0);
+	}
+	else
+	{
+		KASSERT((syncid = sync_open(nodes, 2, SYNC_ALL_TO_ONE)) >= 0);
+
+		stress_target_rendezvous();
+
+		do
+			ret = sync_signal(syncid);
+		while (ret == (-EAGAIN));
+		KASSERT(ret == 0);
+
+		KASSERT(sync_close(syncid) == 0);
+	}
+}
+
+/**
+ * @brief Stress Test: Sync Counting Signals
+ */
+PRIVATE void stress_sync_counting(void)
+{
+#ifdef __sync_npending_fn
+	int ret;
+	int syncid;
+	int nodes[2];
+
+	nodes[0] = NODENUM_MASTER;
+	nodes[1] = NODENUM_SLAVE;
+
+	if (processor_node_get_num() == NODENUM_MASTER)
+	{
+		KASSERT((syncid = sync_create(nodes, 2, SYNC_ALL_TO_ONE)) >= 0);
+		KASSERT(sync_ioctl(syncid, SYNC_IOCTL_SET_COUNTING_MODE, 1) == 0);
+
+		/* Slave signals in between. */
+		stress_target_rendezvous();
+		stress_target_rendezvous();
+
+		KASSERT(sync_npending(syncid) == NROUNDS);
+		KASSERT(sync_wait_n(syncid, NROUNDS - 1) == 0);
+		KASSERT(sync_npending(syncid) == 1);
+		KASSERT(sync_wait(syncid) == 0);
+		KASSERT(sync_npending(syncid) == 0);
+
+		KASSERT(sync_unlink(syncid) == 0);
+	}
+	else
+	{
+		KASSERT((syncid = sync_open(nodes, 2, SYNC_ALL_TO_ONE)) >= 0);
+
+		stress_target_rendezvous();
+
+			for (unsigned int i = 0; i < NROUNDS; ++i)
+			{
+				do
+					ret = sync_signal(syncid);
+				while (ret == (-EAGAIN));
+				KASSERT(ret == 0);
+			}
+
+		stress_target_rendezvous();
+
+		KASSERT(sync_close(syncid) == 0);
+	}
+#endif
+}
+
+/*============================================================================*
+ * Collective                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Number of elements in a collective block.
+ *
+ * Blocks span several segments, so that segmentation is exercised.
+ */
+#define COLLECTIVE_NELEMS ((2*HAL_COLLECTIVE_SEGMENT_SIZE)/sizeof(int) + 3)
+
+/**
+ * @name Collective buffers.
+ */
+/**@{*/
+PRIVATE int collective_sendbuf[2*COLLECTIVE_NELEMS];
+PRIVATE int collective_recvbuf[2*COLLECTIVE_NELEMS];
+/**@}*/
+
+/**
+ * @brief Adds integers.
+ */
+PRIVATE void collective_sum(void *inout, const void *in, size_t nelems)
+{
+	for (size_t i = 0; i < nelems; i++)
+		((int *) inout)[i] += ((const int *) in)[i];
+}
+
+/**
+ * @brief Creates a collective that spans the master and slave nodes.
+ */
+PRIVATE int stress_collective_create(void)
+{
+	int collid;
+	int nodes[2];
+
+	nodes[0] = NODENUM_MASTER;
+	nodes[1] = NODENUM_SLAVE;
+
+	KASSERT((collid = collective_create(nodes, 2)) >= 0);
+
+	return (collid);
+}
+
+/**
+ * @brief Stress Test: Collective Broadcast
+ */
+PRIVATE void stress_collective_broadcast(void)
+{
+	int rank;
+	int collid;
+	int *buffer;
+
+	rank   = (processor_node_get_num() == NODENUM_MASTER) ? 0 : 1;
+	buffer = collective_sendbuf;
+	collid = stress_collective_create();
+
+	for (unsigned int i = 0; i < NROUNDS; ++i)
+	{
+		int root = i % 2;
+
+		for (unsigned int j = 0; j < COLLECTIVE_NELEMS; j++)
+			buffer[j] = (rank == root) ? (int) (i + j) : -1;
+
+		/* Tree and ring broadcasts take turns. */
+		if (i & 2)
+			KASSERT(collective_broadcast_pipelined(collid, root, buffer, COLLECTIVE_NELEMS*sizeof(int)) == 0);
+		else
+			KASSERT(collective_broadcast(collid, root, buffer, COLLECTIVE_NELEMS*sizeof(int)) == 0);
+
+		for (unsigned int j = 0; j < COLLECTIVE_NELEMS; j++)
+			KASSERT(buffer[j] == (int) (i + j));
+	}
+
+	KASSERT(collective_destroy(collid) == 0);
+}
+
+/**
+ * @brief Stress Test: Collective Scatter Gather
+ */
+PRIVATE void stress_collective_scatter_gather(void)
+{
+	int rank;
+	int collid;
+
+	rank   = (processor_node_get_num() == NODENUM_MASTER) ? 0 : 1;
+	collid = stress_collective_create();
+
+	for (unsigned int i = 0; i < NROUNDS; ++i)
+	{
+		int root = i % 2;
+
+		for (unsigned int j = 0; j < 2*COLLECTIVE_NELEMS; j++)
+		{
+			collective_sendbuf[j] = (rank == root) ? (int) (i + j) : -1;
+			collective_recvbuf[j] = -1;
+		}
+
+		KASSERT(collective_scatter(collid, root, collective_sendbuf, collective_recvbuf, COLLECTIVE_NELEMS*sizeof(int)) == 0);
+		for (unsigned int j = 0; j < COLLECTIVE_NELEMS; j++)
+			KASSERT(collective_recvbuf[j] == (int) (i + rank*COLLECTIVE_NELEMS + j));
+
+		kmemset(collective_sendbuf, 0, sizeof(collective_sendbuf));
+
+		KASSERT(collective_gather(collid, root, collective_recvbuf, collective_sendbuf, COLLECTIVE_NELEMS*sizeof(int)) == 0);
+		if (rank == root)
+		{
+			for (unsigned int j = 0; j < 2*COLLECTIVE_NELEMS; j++)
+				KASSERT(collective_sendbuf[j] == (int) (i + j));
+		}
+	}
+
+	KASSERT(collective_destroy(collid) == 0);
+}
+
+/**
+ * @brief Stress Test: Collective Reduce
+ */
+PRIVATE void stress_collective_reduce(void)
+{
+	int rank;
+	int collid;
+
+	rank   = (processor_node_get_num() == NODENUM_MASTER) ? 0 : 1;
+	collid = stress_collective_create();
+
+	for (unsigned int j = 0; j < COLLECTIVE_NELEMS; j++)
+		collective_sendbuf[j] = j + rank;
+
+	for (unsigned int i = 0; i < NROUNDS; ++i)
+	{
+		int root = i % 2;
+
+		KASSERT(collective_reduce(collid, root, collective_sendbuf, collective_recvbuf, COLLECTIVE_NELEMS, sizeof(int), collective_sum) == 0);
+		if (rank == root)
+		{
+			for (unsigned int j = 0; j < COLLECTIVE_NELEMS; j++)
+				KASSERT(collective_recvbuf[j] == (int) (2*j + 1));
+		}
+
+		kmemset(collective_recvbuf, 0, sizeof(collective_recvbuf));
+
+		KASSERT(collective_allreduce(collid, collective_sendbuf, collective_recvbuf, COLLECTIVE_NELEMS, sizeof(int), collective_sum) == 0);
+		for (unsigned int j = 0; j < COLLECTIVE_NELEMS; j++)
+			KASSERT(collective_recvbuf[j] == (int) (2*j + 1));
+	}
+
+	KASSERT(collective_destroy(collid) == 0);
+}
+
+/*============================================================================*
+ * RPC                                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Number of requests in flight.
+ */
+#define RPC_NREQUESTS 8
+
+/**
+ * @brief Serves requests, doubling their argument.
+ *
+ * @param n       Number of requests.
+ * @param reverse Reply in the reverse order of arrival?
+ */
+PRIVATE void stress_rpc_server(int n, bool reverse)
+{
+	int args[RPC_NREQUESTS];
+	struct rpc_request reqs[RPC_NREQUESTS];
+
+	for (int i = 0; i < n; i++)
+	{
+		KASSERT(rpc_serve(&reqs[i], &args[i], sizeof(int)) == 0);
+		KASSERT(reqs[i].size == sizeof(int));
+		KASSERT(reqs[i].opcode == args[i]);
+	}
+
+	for (int i = 0; i < n; i++)
+	{
+		int j = reverse ? (n - i - 1) : i;
+		int ret = 2*args[j];
+
+		KASSERT(rpc_reply(&reqs[j], 0, &ret, sizeof(int)) == 0);
+	}
+}
+
+/**
+ * @brief Issues requests to a remote.
+ *
+ * @param remote  NoC node of the server.
+ * @param handles Handles to the requests.
+ * @param n       Number of requests.
+ */
+PRIVATE void stress_rpc_client(int remote, int *handles, int n)
+{
+	for (int i = 0; i < n; i++)
+		KASSERT((handles[i] = rpc_call(remote, i, &i, sizeof(int))) >= 0);
+}
+
+/**
+ * @brief Gets the index of a request in a set of handles.
+ */
+PRIVATE int stress_rpc_lookup(const int *handles, int n, int handle)
+{
+	for (int i = 0; i < n; i++)
+	{
+		if (handles[i] == handle)
+			return (i);
+	}
+
+	KASSERT(false);
+
+	return (-1);
+}
+
+/**
+ * @brief Stress Test: RPC Call Reply
+ */
+PRIVATE void stress_rpc_call_reply(void)
+{
+	int ret;
+	int handle;
+
+	KASSERT(rpc_setup() == 0);
+
+	stress_target_rendezvous();
+
+		for (int i = 0; i < (int) NROUNDS; i++)
+		{
+			if (processor_node_get_num() == NODENUM_MASTER)
+				stress_rpc_server(1, false);
+			else
+			{
+				KASSERT((handle = rpc_call(NODENUM_MASTER, i, &i, sizeof(int))) >= 0);
+				KASSERT(rpc_wait(handle, &ret, sizeof(int)) == sizeof(int));
+				KASSERT(ret == 2*i);
+			}
+		}
+
+	stress_target_rendezvous();
+
+	KASSERT(rpc_shutdown() == 0);
+}
+
+/**
+ * @brief Stress Test: RPC Wait All
+ */
+PRIVATE void stress_rpc_wait_all(void)
+{
+	int ret;
+	int handles[RPC_NREQUESTS];
+
+	KASSERT(rpc_setup() == 0);
+
+	stress_target_rendezvous();
+
+		if (processor_node_get_num() == NODENUM_MASTER)
+			stress_rpc_server(RPC_NREQUESTS, true);
+		else
+		{
+			stress_rpc_client(NODENUM_MASTER, handles, RPC_NREQUESTS);
+
+			KASSERT(rpc_wait_all(handles, RPC_NREQUESTS) == 0);
+
+			for (int i = 0; i < RPC_NREQUESTS; i++)
+			{
+				KASSERT(rpc_test(handles[i]) == 1);
+				KASSERT(rpc_wait(handles[i], &ret, sizeof(int)) == sizeof(int));
+				KASSERT(ret == 2*i);
+			}
+		}
+
+	stress_target_rendezvous();
+
+	KASSERT(rpc_shutdown() == 0);
+}
+
+/**
+ * @brief Stress Test: RPC Wait Any
+ */
+PRIVATE void stress_rpc_wait_any(void)
+{
+	int ret;
+	int handle;
+	int args[RPC_NREQUESTS];
+	int handles[RPC_NREQUESTS];
+
+	KASSERT(rpc_setup() == 0);
+
+	stress_target_rendezvous();
+
+		if (processor_node_get_num() == NODENUM_MASTER)
+			stress_rpc_server(RPC_NREQUESTS, true);
+		else
+		{
+			stress_rpc_client(NODENUM_MASTER, handles, RPC_NREQUESTS);
+
+			for (int i = 0; i < RPC_NREQUESTS; i++)
+				args[i] = i;
+
+			/* Collect replies, dropping completed requests from the set. */
+			for (int n = RPC_NREQUESTS; n > 0; n--)
+			{
+				int i;
+
+				KASSERT((handle = rpc_wait_any(handles, n)) >= 0);
+				i = stress_rpc_lookup(handles, n, handle);
+
+				KASSERT(rpc_wait(handle, &ret, sizeof(int)) == sizeof(int));
+				KASSERT(ret == 2*args[i]);
+
+				handles[i] = handles[n - 1];
+				args[i]    = args[n - 1];
+			}
+		}
+
+	stress_target_rendezvous();
+
+	KASSERT(rpc_shutdown() == 0);
+}
+
+/**
+ * @brief Stress Test: RPC Cross Calls
+ *
+ * Both nodes issue requests to each other before serving.
+ */
+PRIVATE void stress_rpc_cross_calls(void)
+{
+	int ret;
+	int remote;
+	int handles[RPC_NREQUESTS];
+
+	remote = (processor_node_get_num() == NODENUM_MASTER) ? NODENUM_SLAVE : NODENUM_MASTER;
+
+	KASSERT(rpc_setup() == 0);
+
+	stress_target_rendezvous();
+
+		for (unsigned int k = 0; k < NROUNDS; ++k)
+		{
+			stress_rpc_client(remote, handles, RPC_NREQUESTS);
+			stress_rpc_server(RPC_NREQUESTS, false);
+
+			for (int i = 0; i < RPC_NREQUESTS; i++)
+			{
+				KASSERT(rpc_wait(handles[i], &ret, sizeof(int)) == sizeof(int));
+				KASSERT(ret == 2*i);
+			}
+		}
+
+	stress_target_rendezvous();
+
+	KASSERT(rpc_shutdown() == 0);
+}
+
+/*============================================================================*
+ * Test Driver                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test stress_target_tests[] = {
+	{ stress_barrier_create_destroy,    "barrier create destroy   " },
+	{ stress_barrier_wait,              "barrier wait             " },
+	{ stress_sync_signal_wait,          "sync signal wait         " },
+	{ stress_sync_orphans,              "sync orphaned signals    " },
+	{ stress_sync_counting,             "sync counting            " },
+	{ stress_collective_broadcast,      "collective broadcast     " },
+	{ stress_collective_scatter_gather, "collective scatter gather" },
+	{ stress_collective_reduce,         "collective reduce        " },
+	{ stress_rpc_call_reply,            "rpc call reply           " },
+	{ stress_rpc_wait_all,              "rpc wait all             " },
+	{ stress_rpc_wait_any,              "rpc wait any             " },
+	{ stress_rpc_cross_calls,           "rpc cross calls          " },
+	{ NULL,                             NULL                        },
+};
+
+/**
+ * The test_stress_target() function launches stress testing units on
+ * the services that the HAL builds on top of the target interfaces.
+ *
+ * @note The synchronization points of these services share keys with
+ * the ones of test_stress_setup(), thus this function should be
+ * called after test_stress_cleanup().
+ */
+PUBLIC void test_stress_target(void)
+{
+	int nodes[2];
+
+	test_stress_interrupt_setup();
+
+	nodes[0] = NODENUM_SLAVE;
+	nodes[1] = NODENUM_MASTER;
+	KASSERT((rendezvous = barrier_create(nodes, 2, 1)) >= 0);
+
+	stress_target_rendezvous();
+
+	/* API Tests */
+	CLUSTER_KPRINTF(HLINE);
+	for (int i = 0; stress_target_tests[i].test_fn != NULL; i++)
+	{
+		stress_target_tests[i].test_fn();
+
+		CLUSTER_KPRINTF("[test][stress][target] %s [passed]", stress_target_tests[i].name);
+
+		stress_target_rendezvous();
+	}
+
+	KASSERT(barrier_destroy(rendezvous) == 0);
+	rendezvous = -1;
+
+	test_stress_interrupt_cleanup();
+}
+
+#endif /* __TARGET_HAS_SYNC && __TARGET_HAS_MAILBOX && __TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX */
@@ -0,0 +1,272 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/hal/hal.h>
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+#include "../test.h"
+
+/**
+ * @brief Number of iterations for multicore tests.
+ */
+#define NITERATIONS 10
+
+/*============================================================================*
+ * Slave                                                                      *
+ *============================================================================*/
+
+#if (CLUSTER_IS_MULTICORE)
+
+/**
+ * @brief Barrier used by slave cores.
+ */
+PRIVATE int slave_barrier = -1;
+
+/**
+ * @brief Slave fence.
+ */
+PRIVATE struct fence slave_fence;
+
+/**
+ * @brief Slave.
+ */
+PRIVATE void slave(void)
+{
+	for (int i = 0; i < NITERATIONS; i++)
+		KASSERT(barrier_wait(slave_barrier) == 0);
+
+	fence_join(&slave_fence);
+
+	KASSERT(core_release() == 0);
+	core_reset();
+}
+
+#endif /* CLUSTER_IS_MULTICORE */
+
+/*============================================================================*
+ * API Tests                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Barrier Create Destroy
+ */
+PRIVATE void test_barrier_create_destroy(void)
+{
+	int barrierid;
+	int nodes[1];
+
+	nodes[0] = processor_node_get_num();
+
+	KASSERT((barrierid = barrier_create(nodes, 1, 1)) >= 0);
+	KASSERT(barrier_destroy(barrierid) == 0);
+
+	KASSERT((barrierid = barrier_create(nodes, 1, CORES_NUM)) >= 0);
+	KASSERT(barrier_destroy(barrierid) == 0);
+}
+
+/**
+ * @brief API Test: Barrier Wait with a Single Core
+ */
+PRIVATE void test_barrier_wait(void)
+{
+	int barrierid;
+	int nodes[1];
+
+	nodes[0] = processor_node_get_num();
+
+	KASSERT((barrierid = barrier_create(nodes, 1, 1)) >= 0);
+
+		for (int i = 0; i < NITERATIONS; i++)
+			KASSERT(barrier_wait(barrierid) == 0);
+
+	KASSERT(barrier_destroy(barrierid) == 0);
+}
+
+#if (CLUSTER_IS_MULTICORE)
+
+/**
+ * @brief API Test: Barrier Wait with all Cores
+ */
+PRIVATE void test_barrier_wait_multicore(void)
+{
+	int nodes[1];
+
+	nodes[0] = processor_node_get_num();
+
+	KASSERT((slave_barrier = barrier_create(nodes, 1, CORES_NUM)) >= 0);
+	fence_init(&slave_fence, CORES_NUM - 1);
+
+	/* Start all slave cores. */
+	for (int i = 0; i < CORES_NUM; i++)
+	{
+		if (i != COREID_MASTER)
+		{
+			int ret;
+
+			do
+			{
+				ret = core_start(i, slave);
+				KASSERT((ret == 0) || (ret == -EBUSY));
+			} while (ret != 0);
+		}
+	}
+
+	for (int i = 0; i < NITERATIONS; i++)
+		KASSERT(barrier_wait(slave_barrier) == 0);
+
+	fence_wait(&slave_fence);
+
+	KASSERT(barrier_destroy(slave_barrier) == 0);
+	slave_barrier = -1;
+}
+
+#endif /* CLUSTER_IS_MULTICORE */
+
+/*============================================================================*
+ * Fault Injection Tests                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Fault Injection Test: Barrier Invalid Create
+ */
+PRIVATE void test_barrier_invalid_create(void)
+{
+	int nodes[NODES_AMOUNT];
+
+	nodes[0] = processor_node_get_num();
+	nodes[1] = (nodes[0] == NODENUM_MASTER) ? NODENUM_SLAVE : NODENUM_MASTER;
+
+	KASSERT(barrier_create(NULL, 1, 1) == -EINVAL);
+	KASSERT(barrier_create(nodes, -1, 1) == -EINVAL);
+	KASSERT(barrier_create(nodes, 0, 1) == -EINVAL);
+	KASSERT(barrier_create(nodes, (PROCESSOR_NOC_NODES_NUM + 1), 1) == -EINVAL);
+	KASSERT(barrier_create(nodes, 1, -1) == -EINVAL);
+	KASSERT(barrier_create(nodes, 1, 0) == -EINVAL);
+	KASSERT(barrier_create(nodes, 1, (CORES_NUM + 1)) == -EINVAL);
+
+	/* Local barrier on a remote node. */
+	KASSERT(barrier_create(&nodes[1], 1, 1) == -EINVAL);
+}
+
+/**
+ * @brief Fault Injection Test: Barrier Invalid Destroy
+ */
+PRIVATE void test_barrier_invalid_destroy(void)
+{
+	KASSERT(barrier_destroy(-1) == -EBADF);
+	KASSERT(barrier_destroy(HAL_BARRIER_MAX) == -EBADF);
+	KASSERT(barrier_destroy(1000000) == -EBADF);
+}
+
+/**
+ * @brief Fault Injection Test: Barrier Double Destroy
+ */
+PRIVATE void test_barrier_double_destroy(void)
+{
+	int barrierid;
+	int nodes[1];
+
+	nodes[0] = processor_node_get_num();
+
+	KASSERT((barrierid = barrier_create(nodes, 1, 1)) >= 0);
+	KASSERT(barrier_destroy(barrierid) == 0);
+	KASSERT(barrier_destroy(barrierid) == -EBADF);
+}
+
+/**
+ * @brief Fault Injection Test: Barrier Invalid Wait
+ */
+PRIVATE void test_barrier_invalid_wait(void)
+{
+	KASSERT(barrier_wait(-1) == -EBADF);
+	KASSERT(barrier_wait(HAL_BARRIER_MAX) == -EBADF);
+	KASSERT(barrier_wait(1000000) == -EBADF);
+}
+
+/**
+ * @brief Fault Injection Test: Barrier Bad Wait
+ */
+PRIVATE void test_barrier_bad_wait(void)
+{
+	int barrierid;
+	int nodes[1];
+
+	nodes[0] = processor_node_get_num();
+
+	KASSERT((barrierid = barrier_create(nodes, 1, 1)) >= 0);
+	KASSERT(barrier_destroy(barrierid) == 0);
+	KASSERT(barrier_wait(barrierid) == -EBADF);
+}
+
+/*============================================================================*
+ * Test Driver                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test barrier_tests_api[] = {
+	{ test_barrier_create_destroy, "create destroy" },
+	{ test_barrier_wait,           "wait          " },
+#if (CLUSTER_IS_MULTICORE)
+	{ test_barrier_wait_multicore, "wait multicore" },
+#endif
+	{ NULL,                         NULL            },
+};
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test barrier_tests_fault[] = {
+	{ test_barrier_invalid_create,  "invalid create " },
+	{ test_barrier_invalid_destroy, "invalid destroy" },
+	{ test_barrier_double_destroy,  "double destroy " },
+	{ test_barrier_invalid_wait,    "invalid wait   " },
+	{ test_barrier_bad_wait,        "bad wait       " },
+	{ NULL,                          NULL             },
+};
+
+/**
+ * The test_barrier() function launches testing units on the
+ * hierarchical barrier interface of the HAL.
+ */
+PUBLIC void test_barrier(void)
+{
+	/* API Tests */
+	kprintf(HLINE);
+	for (int i = 0; barrier_tests_api[i].test_fn != NULL; i++)
+	{
+		barrier_tests_api[i].test_fn();
+		kprintf("[test][api][barrier] %s [passed]", barrier_tests_api[i].name);
+	}
+
+	/* FAULT Tests */
+	kprintf(HLINE);
+	for (int i = 0; barrier_tests_fault[i].test_fn != NULL; i++)
+	{
+		barrier_tests_fault[i].test_fn();
+		kprintf("[test][fault][barrier] %s [passed]", barrier_tests_fault[i].name);
+	}
+}
@@ -0,0 +1,279 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/hal/hal.h>
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+#include "../test.h"
+
+#if (__TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+/**
+ * @brief Number of elements in test buffers.
+ */
+#define NELEMS 16
+
+/**
+ * @brief Adds integers.
+ */
+PRIVATE void collective_sum(void *inout, const void *in, size_t nelems)
+{
+	for (size_t i = 0; i < nelems; i++)
+		((int *) inout)[i] += ((const int *) in)[i];
+}
+
+/*============================================================================*
+ * API Tests                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Collective Create Destroy
+ */
+PRIVATE void test_collective_create_destroy(void)
+{
+	int collid;
+	int nodes[1];
+
+	nodes[0] = processor_node_get_num();
+
+	KASSERT((collid = collective_create(nodes, 1)) >= 0);
+	KASSERT(collective_destroy(collid) == 0);
+}
+
+/**
+ * @brief API Test: Collective Broadcast
+ */
+PRIVATE void test_collective_broadcast(void)
+{
+	int collid;
+	int nodes[1];
+	int buffer[NELEMS];
+
+	nodes[0] = processor_node_get_num();
+
+	for (int i = 0; i < NELEMS; i++)
+		buffer[i] = i;
+
+	KASSERT((collid = collective_create(nodes, 1)) >= 0);
+
+		KASSERT(collective_broadcast(collid, 0, buffer, sizeof(buffer)) == 0);
+		KASSERT(collective_broadcast_pipelined(collid, 0, buffer, sizeof(buffer)) == 0);
+
+		for (int i = 0; i < NELEMS; i++)
+			KASSERT(buffer[i] == i);
+
+	KASSERT(collective_destroy(collid) == 0);
+}
+
+/**
+ * @brief API Test: Collective Scatter Gather
+ */
+PRIVATE void test_collective_scatter_gather(void)
+{
+	int collid;
+	int nodes[1];
+	int sendbuf[NELEMS];
+	int recvbuf[NELEMS];
+
+	nodes[0] = processor_node_get_num();
+
+	for (int i = 0; i < NELEMS; i++)
+	{
+		sendbuf[i] = i;
+		recvbuf[i] = -1;
+	}
+
+	KASSERT((collid = collective_create(nodes, 1)) >= 0);
+
+		KASSERT(collective_scatter(collid, 0, sendbuf, recvbuf, sizeof(sendbuf)) == 0);
+		for (int i = 0; i < NELEMS; i++)
+			KASSERT(recvbuf[i] == i);
+
+		kmemset(sendbuf, 0, sizeof(sendbuf));
+
+		KASSERT(collective_gather(collid, 0, recvbuf, sendbuf, sizeof(recvbuf)) == 0);
+		for (int i = 0; i < NELEMS; i++)
+			KASSERT(sendbuf[i] == i);
+
+	KASSERT(collective_destroy(collid) == 0);
+}
+
+/**
+ * @brief API Test: Collective Reduce
+ */
+PRIVATE void test_collective_reduce(void)
+{
+	int collid;
+	int nodes[1];
+	int sendbuf[NELEMS];
+	int recvbuf[NELEMS];
+
+	nodes[0] = processor_node_get_num();
+
+	for (int i = 0; i < NELEMS; i++)
+		sendbuf[i] = i;
+
+	KASSERT((collid = collective_create(nodes, 1)) >= 0);
+
+		KASSERT(collective_reduce(collid, 0, sendbuf, recvbuf, NELEMS, sizeof(int), collective_sum) == 0);
+		for (int i = 0; i < NELEMS; i++)
+			KASSERT(recvbuf[i] == i);
+
+		kmemset(recvbuf, 0, sizeof(recvbuf));
+
+		KASSERT(collective_allreduce(collid, sendbuf, recvbuf, NELEMS, sizeof(int), collective_sum) == 0);
+		for (int i = 0; i < NELEMS; i++)
+			KASSERT(recvbuf[i] == i);
+
+	KASSERT(collective_destroy(collid) == 0);
+}
+
+/*============================================================================*
+ * Fault Injection Tests                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Fault Injection Test: Collective Invalid Create
+ */
+PRIVATE void test_collective_invalid_create(void)
+{
+	int nodes[2];
+
+	nodes[0] = processor_node_get_num();
+	nodes[1] = nodes[0];
+
+	KASSERT(collective_create(NULL, 1) == -EINVAL);
+	KASSERT(collective_create(nodes, 0) == -EINVAL);
+	KASSERT(collective_create(nodes, PROCESSOR_NOC_NODES_NUM + 1) == -EINVAL);
+	KASSERT(collective_create(nodes, 2) == -EINVAL);
+
+	nodes[0] = -1;
+	KASSERT(collective_create(nodes, 1) == -EINVAL);
+
+	nodes[0] = (processor_node_get_num() + 1) % PROCESSOR_NOC_NODES_NUM;
+	KASSERT(collective_create(nodes, 1) == -EINVAL);
+}
+
+/**
+ * @brief Fault Injection Test: Collective Invalid Destroy
+ */
+PRIVATE void test_collective_invalid_destroy(void)
+{
+	KASSERT(collective_destroy(-1) == -EBADF);
+	KASSERT(collective_destroy(HAL_COLLECTIVE_MAX) == -EBADF);
+}
+
+/**
+ * @brief Fault Injection Test: Collective Double Destroy
+ */
+PRIVATE void test_collective_double_destroy(void)
+{
+	int collid;
+	int nodes[1];
+
+	nodes[0] = processor_node_get_num();
+
+	KASSERT((collid = collective_create(nodes, 1)) >= 0);
+	KASSERT(collective_destroy(collid) == 0);
+	KASSERT(collective_destroy(collid) == -EBADF);
+}
+
+/**
+ * @brief Fault Injection Test: Collective Bad Operation
+ */
+PRIVATE void test_collective_bad_operation(void)
+{
+	int collid;
+	int nodes[1];
+	int buffer[NELEMS];
+
+	nodes[0] = processor_node_get_num();
+
+	KASSERT(collective_broadcast(-1, 0, buffer, sizeof(buffer)) == -EBADF);
+
+	KASSERT((collid = collective_create(nodes, 1)) >= 0);
+
+		KASSERT(collective_broadcast(collid, 1, buffer, sizeof(buffer)) == -EINVAL);
+		KASSERT(collective_broadcast(collid, 0, NULL, sizeof(buffer)) == -EINVAL);
+		KASSERT(collective_scatter(collid, 0, NULL, buffer, sizeof(buffer)) == -EINVAL);
+		KASSERT(collective_gather(collid, 0, buffer, NULL, sizeof(buffer)) == -EINVAL);
+		KASSERT(collective_reduce(collid, 0, buffer, buffer, NELEMS, 0, collective_sum) == -EINVAL);
+		KASSERT(collective_reduce(collid, 0, buffer, buffer, NELEMS, sizeof(int), NULL) == -EINVAL);
+
+	KASSERT(collective_destroy(collid) == 0);
+}
+
+/*============================================================================*
+ * Test Driver                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test collective_tests_api[] = {
+	{ test_collective_create_destroy, "create destroy " },
+	{ test_collective_broadcast,      "broadcast      " },
+	{ test_collective_scatter_gather, "scatter gather " },
+	{ test_collective_reduce,         "reduce         " },
+	{ NULL,                            NULL             },
+};
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test collective_tests_fault[] = {
+	{ test_collective_invalid_create,  "invalid create " },
+	{ test_collective_invalid_destroy, "invalid destroy" },
+	{ test_collective_double_destroy,  "double destroy " },
+	{ test_collective_bad_operation,   "bad operation  " },
+	{ NULL,                             NULL             },
+};
+
+#endif /* __TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX */
+
+/**
+ * The test_collective() function launches testing units on the
+ * collective communication interface of the HAL.
+ */
+PUBLIC void test_collective(void)
+{
+#if (__TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+	/* API Tests */
+	kprintf(HLINE);
+	for (int i = 0; collective_tests_api[i].test_fn != NULL; i++)
+	{
+		collective_tests_api[i].test_fn();
+		kprintf("[test][api][collective] %s [passed]", collective_tests_api[i].name);
+	}
+
+	/* FAULT Tests */
+	kprintf(HLINE);
+	for (int i = 0; collective_tests_fault[i].test_fn != NULL; i++)
+	{
+		collective_tests_fault[i].test_fn();
+		kprintf("[test][fault][collective] %s [passed]", collective_tests_fault[i].name);
+	}
+#endif /* __TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX */
+}
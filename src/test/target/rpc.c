@@ -0,0 +1,175 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/hal/hal.h>
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+#include "../test.h"
+
+#if (__TARGET_HAS_MAILBOX)
+
+/*============================================================================*
+ * API Tests                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief API Test: RPC Setup Shutdown
+ */
+PRIVATE void test_rpc_setup_shutdown(void)
+{
+	KASSERT(rpc_setup() == 0);
+	KASSERT(rpc_shutdown() == 0);
+}
+
+/*============================================================================*
+ * Fault Injection Tests                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Fault Injection Test: RPC Double Setup
+ */
+PRIVATE void test_rpc_double_setup(void)
+{
+	KASSERT(rpc_setup() == 0);
+	KASSERT(rpc_setup() == -EBUSY);
+	KASSERT(rpc_shutdown() == 0);
+	KASSERT(rpc_shutdown() == -EINVAL);
+}
+
+/**
+ * @brief Fault Injection Test: RPC Invalid Call
+ */
+PRIVATE void test_rpc_invalid_call(void)
+{
+	char buffer[HAL_RPC_DATA_SIZE];
+
+	KASSERT(rpc_call(NODENUM_SLAVE, 0, buffer, sizeof(buffer)) == -EINVAL);
+
+	KASSERT(rpc_setup() == 0);
+
+		KASSERT(rpc_call(-1, 0, buffer, sizeof(buffer)) == -EINVAL);
+		KASSERT(rpc_call(PROCESSOR_NOC_NODES_NUM, 0, buffer, sizeof(buffer)) == -EINVAL);
+		KASSERT(rpc_call(processor_node_get_num(), 0, buffer, sizeof(buffer)) == -EINVAL);
+		KASSERT(rpc_call(NODENUM_SLAVE, 0, NULL, sizeof(buffer)) == -EINVAL);
+		KASSERT(rpc_call(NODENUM_SLAVE, 0, buffer, HAL_RPC_DATA_SIZE + 1) == -EINVAL);
+
+	KASSERT(rpc_shutdown() == 0);
+}
+
+/**
+ * @brief Fault Injection Test: RPC Invalid Wait
+ */
+PRIVATE void test_rpc_invalid_wait(void)
+{
+	int handles[1];
+	char buffer[HAL_RPC_DATA_SIZE];
+
+	KASSERT(rpc_setup() == 0);
+
+		handles[0] = 0;
+
+		KASSERT(rpc_test(-1) == -EINVAL);
+		KASSERT(rpc_test(HAL_RPC_OUTSTANDING_MAX) == -EINVAL);
+		KASSERT(rpc_test(0) == -EINVAL);
+		KASSERT(rpc_wait(0, buffer, sizeof(buffer)) == -EINVAL);
+		KASSERT(rpc_wait_any(NULL, 1) == -EINVAL);
+		KASSERT(rpc_wait_any(handles, 0) == -EINVAL);
+		KASSERT(rpc_wait_any(handles, 1) == -EINVAL);
+		KASSERT(rpc_wait_all(handles, 1) == -EINVAL);
+
+	KASSERT(rpc_shutdown() == 0);
+}
+
+/**
+ * @brief Fault Injection Test: RPC Invalid Serve
+ */
+PRIVATE void test_rpc_invalid_serve(void)
+{
+	struct rpc_request req;
+	char buffer[HAL_RPC_DATA_SIZE];
+
+	KASSERT(rpc_serve(&req, buffer, sizeof(buffer)) == -EINVAL);
+
+	KASSERT(rpc_setup() == 0);
+
+		req.source = processor_node_get_num();
+
+		KASSERT(rpc_serve(NULL, buffer, sizeof(buffer)) == -EINVAL);
+		KASSERT(rpc_serve(&req, NULL, sizeof(buffer)) == -EINVAL);
+		KASSERT(rpc_reply(NULL, 0, buffer, sizeof(buffer)) == -EINVAL);
+		KASSERT(rpc_reply(&req, 0, buffer, sizeof(buffer)) == -EINVAL);
+
+	KASSERT(rpc_shutdown() == 0);
+}
+
+/*============================================================================*
+ * Test Driver                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test rpc_tests_api[] = {
+	{ test_rpc_setup_shutdown, "setup shutdown" },
+	{ NULL,                     NULL            },
+};
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test rpc_tests_fault[] = {
+	{ test_rpc_double_setup,  "double setup  " },
+	{ test_rpc_invalid_call,  "invalid call  " },
+	{ test_rpc_invalid_wait,  "invalid wait  " },
+	{ test_rpc_invalid_serve, "invalid serve " },
+	{ NULL,                    NULL            },
+};
+
+#endif /* __TARGET_HAS_MAILBOX */
+
+/**
+ * The test_rpc() function launches testing units on the RPC
+ * interface of the HAL.
+ */
+PUBLIC void test_rpc(void)
+{
+#if (__TARGET_HAS_MAILBOX)
+	/* API Tests */
+	kprintf(HLINE);
+	for (int i = 0; rpc_tests_api[i].test_fn != NULL; i++)
+	{
+		rpc_tests_api[i].test_fn();
+		kprintf("[test][api][rpc] %s [passed]", rpc_tests_api[i].name);
+	}
+
+	/* FAULT Tests */
+	kprintf(HLINE);
+	for (int i = 0; rpc_tests_fault[i].test_fn != NULL; i++)
+	{
+		rpc_tests_fault[i].test_fn();
+		kprintf("[test][fault][rpc] %s [passed]", rpc_tests_fault[i].name);
+	}
+#endif /* __TARGET_HAS_MAILBOX */
+}
@@ -84,6 +84,31 @@ PRIVATE void test_sync_open_close(void)
 	KASSERT(sync_close(syncid) == 0);
 }
 
+/**
+ * @brief API Test: Synchronization Point Pending Signals
+ */
+PRIVATE void test_sync_npending(void)
+{
+	int syncid;
+	int nodes[NODES_AMOUNT];
+
+	nodes[0] = NODENUM_MASTER;
+	nodes[1] = NODENUM_SLAVE;
+
+	KASSERT((syncid = sync_create(nodes, NODES_AMOUNT, SYNC_ALL_TO_ONE)) >= 0);
+
+#ifdef __sync_npending_fn
+		KASSERT(sync_npending(syncid) == 0);
+		KASSERT(sync_ioctl(syncid, SYNC_IOCTL_SET_COUNTING_MODE, 1) == 0);
+		KASSERT(sync_npending(syncid) == 0);
+		KASSERT(sync_ioctl(syncid, SYNC_IOCTL_SET_COUNTING_MODE, 0) == 0);
+#else
+		KASSERT(sync_npending(syncid) == -ENOSYS);
+#endif
+
+	KASSERT(sync_unlink(syncid) == 0);
+}
+
 /*============================================================================*
  * Fault Injection Tests                                                      *
  *============================================================================*/
@@ -399,6 +424,47 @@ PRIVATE void test_sync_bad_wait(void)
 	KASSERT(sync_close(syncid) == 0);
 }
 
+/**
+ * @brief Fault Injection Test: Synchronization Point Invalid Wait N
+ */
+PRIVATE void test_sync_invalid_wait_n(void)
+{
+	int syncid;
+	int nodes[NODES_AMOUNT];
+
+	nodes[0] = NODENUM_MASTER;
+	nodes[1] = NODENUM_SLAVE;
+
+	KASSERT(sync_wait_n(-1, 1) == -EBADF);
+	KASSERT(sync_wait_n(1000, 1) == -EBADF);
+
+	KASSERT((syncid = sync_create(nodes, NODES_AMOUNT, SYNC_ALL_TO_ONE)) >= 0);
+
+		KASSERT(sync_wait_n(syncid, 0) == -EINVAL);
+		KASSERT(sync_wait_n(syncid, -1) == -EINVAL);
+
+	KASSERT(sync_unlink(syncid) == 0);
+}
+
+/**
+ * @brief Fault Injection Test: Synchronization Point Bad Wait N
+ */
+PRIVATE void test_sync_bad_wait_n(void)
+{
+	int syncid;
+	int nodes[NODES_AMOUNT];
+
+	nodes[0] = NODENUM_MASTER;
+	nodes[1] = NODENUM_SLAVE;
+
+	KASSERT((syncid = sync_open(nodes, NODES_AMOUNT, SYNC_ONE_TO_ALL)) >= 0);
+
+		KASSERT(sync_wait_n(syncid, 1) == -EBADF);
+		KASSERT(sync_npending(syncid) < 0);
+
+	KASSERT(sync_close(syncid) == 0);
+}
+
 /*============================================================================*
  * Test Driver                                                                *
  *============================================================================*/
@@ -409,6 +475,7 @@ PRIVATE void test_sync_bad_wait(void)
 PRIVATE struct test sync_tests_api[] = {
 	{ test_sync_create_unlink, "create unlink" },
 	{ test_sync_open_close,    "open close   " },
+	{ test_sync_npending,      "npending     " },
 	{ NULL,                     NULL           },
 };
 
@@ -429,6 +496,8 @@ PRIVATE struct test sync_tests_fault[] = {
 	{ test_sync_bad_signal,     "bad signal    " },
 	{ test_sync_invalid_wait,   "invalid wait  " },
 	{ test_sync_bad_wait,       "bad wait      " },
+	{ test_sync_invalid_wait_n, "invalid wait n" },
+	{ test_sync_bad_wait_n,     "bad wait n    " },
 	{ NULL,                      NULL            },
 };
 
@@ -109,6 +109,21 @@
 	 */
 	EXTERN void test_cluster_cores(void);
 
+	/**
+	 * @brief Test driver for the Slab Allocator of the Cluster AL.
+	 */
+	EXTERN void test_cluster_slab(void);
+
+	/**
+	 * @brief Test driver for the Page Frame Allocator of the Cluster AL.
+	 */
+	EXTERN void test_cluster_frames(void);
+
+	/**
+	 * @brief Test driver for the Memory Interface of the Cluster AL.
+	 */
+	EXTERN void test_cluster_memory(void);
+
 	/**
 	 * @brief Test driver for Performance Monitor Interface.
 	 */
@@ -144,11 +159,26 @@
 	 */
 	EXTERN void test_mailbox(void);
 
+	/**
+	 * @brief Test driver for the RPC Interface
+	 */
+	EXTERN void test_rpc(void);
+
 	/**
 	 * @brief Test driver for the Portal Interface
 	 */
 	EXTERN void test_portal(void);
 
+	/**
+	 * @brief Test driver for the Hierarchical Barrier Interface
+	 */
+	EXTERN void test_barrier(void);
+
+	/**
+	 * @brief Test driver for the Collective Communication Interface
+	 */
+	EXTERN void test_collective(void);
+
 	/**
 	 * @brief Test driver for the Clusters Interface
 	 */